@@ -0,0 +1,107 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/AbilitySet/FighterAbilitySet.h"
+#include "AbilitySystemComponent.h"
+#include "Algo/AllOf.h"
+#include "Beadurinc.h"
+#include "Engine/AssetManager.h"
+#include "Combat/Debug/CombatMemory.h"
+
+TSharedPtr<FStreamableHandle> UFighterAbilitySet::LoadAndGiveToAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent, UObject* SourceObject) const
+{
+	if (!AbilitySystemComponent || !AbilitySystemComponent->IsOwnerActorAuthoritative())
+	{
+		return nullptr;
+	}
+	
+	TArray<FSoftObjectPath> ClassPaths = GetClassPaths();
+	
+	const bool bAllLoaded = Algo::AllOf(ClassPaths, [](const FSoftObjectPath& Path) { return Path.ResolveObject() != nullptr; });
+	
+	// Respawns and later joins find the classes resident, so they skip the streamable round trip
+	if (bAllLoaded)
+	{
+		GiveToAbilitySystem(AbilitySystemComponent, SourceObject);
+		return nullptr;
+	}
+	
+	TWeakObjectPtr<const UFighterAbilitySet> WeakSet(this);
+	TWeakObjectPtr<UAbilitySystemComponent> WeakAbilitySystem(AbilitySystemComponent);
+	TWeakObjectPtr<UObject> WeakSource(SourceObject);
+	
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(ClassPaths),
+		FStreamableDelegate::CreateLambda([WeakSet, WeakAbilitySystem, WeakSource]
+		{
+			const UFighterAbilitySet* Set = WeakSet.Get();
+			UAbilitySystemComponent* ASC = WeakAbilitySystem.Get();
+			
+			// The owner may have been destroyed while loading
+			if (Set && ASC)
+			{
+				Set->GiveToAbilitySystem(ASC, WeakSource.Get());
+			}
+		})
+	);
+}
+
+void UFighterAbilitySet::GiveToAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent, UObject* SourceObject) const
+{
+	LLM_SCOPE_BYTAG(Beadurinc_AbilitySystem);
+	
+	// Grant everything in one pass, so the ability list is dirtied and replicated once
+	for (const FFighterAbilitySetAbility& Entry : Abilities)
+	{
+		const TSubclassOf<UGameplayAbility> AbilityClass = Entry.Ability.Get();
+		
+		if (!AbilityClass)
+		{
+			UE_LOG(LogBeadurinc, Warning, TEXT("%s: ability %s is not loaded"), *GetName(), *Entry.Ability.ToString());
+			continue;
+		}
+		
+		AbilitySystemComponent->GiveAbility(FGameplayAbilitySpec(AbilityClass, Entry.Level, Entry.InputId, SourceObject));
+	}
+	
+	for (const FFighterAbilitySetEffect& Entry : StartingEffects)
+	{
+		const TSubclassOf<UGameplayEffect> EffectClass = Entry.Effect.Get();
+		
+		if (!EffectClass)
+		{
+			UE_LOG(LogBeadurinc, Warning, TEXT("%s: effect %s is not loaded"), *GetName(), *Entry.Effect.ToString());
+			continue;
+		}
+		
+		FGameplayEffectContextHandle Context = AbilitySystemComponent->MakeEffectContext();
+		Context.AddSourceObject(SourceObject);
+		
+		AbilitySystemComponent->ApplyGameplayEffectToSelf(EffectClass->GetDefaultObject<UGameplayEffect>(), Entry.Level, Context);
+	}
+	
+	AbilitySystemComponent->ForceReplication();
+}
+
+TArray<FSoftObjectPath> UFighterAbilitySet::GetClassPaths() const
+{
+	TArray<FSoftObjectPath> ClassPaths;
+	ClassPaths.Reserve(Abilities.Num() + StartingEffects.Num());
+	
+	for (const FFighterAbilitySetAbility& Entry : Abilities)
+	{
+		if (!Entry.Ability.IsNull())
+		{
+			ClassPaths.Add(Entry.Ability.ToSoftObjectPath());
+		}
+	}
+	
+	for (const FFighterAbilitySetEffect& Entry : StartingEffects)
+	{
+		if (!Entry.Effect.IsNull())
+		{
+			ClassPaths.Add(Entry.Effect.ToSoftObjectPath());
+		}
+	}
+	
+	return ClassPaths;
+}
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "FighterAbilitySet.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UGameplayEffect;
+struct FStreamableHandle;
+
+/** An ability granted by a set and the input it is bound to */
+USTRUCT(BlueprintType)
+struct FFighterAbilitySetAbility
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Ability")
+	TSoftClassPtr<UGameplayAbility> Ability;
+	
+	/** Input id the ability is activated by. See EAbilityId for the ids bound by the player character */
+	UPROPERTY(EditDefaultsOnly, Category = "Ability")
+	int32 InputId = INDEX_NONE;
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Ability", meta = (ClampMin = "1"))
+	int32 Level = 1;
+};
+
+/** An effect applied to the owner once its abilities are granted */
+USTRUCT(BlueprintType)
+struct FFighterAbilitySetEffect
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Effect")
+	TSoftClassPtr<UGameplayEffect> Effect;
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Effect")
+	float Level = 1.0F;
+};
+
+/**
+ * Abilities and starting effects granted to a fighter's ASC, authored as data so adding an
+ * ability to a roster needs no new C++ field.
+ *
+ * Classes are soft referenced and loaded asynchronously in one request, then granted in a
+ * single pass so the ASC's ability list replicates them in one update.
+ */
+UCLASS(BlueprintType)
+class BEADURINC_API UFighterAbilitySet : public UDataAsset
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Abilities", meta = (TitleProperty = "Ability"))
+	TArray<FFighterAbilitySetAbility> Abilities;
+	
+	UPROPERTY(EditDefaultsOnly, Category = "Effects", meta = (TitleProperty = "Effect"))
+	TArray<FFighterAbilitySetEffect> StartingEffects;
+	
+public:
+	
+	/**
+	 * Loads every class of the set and grants it to the ASC. Authority only. Grants right away
+	 * when everything is loaded already, otherwise once the load completes if the ASC is still alive.
+	 */
+	TSharedPtr<FStreamableHandle> LoadAndGiveToAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent, UObject* SourceObject) const;
+	
+	/** Grants the abilities and applies the effects whose classes are loaded */
+	void GiveToAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent, UObject* SourceObject) const;
+	
+	/** Returns the paths of every class in the set */
+	TArray<FSoftObjectPath> GetClassPaths() const;
+};
@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/GameplayAbility/AreaAttackGameplayAbility.h"
+#include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Combat/AreaAttackDataAsset.h"
+#include "Combat/CombatSpatialIndexSubsystem.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "TimerManager.h"
+
+UAreaAttackGameplayAbility::UAreaAttackGameplayAbility()
+{
+	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerInitiated;
+}
+
+/**
+ * Checks if the attack has anything to play
+ */
+bool UAreaAttackGameplayAbility::CanActivateAbility
+(
+	const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayTagContainer* SourceTags,
+	const FGameplayTagContainer* TargetTags,
+	OUT FGameplayTagContainer* OptionalRelevantTags
+) const
+{
+	if (!IsValid(Attack) || (!Attack->GetMontage() && Attack->GetPulses().IsEmpty()) || !Cast<AFighterCharacter>(ActorInfo->AvatarActor.Get()))
+	{
+		return false;
+	}
+	
+	return Super::CanActivateAbility(Handle, ActorInfo, SourceTags, TargetTags, OptionalRelevantTags);
+}
+
+/**
+ * Plays the montage and schedules the pulses
+ */
+void UAreaAttackGameplayAbility::ActivateAbility
+(
+	const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo,
+	const FGameplayEventData* TriggerEventData
+)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_AbilityActivation);
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	COMBAT_COUNT(Activations);
+	
+	PulsesFired = 0;
+	
+	if (Attack->GetMontage())
+	{
+		UAbilityTask_PlayMontageAndWait* AT = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
+			this,
+			TEXT("AreaAttack"),
+			Attack->GetMontage()
+		);
+		
+		AT->OnCompleted.AddDynamic(this, &UAreaAttackGameplayAbility::MontageEnds);
+		AT->OnInterrupted.AddDynamic(this, &UAreaAttackGameplayAbility::MontageEnds);
+		AT->OnCancelled.AddDynamic(this, &UAreaAttackGameplayAbility::MontageEnds);
+		AT->ReadyForActivation();
+	}
+	
+	// Only the server resolves who is hit, clients just play the montage
+	if (!HasAuthority(&ActivationInfo))
+	{
+		if (!Attack->GetMontage())
+		{
+			EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+		}
+		
+		return;
+	}
+	
+	const TArray<FAreaAttackPulse>& Pulses = Attack->GetPulses();
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	
+	for (int32 PulseIndex = 0; PulseIndex < Pulses.Num(); ++PulseIndex)
+	{
+		if (Pulses[PulseIndex].Time <= 0.0F)
+		{
+			FirePulse(PulseIndex);
+			continue;
+		}
+		
+		TimerManager.SetTimer(
+			PulseTimers.AddDefaulted_GetRef(),
+			FTimerDelegate::CreateUObject(this, &UAreaAttackGameplayAbility::FirePulse, PulseIndex),
+			Pulses[PulseIndex].Time,
+			false
+		);
+	}
+}
+
+/**
+ * Drops the pulses that have not landed yet
+ */
+void UAreaAttackGameplayAbility::EndAbility
+(
+	const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo,
+	const FGameplayAbilityActivationInfo ActivationInfo,
+	bool bReplicateEndAbility,
+	bool bWasCancelled
+)
+{
+	if (UWorld* World = GetWorld())
+	{
+		for (FTimerHandle& PulseTimer : PulseTimers)
+		{
+			World->GetTimerManager().ClearTimer(PulseTimer);
+		}
+	}
+	
+	PulseTimers.Reset();
+	
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
+}
+
+void UAreaAttackGameplayAbility::FirePulse(int32 PulseIndex)
+{
+	AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(GetAvatarActorFromActorInfo());
+	UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>();
+	const FAreaAttackPulse& Pulse = Attack->GetPulses()[PulseIndex];
+	
+	if (FighterCharacter && SpatialIndex)
+	{
+		// Areas follow the attacker's facing on the ground plane, however the attacker leans
+		const FTransform AttackerTransform(FRotator(0.0, FighterCharacter->GetActorRotation().Yaw, 0.0), FighterCharacter->GetActorLocation());
+		
+		FCombatAreaQuery Query;
+		Query.Instigator = FighterCharacter;
+		Query.Source = Attack;
+		Query.Shape = Pulse.Shape;
+		Query.Transform = FTransform(Pulse.Shape.Offset) * AttackerTransform;
+		Query.Damage = Pulse.Damage;
+		
+		SpatialIndex->QueueAreaQuery(MoveTemp(Query));
+	}
+	
+	// Without a montage the attack lasts until its last pulse
+	if (++PulsesFired == Attack->GetPulses().Num() && !Attack->GetMontage())
+	{
+		EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+	}
+}
+
+/** On the attack montage ends */
+void UAreaAttackGameplayAbility::MontageEnds()
+{
+	EndAbility(CurrentSpecHandle, CurrentActorInfo, CurrentActivationInfo, true, false);
+}
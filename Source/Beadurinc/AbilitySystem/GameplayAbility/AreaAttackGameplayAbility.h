@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbility.h"
+#include "AreaAttackGameplayAbility.generated.h"
+
+class UAreaAttackDataAsset;
+
+/**
+ * Plays an area attack: its montage, and each of its pulses at its time. Pulses are queued into
+ * the combat spatial index, which resolves every area attack of the frame in one pass.
+ *
+ * Runs on the server, which alone decides who an area attack hits.
+ */
+UCLASS()
+class BEADURINC_API UAreaAttackGameplayAbility : public UGameplayAbility
+{
+	GENERATED_BODY()
+	
+	/** Attack played */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attack", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UAreaAttackDataAsset> Attack;
+	
+public:
+	UAreaAttackGameplayAbility();
+	
+protected:
+	/**
+	 * Checks if the attack has anything to play
+	 */
+	virtual bool CanActivateAbility
+	(
+		const FGameplayAbilitySpecHandle Handle,
+		const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayTagContainer* SourceTags = nullptr,
+		const FGameplayTagContainer* TargetTags = nullptr,
+		OUT FGameplayTagContainer* OptionalRelevantTags = nullptr
+	) const override;
+	
+	/**
+	 * Plays the montage and schedules the pulses
+	 */
+	virtual void ActivateAbility
+	(
+		const FGameplayAbilitySpecHandle Handle,
+		const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo,
+		const FGameplayEventData* TriggerEventData
+	) override;
+	
+	/**
+	 * Drops the pulses that have not landed yet
+	 */
+	virtual void EndAbility
+	(
+		const FGameplayAbilitySpecHandle Handle,
+		const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo,
+		bool bReplicateEndAbility,
+		bool bWasCancelled
+	) override;
+	
+private:
+	
+	/** Queues a pulse into the combat spatial index, placed where the attacker stands now */
+	void FirePulse(int32 PulseIndex);
+	
+	/** On the attack montage ends */
+	UFUNCTION()
+	void MontageEnds();
+	
+private:
+	
+	/** Timers of the pulses that have not landed yet */
+	TArray<FTimerHandle, TInlineAllocator<4>> PulseTimers;
+	
+	/** Pulses landed in the current activation */
+	int32 PulsesFired = 0;
+};
@@ -3,14 +3,19 @@
 
 #include "BlockParryGameplayAbility.h"
 
-#include "Abilities/Tasks/AbilityTask_WaitDelay.h"
+#include "AbilitySystemComponent.h"
 #include "Abilities/Tasks/AbilityTask_WaitInputRelease.h"
 #include "AbilitySystem/GameplayTag/StateGameplayTags.h"
+#include "AbilitySystem/TargetData/CombatTargetData.h"
 #include "Actor/Character/PlayerCharacter.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
 
 UBlockParryGameplayAbility::UBlockParryGameplayAbility()
 {
 	InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+	ParryWindowSeconds = 0.5F;
+	MaxTimestampRewindSeconds = 0.25F;
 }
 
 /**
@@ -49,25 +54,47 @@ void UBlockParryGameplayAbility::ActivateAbility
 	const FGameplayEventData* TriggerEventData
 )
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_AbilityActivation);
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	COMBAT_COUNT(Activations);
+	
 	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(ActorInfo->AvatarActor.Get()))
 	{
+		UAbilitySystemComponent* ASC = ActorInfo->AbilitySystemComponent.Get();
+		const double ActivationTime = FCombatTargetData_Timestamp::GetServerTime(GetWorld());
+		
 		// Add state tags
-		PlayerCharacter->GetAbilitySystemComponent()->AddLooseGameplayTag(StateGameplayTags::State_Blocking);
-		PlayerCharacter->GetAbilitySystemComponent()->AddLooseGameplayTag(StateGameplayTags::State_Parry);
+		ASC->AddLooseGameplayTag(StateGameplayTags::State_Blocking);
+		
+		// The guard is an interval in server time, so hits are resolved the same regardless of frame rate
+		PlayerCharacter->OpenGuardWindow(ActivationTime, ParryWindowSeconds);
+		
+		if (IsLocallyControlled() && !ActorInfo->IsNetAuthority())
+		{
+			// Tell the server when the guard was actually raised
+			FScopedPredictionWindow ScopedPrediction(ASC);
+			
+			ASC->ServerSetReplicatedTargetData(
+				Handle,
+				ActivationInfo.GetActivationPredictionKey(),
+				FGameplayAbilityTargetDataHandle(new FCombatTargetData_Timestamp(ActivationTime)),
+				FGameplayTag(),
+				ASC->ScopedPredictionKey
+			);
+		}
+		else if (!IsLocallyControlled())
+		{
+			// The guard stays open from the server's own activation time until the client's timestamp arrives
+			ActivationTimestampHandle = ASC->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey())
+				.AddUObject(this, &UBlockParryGameplayAbility::OnActivationTimestampReceived);
+			
+			ASC->CallReplicatedTargetDataDelegatesIfSet(Handle, ActivationInfo.GetActivationPredictionKey());
+		}
 		
 		// Play blocking anim montage
 		if (IsValid(BlockingMontage))
 			PlayerCharacter->PlayAnimMontage(BlockingMontage);
 		
-		// Allows parrying within time window 0.5 seconds
-		UAbilityTask_WaitDelay* AT_WaitDelay = UAbilityTask_WaitDelay::WaitDelay(
-			this,
-			0.5F
-		);
-		
-		AT_WaitDelay->OnFinish.AddDynamic(this, &UBlockParryGameplayAbility::OnParryWindowFinished);
-		AT_WaitDelay->ReadyForActivation();
-		
 		// Stop blocking on input unpressed
 		UAbilityTask_WaitInputRelease* AT_WaitInputRelease = UAbilityTask_WaitInputRelease::WaitInputRelease(
 			this,
@@ -110,29 +137,36 @@ void UBlockParryGameplayAbility::EndAbility
 	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(ActorInfo->AvatarActor.Get()))
 	{
 		PlayerCharacter->StopAnimMontage(BlockingMontage);
+		PlayerCharacter->CloseGuardWindow(FCombatTargetData_Timestamp::GetServerTime(GetWorld()));
 		
 		UAbilitySystemComponent* ASC = PlayerCharacter->GetAbilitySystemComponent();
 		if (!ASC) return;
 		
+		if (ActivationTimestampHandle.IsValid())
+		{
+			ASC->AbilityTargetDataSetDelegate(Handle, ActivationInfo.GetActivationPredictionKey()).Remove(ActivationTimestampHandle);
+			ActivationTimestampHandle.Reset();
+		}
+		
 		// Remove state tags
 		if (ASC->HasMatchingGameplayTag(StateGameplayTags::State_Blocking))
 			PlayerCharacter->GetAbilitySystemComponent()->RemoveLooseGameplayTag(StateGameplayTags::State_Blocking);
-		
-		if (ASC->HasMatchingGameplayTag(StateGameplayTags::State_Parry))
-			PlayerCharacter->GetAbilitySystemComponent()->RemoveLooseGameplayTag(StateGameplayTags::State_Parry);
 	}
 }
 
-void UBlockParryGameplayAbility::OnParryWindowFinished()
+void UBlockParryGameplayAbility::OnActivationTimestampReceived(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayTag ApplicationTag)
 {
+	// TargetData may be the cached handle itself, which consuming clears, so read the timestamp first
+	const double ServerTime = FCombatTargetData_Timestamp::GetServerTime(GetWorld());
+	const double ClientTime = FCombatTargetData_Timestamp::FindServerTime(TargetData, ServerTime);
+	
+	UAbilitySystemComponent* ASC = CurrentActorInfo->AbilitySystemComponent.Get();
+	ASC->ConsumeClientReplicatedTargetData(CurrentSpecHandle, CurrentActivationInfo.GetActivationPredictionKey());
+	
 	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(CurrentActorInfo->AvatarActor.Get()))
 	{
-		UAbilitySystemComponent* ASC = PlayerCharacter->GetAbilitySystemComponent();
-		
-		if (!ASC) return;
-		
-		if (ASC->HasMatchingGameplayTag(StateGameplayTags::State_Parry))
-			PlayerCharacter->GetAbilitySystemComponent()->RemoveLooseGameplayTag(StateGameplayTags::State_Parry);
+		// Never trust a timestamp from the future or further in the past than the rewind limit
+		PlayerCharacter->OpenGuardWindow(FMath::Clamp(ClientTime, ServerTime - MaxTimestampRewindSeconds, ServerTime), ParryWindowSeconds);
 	}
 }
 
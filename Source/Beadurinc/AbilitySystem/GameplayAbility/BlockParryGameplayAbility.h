@@ -23,9 +23,20 @@ class BEADURINC_API UBlockParryGameplayAbility : public UGameplayAbility
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Animations, meta = (AllowPrivateAccess = "true"))
 	TArray<TObjectPtr<UAnimMontage>> OnParriedMontage;
 	
+	/** Length of the parry window from the moment the guard is raised */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Parry", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float ParryWindowSeconds;
+	
+	/** How far into the past the server accepts a client's activation timestamp */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Parry", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float MaxTimestampRewindSeconds;
+	
 public:
 	UBlockParryGameplayAbility();
 	
+	/** Returns the length of the parry window from the moment the guard is raised */
+	FORCEINLINE float GetParryWindowSeconds() const { return ParryWindowSeconds; }
+	
 protected:
 	/**
 	 * Checks if the player can do combo attacks
@@ -75,14 +86,18 @@ protected:
 	
 protected:
 	/**
-	 * Callback on parry window finished
+	 * Callback on the client's activation timestamp arriving at the server
 	 */
-	UFUNCTION()
-	void OnParryWindowFinished();
+	void OnActivationTimestampReceived(const FGameplayAbilityTargetDataHandle& TargetData, FGameplayTag ApplicationTag);
 	
 	/**
 	 * Callback on block key released
 	 */
 	UFUNCTION()
 	void OnInputReleased(float TimeHeld);
+	
+private:
+	
+	/** Handle of the server's binding to the client's activation timestamp */
+	FDelegateHandle ActivationTimestampHandle;
 };
@@ -5,9 +5,12 @@
 
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
 #include "Actor/Character/PlayerCharacter.h"
+#include "Actor/Weapon/WeaponComponent.h"
 #include "Abilities/Tasks/AbilityTask_WaitGameplayEvent.h"
 #include "AbilitySystem/AbilityId.h"
 #include "AbilitySystem/GameplayTag/StateGameplayTags.h"
+#include "Animation/Timeline/StateWindowComponent.h"
+#include "Combat/CombatStats.h"
 
 UComboAttackGameplayAbility::UComboAttackGameplayAbility()
 {
@@ -23,8 +26,9 @@ void UComboAttackGameplayAbility::PlayNextComboAttack()
 	// Checks weapon in hand
 	if (BCharacter && BCharacter->IsHoldingWeapon())
 	{
-		// Add combo lock state
-		BCharacter->GetAbilitySystemComponent()->AddLooseGameplayTag(StateGameplayTags::State_ComboLocked);
+		// Lock the combo until the montage's own combo lock window takes over
+		UStateWindowComponent* StateWindows = BCharacter->GetStateWindowComponent();
+		StateWindows->OpenWindow(StateGameplayTags::State_ComboLocked);
 		
 		if (LastComboMontagePlayTask)
 		{
@@ -32,11 +36,13 @@ void UComboAttackGameplayAbility::PlayNextComboAttack()
 			LastComboMontagePlayTask->ExternalCancel();
 		}
 		
+		UAnimMontage* ComboMontage = BCharacter->GetWeapon()->GetComboAttackAt(ComboCounter);
+		
 		// Triggers by play montage ability task (activates until montage ends)
 		UAbilityTask_PlayMontageAndWait* AT = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
 			this,
 			TEXT("ComboAttack"),
-			BCharacter->GetWeaponActor()->GetComboAttackAt(ComboCounter)
+			ComboMontage
 		);
 		
 		AT->OnCompleted.AddDynamic(this, &UComboAttackGameplayAbility::OnMontageCompleted);
@@ -44,8 +50,10 @@ void UComboAttackGameplayAbility::PlayNextComboAttack()
 		AT->ReadyForActivation();
 		LastComboMontagePlayTask = AT;
 		
+		StateWindows->HandOverWindow(ComboMontage, StateGameplayTags::State_ComboLocked);
+		
 		// Clamp combo counter to combo montage array length
-		ComboCounter = (ComboCounter + 1) % BCharacter->GetWeaponActor()->GetComboSequenceLength();
+		ComboCounter = (ComboCounter + 1) % BCharacter->GetWeapon()->GetComboSequenceLength();
 		BCharacter->ClearInputBuffer();
 	}
 }
@@ -85,6 +93,9 @@ void UComboAttackGameplayAbility::ActivateAbility
 	const FGameplayEventData* TriggerEventData
 )
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_AbilityActivation);
+	COMBAT_COUNT(Activations);
+	
 	Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
 	PlayNextComboAttack();
 }
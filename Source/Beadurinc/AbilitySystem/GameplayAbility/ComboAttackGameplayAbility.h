@@ -23,6 +23,9 @@ public:
 	/** Plays next combo montage by ability task */
 	void PlayNextComboAttack();
 	
+	/** Returns the index of the combo montage the next attack plays */
+	FORCEINLINE int32 GetComboCounter() const { return ComboCounter; }
+	
 protected:
 	/**
 	 * Checks if the player can do combo attacks
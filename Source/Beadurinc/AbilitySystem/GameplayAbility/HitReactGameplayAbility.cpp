@@ -2,8 +2,15 @@
 
 #include "AbilitySystem/GameplayAbility/HitReactGameplayAbility.h"
 #include "AbilitySystem/GameplayTag/StateGameplayTags.h"
+#include "AbilitySystem/TargetData/CombatTargetData.h"
 #include "AbilitySystemComponent.h"
 #include "Actor/Character/FighterCharacter.h"
+#include "Actor/Weapon/WeaponDataAsset.h"
+#include "Combat/CombatAttackSourceInterface.h"
+#include "Combat/CombatResolutionTable.h"
+#include "GameData/BeadurincGameState.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
 
 void UHitReactGameplayAbility::ActivateAbility
 (
@@ -13,6 +20,10 @@ void UHitReactGameplayAbility::ActivateAbility
 	const FGameplayEventData* TriggerEventData
 )
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_HitReact);
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	COMBAT_COUNT(Activations);
+	
 	AFighterCharacter* OwnerCharacter = Cast<AFighterCharacter>(ActorInfo->AvatarActor.Get());
 	UAbilitySystemComponent* OwnerACS = ActorInfo->AbilitySystemComponent.Get();
 	
@@ -29,26 +40,72 @@ void UHitReactGameplayAbility::ActivateAbility
 		Context.AddHitResult(*TriggerEventData->ContextHandle.GetHitResult());
 		CueParams.EffectContext = Context;
 		
-		FRandomStream RandomStream;
-		RandomStream.Initialize(FMath::Rand());
+		// Resolve against the guard interval at the moment the hit landed, which is independent of frame time and latency
+		const double HitTime = FCombatTargetData_Timestamp::FindServerTime(
+			TriggerEventData->TargetData,
+			FCombatTargetData_Timestamp::GetServerTime(GetWorld())
+		);
+		
+		// Hits are dealt by a held weapon, a projectile or an area attack
+		const ICombatAttackSourceInterface* Source = Cast<ICombatAttackSourceInterface>(TriggerEventData->OptionalObject);
+		const ECombatAttackType AttackType = Source ? Source->GetAttackType() : ECombatAttackType::Light;
+		
+		// Collect the defender state bits the resolution table is indexed by
+		ECombatDefenderState States = ECombatDefenderState::None;
+		
+		if (OwnerCharacter->IsGuardingAt(HitTime)) States |= ECombatDefenderState::Blocking;
+		if (OwnerCharacter->IsParryingAt(HitTime)) States |= ECombatDefenderState::Parrying;
+		if (OwnerACS->HasMatchingGameplayTag(StateGameplayTags::State_Invincible)) States |= ECombatDefenderState::Invincible;
+		
+		if (const AActor* Attacker = TriggerEventData->Instigator.Get())
+		{
+			const FVector TowardAttacker = (Attacker->GetActorLocation() - OwnerCharacter->GetActorLocation()).GetSafeNormal2D();
+			const float FacingCosine = ResolutionTable ? ResolutionTable->GetFacingCosine() : 0.0F;
+			
+			if (FVector::DotProduct(OwnerCharacter->GetActorForwardVector(), TowardAttacker) >= FacingCosine)
+			{
+				States |= ECombatDefenderState::FacingAttacker;
+			}
+		}
+		
+		// One stream per hit, derived from the match seed and state every machine shares
+		AFighterCharacter* Attacker = Cast<AFighterCharacter>(CueParams.Instigator);
+		const ABeadurincGameState* GameState = GetWorld()->GetGameState<ABeadurincGameState>();
+		FRandomStream RandomStream = GameState ? GameState->MakeCombatStream(MakeHitSalt(Attacker, OwnerCharacter)) : FRandomStream(0);
 		
-		// When blocking activated
-		if (RandomStream.FRand() > 0.5 || OwnerACS->HasMatchingGameplayTag(StateGameplayTags::State_Blocking))
+		const ECombatHitOutcome Outcome = ResolutionTable
+			? ResolutionTable->Resolve(AttackType, static_cast<uint8>(States), RandomStream)
+			: UCombatResolutionTable::ResolveDefault(AttackType, static_cast<uint8>(States));
+		
+		RECORD_COMBAT_EVENT(OwnerCharacter, HitReceived, StaticEnum<ECombatHitOutcome>()->GetNameByValue(static_cast<int64>(Outcome)), static_cast<float>(States));
+		
+		// A hit that did not land neither stops the attacker nor turns the defender
+		if (Outcome == ECombatHitOutcome::Ignored)
+		{
+			EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+			return;
+		}
+		
+		// Blocked and parried hits share the block reaction until parry has its own assets
+		if (Outcome == ECombatHitOutcome::Blocked || Outcome == ECombatHitOutcome::Parried)
 		{
 			if (OnBlock) OwnerCharacter->PlayAnimMontage(OnBlock);
 			
 			// Plays gameplay cue for block
 			OwnerACS->ExecuteGameplayCue(FGameplayTag::RequestGameplayTag(FName("GameplayCue.MeleeBlock")), CueParams);
+			COMBAT_COUNT(Cues);
 		}
-		else
+		else if (Outcome == ECombatHitOutcome::Hurt)
 		{
 			if (OnHurt) OwnerCharacter->PlayAnimMontage(OnHurt);
 			// Plays gameplay cue for hurt
 			OwnerACS->ExecuteGameplayCue(FGameplayTag::RequestGameplayTag(FName("GameplayCue.MeleeHurt")), CueParams);
+			COMBAT_COUNT(Cues);
 		}
 		
-		// Apply Hit Stop if the interacting actors are fighters
-		if (AFighterCharacter* Attacker = Cast<AFighterCharacter>(CueParams.Instigator))
+		// Apply Hit Stop if the interacting actors are fighters and the hit is a melee swing. Projectiles and area attacks
+		// land apart from any swing, so they neither freeze the attacker nor keep the defender out of its next swing
+		if (Attacker && Cast<UWeaponDataAsset>(TriggerEventData->OptionalObject))
 		{
 			Attacker->AddHitActor(OwnerCharacter);
 			Attacker->HitStopForTime(HitStop);
@@ -68,3 +125,12 @@ void UHitReactGameplayAbility::ActivateAbility
 	// End ability as soon as triggered
 	EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
 }
+
+uint32 UHitReactGameplayAbility::MakeHitSalt(const AFighterCharacter* Attacker, const AFighterCharacter* Defender)
+{
+	// Hit times and counts of hits seen differ between machines, ids and the replicated swing count do not
+	const uint32 AttackerSalt = Attacker ? HashCombineFast(Attacker->GetCombatId(), Attacker->GetSwingCount()) : 0;
+	const uint32 DefenderSalt = Defender ? Defender->GetCombatId() : 0;
+	
+	return HashCombineFast(AttackerSalt, DefenderSalt);
+}
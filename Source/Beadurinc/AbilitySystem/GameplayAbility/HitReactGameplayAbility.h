@@ -6,6 +6,9 @@
 #include "Abilities/GameplayAbility.h"
 #include "HitReactGameplayAbility.generated.h"
 
+class AFighterCharacter;
+class UCombatResolutionTable;
+
 /**
  * 
  */
@@ -26,10 +29,22 @@ class BEADURINC_API UHitReactGameplayAbility : public UGameplayAbility
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Animations", meta = (AllowPrivateAccess = "true"))
 	float HitStop;
 	
+	/** Outcome of hits by attack type and defender state. The built-in guard rules apply when unset */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Resolution", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UCombatResolutionTable> ResolutionTable;
+	
 	/** Whether the owner actor should look at attacker on hit */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Control", meta = (AllowPrivateAccess = "true"))
 	bool LookAttacker;
 	
+public:
+	
+	/**
+	 * Returns the salt of the combat stream a hit is resolved with. Built from the fighters' combat ids
+	 * and the attacker's swing count only, so every machine rolls the same for the same hit
+	 */
+	static uint32 MakeHitSalt(const AFighterCharacter* Attacker, const AFighterCharacter* Defender);
+	
 protected:
 	/**
 	 * Checks whether the actor blocks the attack or gets hurt
@@ -4,6 +4,7 @@
 #include "Actor/Character/PlayerCharacter.h"
 #include "AbilitySystem/GameplayTag/StateGameplayTags.h"
 #include "Abilities/Tasks/AbilityTask_PlayMontageAndWait.h"
+#include "Combat/CombatStats.h"
 
 URollGameplayAbility::URollGameplayAbility()
 {
@@ -46,6 +47,9 @@ void URollGameplayAbility::ActivateAbility
 	const FGameplayEventData* TriggerEventData
 )
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_AbilityActivation);
+	COMBAT_COUNT(Activations);
+	
 	if (APlayerCharacter* PlayerCharacter = Cast<APlayerCharacter>(ActorInfo->AvatarActor.Get()))
 	{
 		UAbilityTask_PlayMontageAndWait* AT = UAbilityTask_PlayMontageAndWait::CreatePlayMontageAndWaitProxy(
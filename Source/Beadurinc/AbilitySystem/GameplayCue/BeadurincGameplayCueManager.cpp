@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/GameplayCue/BeadurincGameplayCueManager.h"
+#include "Algo/Reverse.h"
+#include "Algo/StableSort.h"
+#include "Engine/World.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+void UBeadurincGameplayCueManager::OnCreated()
+{
+	Super::OnCreated();
+	
+	// The end of the world's tick comes after tickable objects, such as the projectile subsystem, have raised their cues too
+	TickEndHandle = FWorldDelegates::OnWorldTickEnd.AddUObject(this, &UBeadurincGameplayCueManager::FlushPendingCues);
+}
+
+void UBeadurincGameplayCueManager::BeginDestroy()
+{
+	FWorldDelegates::OnWorldTickEnd.Remove(TickEndHandle);
+	
+	Super::BeginDestroy();
+}
+
+void UBeadurincGameplayCueManager::HandleGameplayCue
+(
+	AActor* TargetActor,
+	FGameplayTag GameplayCueTag,
+	EGameplayCueEvent::Type EventType,
+	const FGameplayCueParameters& Parameters,
+	EGameplayCueExecutionOptions Options
+)
+{
+	// States, dedicated servers (which suppress cues anyway) and worlds that never tick their actors go straight through
+	if (EventType != EGameplayCueEvent::Executed || !TargetActor || !TargetActor->GetWorld() || !TargetActor->GetWorld()->IsGameWorld() || TargetActor->GetNetMode() == NM_DedicatedServer)
+	{
+		Super::HandleGameplayCue(TargetActor, GameplayCueTag, EventType, Parameters, Options);
+		return;
+	}
+	
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	PendingCues.Add({ TargetActor, GameplayCueTag, Parameters, Options, GetCueLocation(TargetActor, Parameters), GetPriority(GameplayCueTag) });
+}
+
+void UBeadurincGameplayCueManager::FlushPendingCues(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (PendingCues.IsEmpty())
+	{
+		return;
+	}
+	
+	// Take this world's cues out first, playing them may raise more
+	TArray<FPendingCue, TInlineAllocator<16>> Cues;
+	
+	for (int32 Index = PendingCues.Num() - 1; Index >= 0; --Index)
+	{
+		const AActor* TargetActor = PendingCues[Index].TargetActor.Get();
+		
+		if (!TargetActor || TargetActor->GetWorld() == World)
+		{
+			if (TargetActor)
+			{
+				Cues.Add(MoveTemp(PendingCues[Index]));
+			}
+			
+			PendingCues.RemoveAtSwap(Index, EAllowShrinking::No);
+		}
+	}
+	
+	// Higher ranks first, then in the order they were raised
+	Algo::Reverse(Cues);
+	Algo::StableSort(Cues, [](const FPendingCue& A, const FPendingCue& B) { return A.Priority > B.Priority; });
+	
+	const float MergeRadiusSquared = FMath::Square(MergeRadius);
+	int32 Played = 0;
+	
+	for (int32 Index = 0; Index < Cues.Num(); ++Index)
+	{
+		FPendingCue& Cue = Cues[Index];
+		bool bMerged = false;
+		
+		for (int32 PlayedIndex = 0; PlayedIndex < Played; ++PlayedIndex)
+		{
+			if (Cues[PlayedIndex].Tag == Cue.Tag && FVector::DistSquared(Cues[PlayedIndex].Location, Cue.Location) <= MergeRadiusSquared)
+			{
+				bMerged = true;
+				break;
+			}
+		}
+		
+		if (bMerged)
+		{
+			COMBAT_COUNT(CuesMerged);
+			continue;
+		}
+		
+		if (Played >= MaxExecutionsPerFrame)
+		{
+			COMBAT_COUNT(CuesSkipped);
+			continue;
+		}
+		
+		if (AActor* TargetActor = Cue.TargetActor.Get())
+		{
+			Super::HandleGameplayCue(TargetActor, Cue.Tag, EGameplayCueEvent::Executed, Cue.Parameters, Cue.Options);
+		}
+		
+		// Played cues gather at the front, where later ones are merged against them
+		if (Played != Index)
+		{
+			Swap(Cues[Played], Cues[Index]);
+		}
+		
+		++Played;
+	}
+}
+
+int32 UBeadurincGameplayCueManager::GetPriority(const FGameplayTag& Tag) const
+{
+	for (const FGameplayCuePriority& CuePriority : CuePriorities)
+	{
+		if (Tag.MatchesTag(CuePriority.Tag))
+		{
+			return CuePriority.Priority;
+		}
+	}
+	
+	return 0;
+}
+
+FVector UBeadurincGameplayCueManager::GetCueLocation(const AActor* TargetActor, const FGameplayCueParameters& Parameters)
+{
+	if (const FHitResult* Hit = Parameters.EffectContext.GetHitResult())
+	{
+		return Hit->ImpactPoint;
+	}
+	
+	if (!Parameters.Location.IsZero())
+	{
+		return Parameters.Location;
+	}
+	
+	return TargetActor->GetActorLocation();
+}
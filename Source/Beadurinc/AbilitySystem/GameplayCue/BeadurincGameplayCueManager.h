@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayCueManager.h"
+#include "BeadurincGameplayCueManager.generated.h"
+
+/** Rank of a cue when executed cues compete for the frame's budget */
+USTRUCT()
+struct FGameplayCuePriority
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(Config, EditAnywhere, Category = "Cue")
+	FGameplayTag Tag;
+	
+	/** Higher ranks are executed first. Unlisted cues rank 0 */
+	UPROPERTY(Config, EditAnywhere, Category = "Cue")
+	int32 Priority = 0;
+};
+
+/**
+ * Caps how many cues are executed per frame.
+ *
+ * Executed cues (hit sparks, blood, impact sounds) are not played when raised but collected
+ * until the end of the world's tick. Then they are played by priority: a cue landing near
+ * one of the same tag already played this frame is merged into it, and cues past the frame's
+ * budget are skipped. A multi-hit cleave therefore costs a handful of effects instead of one per
+ * target. Cues that add, keep or remove a state are never deferred, so they stay paired.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UBeadurincGameplayCueManager : public UGameplayCueManager
+{
+	GENERATED_BODY()
+	
+	/** Most executed cues played per frame */
+	UPROPERTY(Config)
+	int32 MaxExecutionsPerFrame = 8;
+	
+	/** Cues of the same tag closer than this to one played the same frame are merged into it */
+	UPROPERTY(Config)
+	float MergeRadius = 50.0F;
+	
+	/** Ranks of the cues that matter the most when the budget runs out */
+	UPROPERTY(Config)
+	TArray<FGameplayCuePriority> CuePriorities;
+	
+public:
+	
+	virtual void OnCreated() override;
+	
+	virtual void HandleGameplayCue
+	(
+		AActor* TargetActor,
+		FGameplayTag GameplayCueTag,
+		EGameplayCueEvent::Type EventType,
+		const FGameplayCueParameters& Parameters,
+		EGameplayCueExecutionOptions Options = EGameplayCueExecutionOptions::Default
+	) override;
+	
+	virtual void BeginDestroy() override;
+	
+private:
+	
+	/** An executed cue waiting for the end of its world's tick */
+	struct FPendingCue
+	{
+		TWeakObjectPtr<AActor> TargetActor;
+		FGameplayTag Tag;
+		FGameplayCueParameters Parameters;
+		EGameplayCueExecutionOptions Options;
+		FVector Location;
+		int32 Priority;
+	};
+	
+	/** Plays the cues collected for a world within the budget */
+	void FlushPendingCues(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	
+	/** Returns the rank of a cue */
+	int32 GetPriority(const FGameplayTag& Tag) const;
+	
+	/** Returns where a cue lands: its hit, its location or its target */
+	static FVector GetCueLocation(const AActor* TargetActor, const FGameplayCueParameters& Parameters);
+	
+private:
+	
+	TArray<FPendingCue> PendingCues;
+	
+	FDelegateHandle TickEndHandle;
+};
@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/GameplayCue/GameplayCueEffectPoolSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+bool UGameplayCueEffectPoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+	
+	// Dedicated servers never play cues
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UGameplayCueEffectPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	
+	TArray<FSoftObjectPath> EffectPaths;
+	
+	for (const FGameplayCueEffectPrewarm& Entry : Prewarm)
+	{
+		if (!Entry.Effect.IsNull() && Entry.Count > 0)
+		{
+			EffectPaths.Add(Entry.Effect.ToSoftObjectPath());
+		}
+	}
+	
+	if (EffectPaths.IsEmpty())
+	{
+		return;
+	}
+	
+	PrewarmLoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(EffectPaths),
+		FStreamableDelegate::CreateWeakLambda(this, [this] { OnPrewarmLoaded(); })
+	);
+}
+
+void UGameplayCueEffectPoolSubsystem::Deinitialize()
+{
+	if (PrewarmLoadHandle.IsValid())
+	{
+		PrewarmLoadHandle->CancelHandle();
+		PrewarmLoadHandle.Reset();
+	}
+	
+	// Components belong to the world settings and go away with the world
+	Pools.Empty();
+	
+	Super::Deinitialize();
+}
+
+void UGameplayCueEffectPoolSubsystem::OnPrewarmLoaded()
+{
+	for (const FGameplayCueEffectPrewarm& Entry : Prewarm)
+	{
+		PrewarmEffect(Entry.Effect.Get(), Entry.Count);
+	}
+	
+	PrewarmLoadHandle.Reset();
+}
+
+void UGameplayCueEffectPoolSubsystem::PrewarmEffect(UFXSystemAsset* Effect, int32 Count)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	if (!Effect)
+	{
+		return;
+	}
+	
+	FGameplayCueEffectPool& Pool = Pools.FindOrAdd(Effect);
+	Count = FMath::Min(Count, MaxComponentsPerEffect);
+	
+	while (Pool.Components.Num() < Count)
+	{
+		if (UFXSystemComponent* Component = CreateComponent(Effect))
+		{
+			Pool.Components.Add(Component);
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+UFXSystemComponent* UGameplayCueEffectPoolSubsystem::SpawnEffect(UFXSystemAsset* Effect, const FVector& Location, const FRotator& Rotation)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	if (!Effect)
+	{
+		return nullptr;
+	}
+	
+	FGameplayCueEffectPool& Pool = Pools.FindOrAdd(Effect);
+	const int32 Num = Pool.Components.Num();
+	UFXSystemComponent* Component = nullptr;
+	
+	// Look for an idle component, starting after the last one handed out
+	for (int32 Step = 0; Step < Num; ++Step)
+	{
+		const int32 Index = (Pool.NextIndex + Step) % Num;
+		UFXSystemComponent* Candidate = Pool.Components[Index];
+		
+		if (Candidate && !Candidate->IsActive())
+		{
+			Component = Candidate;
+			Pool.NextIndex = (Index + 1) % Num;
+			break;
+		}
+	}
+	
+	if (!Component)
+	{
+		COMBAT_COUNT(CuePoolMisses);
+		
+		if (Num < MaxComponentsPerEffect)
+		{
+			Component = CreateComponent(Effect);
+			
+			if (!Component)
+			{
+				return nullptr;
+			}
+			
+			Pool.Components.Add(Component);
+		}
+		else
+		{
+			// Every component is busy, cut the oldest one short
+			Component = Pool.Components[Pool.NextIndex];
+			Pool.NextIndex = (Pool.NextIndex + 1) % Num;
+		}
+	}
+	
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->Activate(true);
+	
+	return Component;
+}
+
+UFXSystemComponent* UGameplayCueEffectPoolSubsystem::CreateComponent(UFXSystemAsset* Effect)
+{
+	UWorld* World = GetWorld();
+	AWorldSettings* Owner = World->GetWorldSettings();
+	UFXSystemComponent* Component = nullptr;
+	
+	if (UNiagaraSystem* NiagaraSystem = Cast<UNiagaraSystem>(Effect))
+	{
+		UNiagaraComponent* NiagaraComponent = NewObject<UNiagaraComponent>(Owner);
+		NiagaraComponent->SetAsset(NiagaraSystem);
+		NiagaraComponent->SetAutoDestroy(false);
+		Component = NiagaraComponent;
+	}
+	else if (UParticleSystem* ParticleSystem = Cast<UParticleSystem>(Effect))
+	{
+		UParticleSystemComponent* ParticleComponent = NewObject<UParticleSystemComponent>(Owner);
+		ParticleComponent->bAutoDestroy = false;
+		ParticleComponent->SetTemplate(ParticleSystem);
+		Component = ParticleComponent;
+	}
+	
+	if (!Component)
+	{
+		return nullptr;
+	}
+	
+	COMBAT_COUNT(Spawns);
+	
+	// Not attached to anything, placed in world space every time it plays
+	Component->bAutoActivate = false;
+	Component->SetUsingAbsoluteLocation(true);
+	Component->SetUsingAbsoluteRotation(true);
+	Component->RegisterComponentWithWorld(World);
+	
+	return Component;
+}
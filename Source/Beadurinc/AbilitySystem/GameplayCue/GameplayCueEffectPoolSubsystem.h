@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayCueEffectPoolSubsystem.generated.h"
+
+class UFXSystemAsset;
+class UFXSystemComponent;
+struct FStreamableHandle;
+
+/** An effect spawned ahead of play */
+USTRUCT()
+struct FGameplayCueEffectPrewarm
+{
+	GENERATED_BODY()
+	
+	/** Cascade or Niagara system */
+	UPROPERTY(Config, EditAnywhere, Category = "Pool")
+	TSoftObjectPtr<UFXSystemAsset> Effect;
+	
+	/** Components created when the world begins play */
+	UPROPERTY(Config, EditAnywhere, Category = "Pool", meta = (ClampMin = "0"))
+	int32 Count = 4;
+};
+
+/** Components of one effect, reused round-robin */
+USTRUCT()
+struct FGameplayCueEffectPool
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UFXSystemComponent>> Components;
+	
+	/** Where the search for an idle component starts */
+	int32 NextIndex = 0;
+};
+
+/**
+ * Pools the particle components gameplay cues spawn.
+ *
+ * Spawning an effect through the Gameplay Statics creates, registers and eventually destroys a
+ * component every time. Here the components of an effect are created once and restarted in
+ * place; an idle one is reused, and when every one is still playing a new one is created up to
+ * MaxComponentsPerEffect, then the oldest is restarted. Both count as a pool miss in "stat Combat".
+ *
+ * The effects listed in Prewarm are loaded and created when the world begins play, so the
+ * first hits of a fight do not pay for them. Nothing is pooled on dedicated servers.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UGameplayCueEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+	
+	/** Effects created ahead of play */
+	UPROPERTY(Config)
+	TArray<FGameplayCueEffectPrewarm> Prewarm;
+	
+	/** Most components of one effect */
+	UPROPERTY(Config)
+	int32 MaxComponentsPerEffect = 16;
+	
+public:
+	
+	/** Plays an effect at a location with a pooled component. Returns the component, or null without an effect */
+	UFXSystemComponent* SpawnEffect(UFXSystemAsset* Effect, const FVector& Location, const FRotator& Rotation);
+	
+	/** Creates idle components of a loaded effect until its pool holds Count of them, up to MaxComponentsPerEffect */
+	void PrewarmEffect(UFXSystemAsset* Effect, int32 Count);
+	
+protected:
+	
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	
+	virtual void Deinitialize() override;
+	
+private:
+	
+	/** Creates the prewarmed components once their effects are loaded */
+	void OnPrewarmLoaded();
+	
+	/** Creates and registers an idle component playing the effect */
+	UFXSystemComponent* CreateComponent(UFXSystemAsset* Effect);
+	
+private:
+	
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UFXSystemAsset>, FGameplayCueEffectPool> Pools;
+	
+	/** Keeps the prewarmed effects loading */
+	TSharedPtr<FStreamableHandle> PrewarmLoadHandle;
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/GameplayCue/PooledBurstGameplayCueNotify.h"
+#include "AbilitySystem/GameplayCue/GameplayCueEffectPoolSubsystem.h"
+#include "Camera/CameraShakeBase.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Combat/Audio/CombatAudioSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+bool UPooledBurstGameplayCueNotify::OnExecute_Implementation(AActor* MyTarget, const FGameplayCueParameters& Parameters) const
+{
+	UWorld* World = MyTarget ? MyTarget->GetWorld() : nullptr;
+	
+	if (!World)
+	{
+		return false;
+	}
+	
+	FVector Location = MyTarget->GetActorLocation();
+	FRotator Rotation = FRotator::ZeroRotator;
+	
+	// Face the effect along "impact point - collider component location", like the hit spurts out of the body
+	if (const FHitResult* Hit = Parameters.EffectContext.GetHitResult())
+	{
+		Location = Hit->ImpactPoint;
+		
+		if (const UPrimitiveComponent* HitComponent = Hit->GetComponent())
+		{
+			Rotation = (Hit->ImpactPoint - HitComponent->GetComponentLocation()).Rotation();
+		}
+	}
+	
+	if (Effect)
+	{
+		if (UGameplayCueEffectPoolSubsystem* EffectPool = World->GetSubsystem<UGameplayCueEffectPoolSubsystem>())
+		{
+			EffectPool->SpawnEffect(Effect, Location, Rotation);
+		}
+	}
+	
+	UCombatAudioSubsystem::PlayCombatSound(MyTarget, Sound, SoundCategory, Location);
+	
+	if (InstigatorCameraShake)
+	{
+		const APawn* InstigatorPawn = Cast<APawn>(Parameters.Instigator.Get());
+		APlayerController* PlayerController = InstigatorPawn ? Cast<APlayerController>(InstigatorPawn->GetController()) : nullptr;
+		
+		if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+		{
+			PlayerController->PlayerCameraManager->StartCameraShake(InstigatorCameraShake);
+		}
+	}
+	
+	return true;
+}
+
+#if WITH_EDITOR
+void UPooledBurstGameplayCueNotify::SetBurst(UFXSystemAsset* InEffect, USoundBase* InSound, ECombatSoundCategory InSoundCategory, TSubclassOf<UCameraShakeBase> InInstigatorCameraShake)
+{
+	Effect = InEffect;
+	Sound = InSound;
+	SoundCategory = InSoundCategory;
+	InstigatorCameraShake = InInstigatorCameraShake;
+}
+#endif
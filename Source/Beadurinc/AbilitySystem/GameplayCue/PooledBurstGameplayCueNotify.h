@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayCueNotify_Static.h"
+#include "Combat/Audio/CombatAudio.h"
+#include "PooledBurstGameplayCueNotify.generated.h"
+
+class UCameraShakeBase;
+class UFXSystemAsset;
+class USoundBase;
+
+/**
+ * Plays a particle effect and a sound where a hit landed, e.g. GameplayCue.MeleeHurt.
+ *
+ * The effect comes from UGameplayCueEffectPoolSubsystem instead of being spawned, and faces
+ * away from the collider that was hit. The sound is played through the combat audio budget.
+ * The player who dealt the hit feels it through a camera shake.
+ */
+UCLASS()
+class BEADURINC_API UPooledBurstGameplayCueNotify : public UGameplayCueNotify_Static
+{
+	GENERATED_BODY()
+	
+	/** Cascade or Niagara system played at the hit */
+	UPROPERTY(EditDefaultsOnly, Category = "Burst")
+	TObjectPtr<UFXSystemAsset> Effect;
+	
+	/** Sound played at the hit */
+	UPROPERTY(EditDefaultsOnly, Category = "Burst")
+	TObjectPtr<USoundBase> Sound;
+	
+	/** Voice budget the sound is played within */
+	UPROPERTY(EditDefaultsOnly, Category = "Burst")
+	ECombatSoundCategory SoundCategory = ECombatSoundCategory::Hit;
+	
+	/** Camera shake of the instigator, when it is a locally controlled player */
+	UPROPERTY(EditDefaultsOnly, Category = "Burst")
+	TSubclassOf<UCameraShakeBase> InstigatorCameraShake;
+	
+public:
+	
+	virtual bool OnExecute_Implementation(AActor* MyTarget, const FGameplayCueParameters& Parameters) const override;
+	
+	FORCEINLINE UFXSystemAsset* GetEffect() const { return Effect; }
+	
+#if WITH_EDITOR
+	/** Sets what the cue plays, for the cues migrated by ReparentBurstCues */
+	void SetBurst(UFXSystemAsset* InEffect, USoundBase* InSound, ECombatSoundCategory InSoundCategory, TSubclassOf<UCameraShakeBase> InInstigatorCameraShake);
+#endif
+};
@@ -0,0 +1,232 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/GameplayCue/ReparentBurstCuesCommandlet.h"
+#include "AbilitySystem/GameplayCue/PooledBurstGameplayCueNotify.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Beadurinc.h"
+#include "Camera/CameraShakeBase.h"
+#include "Engine/Blueprint.h"
+#include "GameplayCueNotify_Static.h"
+#include "Misc/PackageName.h"
+#include "Particles/ParticleSystem.h"
+#include "Sound/SoundBase.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_EDITOR
+#include "EdGraph/EdGraph.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_Event.h"
+#include "K2Node_Knot.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+namespace ReparentBurstCues
+{
+	/** What a cue's graph plays, read from the defaults of its call pins */
+	struct FBurst
+	{
+		UFXSystemAsset* Effect = nullptr;
+		USoundBase* Sound = nullptr;
+		TSubclassOf<UCameraShakeBase> CameraShake;
+	};
+	
+	/**
+	 * Returns whether a node only feeds the calls read into FBurst: the OnExecute event, breaking its
+	 * parameters, casts, reroutes, comments and disabled nodes. Anything else, such as a branch, a
+	 * select, a variable or a macro, could make the burst conditional or change what it plays
+	 */
+	static bool IsPassiveNode(const UEdGraphNode* Node)
+	{
+		if (Node->GetDesiredEnabledState() == ENodeEnabledState::Disabled)
+		{
+			return true;
+		}
+		
+		if (const UK2Node_Event* Event = Cast<UK2Node_Event>(Node))
+		{
+			return Event->EventReference.GetMemberName() == GET_FUNCTION_NAME_CHECKED(UGameplayCueNotify_Static, OnExecute);
+		}
+		
+		if (const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node))
+		{
+			return Call->GetFunctionName() == TEXT("BreakGameplayCueParameters");
+		}
+		
+		return Node->IsA<UK2Node_DynamicCast>() || Node->IsA<UK2Node_Knot>() || Node->IsA<UEdGraphNode_Comment>();
+	}
+	
+	/** Reads what the blueprint's event graph plays. Returns false when the graph does anything a pooled burst does not */
+	static bool ReadBurst(const UBlueprint* Blueprint, FBurst& OutBurst)
+	{
+		for (const UEdGraph* Graph : Blueprint->UbergraphPages)
+		{
+			for (const UEdGraphNode* Node : Graph->Nodes)
+			{
+				const UK2Node_CallFunction* Call = Cast<UK2Node_CallFunction>(Node);
+				const FName Function = Call ? Call->GetFunctionName() : NAME_None;
+				bool bPinLinked = false;
+				
+				// Only assets set on the pin itself are known here, one coming through a link is decided when the cue runs
+				const auto GetPinObject = [Call, &bPinLinked](const TCHAR* PinName) -> UObject*
+				{
+					const UEdGraphPin* Pin = Call->FindPin(PinName);
+					bPinLinked |= Pin && Pin->LinkedTo.Num() > 0;
+					return Pin ? Pin->DefaultObject.Get() : nullptr;
+				};
+				
+				if (Function == TEXT("SpawnEmitterAtLocation"))
+				{
+					OutBurst.Effect = Cast<UFXSystemAsset>(GetPinObject(TEXT("EmitterTemplate")));
+				}
+				else if (Function == TEXT("SpawnSystemAtLocation"))
+				{
+					OutBurst.Effect = Cast<UFXSystemAsset>(GetPinObject(TEXT("SystemTemplate")));
+				}
+				else if (Function == TEXT("PlaySoundAtLocation"))
+				{
+					OutBurst.Sound = Cast<USoundBase>(GetPinObject(TEXT("Sound")));
+				}
+				else if (Function == TEXT("StartLegacyCameraShake") || Function == TEXT("StartCameraShake"))
+				{
+					OutBurst.CameraShake = Cast<UClass>(GetPinObject(TEXT("ShakeClass")));
+				}
+				else if (!IsPassiveNode(Node))
+				{
+					return false;
+				}
+				
+				if (bPinLinked)
+				{
+					return false;
+				}
+			}
+		}
+		
+		return OutBurst.Effect || OutBurst.Sound;
+	}
+	
+	/** Returns the category named by the last part of the tag, e.g. Block for GameplayCue.MeleeBlock */
+	static ECombatSoundCategory GetSoundCategory(const FGameplayTag& Tag)
+	{
+		const UEnum* CategoryEnum = StaticEnum<ECombatSoundCategory>();
+		FString LastPart = Tag.ToString();
+		LastPart.Split(TEXT("."), nullptr, &LastPart, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+		
+		for (int32 Index = 0; Index < static_cast<int32>(ECombatSoundCategory::MAX); ++Index)
+		{
+			if (LastPart.Contains(CategoryEnum->GetNameStringByIndex(Index)))
+			{
+				return static_cast<ECombatSoundCategory>(CategoryEnum->GetValueByIndex(Index));
+			}
+		}
+		
+		return ECombatSoundCategory::Hit;
+	}
+}
+#endif
+
+UReparentBurstCuesCommandlet::UReparentBurstCuesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UReparentBurstCuesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Path = TEXT("/Game/Blueprints/GameplayAbilities/Cues");
+	FParse::Value(*Params, TEXT("Path="), Path);
+	
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+	
+	FARFilter Filter;
+	Filter.PackagePaths.Add(*Path);
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	
+	int32 FailedCount = 0;
+	int32 ReparentedCount = 0;
+	
+	for (const FAssetData& Asset : Assets)
+	{
+		UBlueprint* Blueprint = Cast<UBlueprint>(Asset.GetAsset());
+		
+		// Cues that already pool, or derive from anything else, are left as they are
+		if (!Blueprint || Blueprint->ParentClass != UGameplayCueNotify_Static::StaticClass())
+		{
+			continue;
+		}
+		
+		ReparentBurstCues::FBurst Burst;
+		
+		if (!ReparentBurstCues::ReadBurst(Blueprint, Burst))
+		{
+			UE_LOG(LogBeadurinc, Warning, TEXT("%s does more than play an effect and a sound, left on its parent"), *Asset.PackageName.ToString());
+			continue;
+		}
+		
+		const FGameplayTag Tag = CastChecked<UGameplayCueNotify_Static>(Blueprint->GeneratedClass->GetDefaultObject())->GameplayCueTag;
+		
+		UE_LOG(LogBeadurinc, Display, TEXT("Reparenting %s (%s)"), *Asset.PackageName.ToString(), *Tag.ToString());
+		
+		Blueprint->Modify();
+		
+		// The native OnExecute only runs once the graph no longer overrides it
+		for (UEdGraph* Graph : Blueprint->UbergraphPages)
+		{
+			const TArray<TObjectPtr<UEdGraphNode>> Nodes = Graph->Nodes;
+			
+			for (UEdGraphNode* Node : Nodes)
+			{
+				FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+			}
+		}
+		
+		Blueprint->ParentClass = UPooledBurstGameplayCueNotify::StaticClass();
+		FBlueprintEditorUtils::RefreshAllNodes(Blueprint);
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+		
+		UPooledBurstGameplayCueNotify* Defaults = Cast<UPooledBurstGameplayCueNotify>(Blueprint->GeneratedClass->GetDefaultObject());
+		
+		if (!Defaults)
+		{
+			UE_LOG(LogBeadurinc, Error, TEXT("%s did not compile onto UPooledBurstGameplayCueNotify"), *Asset.PackageName.ToString());
+			++FailedCount;
+			continue;
+		}
+		
+		Defaults->GameplayCueTag = Tag;
+		Defaults->SetBurst(Burst.Effect, Burst.Sound, ReparentBurstCues::GetSoundCategory(Tag), Burst.CameraShake);
+		
+		UPackage* Package = Blueprint->GetPackage();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		
+		if (UPackage::SavePackage(Package, Blueprint, *Filename, SaveArgs))
+		{
+			++ReparentedCount;
+		}
+		else
+		{
+			UE_LOG(LogBeadurinc, Error, TEXT("Could not save %s"), *Filename);
+			++FailedCount;
+		}
+	}
+	
+	UE_LOG(LogBeadurinc, Display, TEXT("%d cues under %s were reparented to UPooledBurstGameplayCueNotify"), ReparentedCount, *Path);
+	
+	return FailedCount > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ReparentBurstCuesCommandlet.generated.h"
+
+/**
+ * Moves static cue blueprints that spawn an effect and play a sound in their OnExecute graph,
+ * such as GC_MeleeHurt and GC_MeleeBlock, onto UPooledBurstGameplayCueNotify. The effect, sound
+ * and instigator camera shake are read from the graph's calls, which are then removed so the
+ * pooled native OnExecute runs. The sound category is the one named by the cue tag's last part,
+ * Hit otherwise. Blueprints whose graph does anything else, such as branching, or that take an
+ * asset from a linked pin instead of the pin's value are reported and left alone:
+ *
+ *   UnrealEditor-Cmd Beadurinc.uproject -run=ReparentBurstCues [-Path=/Game/Blueprints/GameplayAbilities/Cues]
+ */
+UCLASS()
+class BEADURINC_API UReparentBurstCuesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	
+	UReparentBurstCuesCommandlet();
+	
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/Subsystem/StaminaRegenerationSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/AttributeSet/LivingAttributeSet.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+bool UStaminaRegenerationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// Only worlds that actually play the game need regeneration (skips editor preview worlds)
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UStaminaRegenerationSubsystem::Deinitialize()
+{
+	// Unbind every attribute delegate before the arrays go away
+	for (int32 Index = AbilitySystems.Num() - 1; Index >= 0; --Index)
+	{
+		RemoveAt(Index);
+	}
+
+	Super::Deinitialize();
+}
+
+void UStaminaRegenerationSubsystem::RegisterAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_AbilitySystem);
+	
+	if (!AbilitySystemComponent || !AbilitySystemComponent->IsOwnerActorAuthoritative())
+	{
+		return;
+	}
+
+	// Already registered (e.g. PlayerState ASC re-possessed by a respawned character)
+	if (SlotIndices.Contains(AbilitySystemComponent))
+	{
+		return;
+	}
+
+	const ULivingAttributeSet* AttributeSet = AbilitySystemComponent->GetSet<ULivingAttributeSet>();
+
+	if (!AttributeSet)
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<UAbilitySystemComponent> WeakASC = AbilitySystemComponent;
+
+	const int32 Index = AbilitySystems.Add(WeakASC);
+	SlotKeys.Add(AbilitySystemComponent);
+	SlotIndices.Add(AbilitySystemComponent, Index);
+
+	StaminaDelegateHandles.Add(
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(ULivingAttributeSet::GetStaminaAttribute())
+			.AddUObject(this, &UStaminaRegenerationSubsystem::OnStaminaChanged, WeakASC)
+	);
+
+	MaxStaminaDelegateHandles.Add(
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(ULivingAttributeSet::GetMaxStaminaAttribute())
+			.AddUObject(this, &UStaminaRegenerationSubsystem::OnMaxStaminaChanged, WeakASC)
+	);
+
+	Stamina.Add(AttributeSet->GetStamina());
+	MaxStamina.Add(AttributeSet->GetMaxStamina());
+	RegenDelay.Add(0.0F);
+	PushCooldown.Add(0.0F);
+	PushedStamina.Add(AttributeSet->GetStamina());
+}
+
+void UStaminaRegenerationSubsystem::UnregisterAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent)
+{
+	if (const int32* Index = SlotIndices.Find(AbilitySystemComponent))
+	{
+		RemoveAt(*Index);
+	}
+}
+
+void UStaminaRegenerationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const int32 Num = Stamina.Num();
+
+	if (Num == 0)
+	{
+		return;
+	}
+
+	float* RESTRICT StaminaData = Stamina.GetData();
+	float* RESTRICT DelayData = RegenDelay.GetData();
+	float* RESTRICT CooldownData = PushCooldown.GetData();
+	const float* RESTRICT MaxData = MaxStamina.GetData();
+	const float RegenAmount = RegenPerSecond * DeltaTime;
+
+	// Branch-free over contiguous floats so the compiler can vectorize the whole pass
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const float Regen = DelayData[Index] <= 0.0F ? RegenAmount : 0.0F;
+
+		StaminaData[Index] = FMath::Min(StaminaData[Index] + Regen, MaxData[Index]);
+		DelayData[Index] = FMath::Max(DelayData[Index] - DeltaTime, 0.0F);
+		CooldownData[Index] -= DeltaTime;
+	}
+
+	// Iterate backward since stale slots are swapped out while iterating
+	for (int32 Index = Num - 1; Index >= 0; --Index)
+	{
+		if (!AbilitySystems[Index].IsValid())
+		{
+			RemoveAt(Index);
+			continue;
+		}
+
+		if (CooldownData[Index] <= 0.0F)
+		{
+			PushStamina(Index);
+		}
+	}
+}
+
+TStatId UStaminaRegenerationSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_Combat_StaminaRegeneration);
+}
+
+void UStaminaRegenerationSubsystem::PushStamina(int32 Index)
+{
+	// Snap to the maximum when full so the bar always reaches the end, otherwise floor to the quantum
+	const float Quantized = Stamina[Index] >= MaxStamina[Index]
+		? MaxStamina[Index]
+		: FMath::FloorToFloat(Stamina[Index] / FMath::Max(PushQuantum, UE_KINDA_SMALL_NUMBER)) * PushQuantum;
+
+	if (FMath::IsNearlyEqual(Quantized, PushedStamina[Index]))
+	{
+		return;
+	}
+
+	// Writing the attribute marks it dirty, which is what actually replicates to clients
+	bPushing = true;
+	AbilitySystems[Index]->SetNumericAttributeBase(ULivingAttributeSet::GetStaminaAttribute(), Quantized);
+	bPushing = false;
+
+	PushedStamina[Index] = Quantized;
+	PushCooldown[Index] = PushInterval;
+}
+
+void UStaminaRegenerationSubsystem::OnStaminaChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UAbilitySystemComponent> Source)
+{
+	if (bPushing)
+	{
+		return;
+	}
+
+	if (const int32* Index = SlotIndices.Find(Source.Get()))
+	{
+		// Spending stamina postpones regeneration
+		if (Data.NewValue < Data.OldValue)
+		{
+			RegenDelay[*Index] = DelayAfterSpend;
+		}
+
+		// Adopt the externally modified value as the new simulation base
+		Stamina[*Index] = Data.NewValue;
+		PushedStamina[*Index] = Data.NewValue;
+	}
+}
+
+void UStaminaRegenerationSubsystem::OnMaxStaminaChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UAbilitySystemComponent> Source)
+{
+	if (const int32* Index = SlotIndices.Find(Source.Get()))
+	{
+		MaxStamina[*Index] = Data.NewValue;
+	}
+}
+
+void UStaminaRegenerationSubsystem::RemoveAt(int32 Index)
+{
+	if (UAbilitySystemComponent* ASC = AbilitySystems[Index].Get())
+	{
+		ASC->GetGameplayAttributeValueChangeDelegate(ULivingAttributeSet::GetStaminaAttribute()).Remove(StaminaDelegateHandles[Index]);
+		ASC->GetGameplayAttributeValueChangeDelegate(ULivingAttributeSet::GetMaxStaminaAttribute()).Remove(MaxStaminaDelegateHandles[Index]);
+	}
+
+	// The last slot moves into the removed one, so its index has to follow
+	SlotIndices.Remove(SlotKeys[Index]);
+
+	if (Index != SlotKeys.Num() - 1)
+	{
+		SlotIndices[SlotKeys.Last()] = Index;
+	}
+
+	SlotKeys.RemoveAtSwap(Index, EAllowShrinking::No);
+	AbilitySystems.RemoveAtSwap(Index, EAllowShrinking::No);
+	StaminaDelegateHandles.RemoveAtSwap(Index, EAllowShrinking::No);
+	MaxStaminaDelegateHandles.RemoveAtSwap(Index, EAllowShrinking::No);
+	Stamina.RemoveAtSwap(Index, EAllowShrinking::No);
+	MaxStamina.RemoveAtSwap(Index, EAllowShrinking::No);
+	RegenDelay.RemoveAtSwap(Index, EAllowShrinking::No);
+	PushCooldown.RemoveAtSwap(Index, EAllowShrinking::No);
+	PushedStamina.RemoveAtSwap(Index, EAllowShrinking::No);
+}
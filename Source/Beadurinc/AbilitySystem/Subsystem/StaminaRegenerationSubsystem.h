@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StaminaRegenerationSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class ULivingAttributeSet;
+struct FOnAttributeChangeData;
+
+/**
+ * Regenerates stamina of every registered Ability System Component in a single pass.
+ *
+ * Running an infinite periodic GameplayEffect on each fighter costs an active effect, a timer
+ * and a replication update per period. Instead, this subsystem keeps the regenerating values
+ * in flat arrays (one slot per ASC), advances all of them together on tick, and writes back to
+ * the Stamina attribute only at a throttled rate and when the quantized value has changed,
+ * so clients receive far fewer attribute updates.
+ *
+ * Only the authority registers ASCs; on clients the subsystem stays empty and never ticks work.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UStaminaRegenerationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Stamina recovered per second */
+	UPROPERTY(Config)
+	float RegenPerSecond = 20.0F;
+
+	/** Seconds to wait after stamina has been spent before regeneration restarts */
+	UPROPERTY(Config)
+	float DelayAfterSpend = 1.0F;
+
+	/** Minimum seconds between two attribute writes (and therefore replication updates) per ASC */
+	UPROPERTY(Config)
+	float PushInterval = 0.2F;
+
+	/** Stamina is written back in multiples of this step, sub-step changes are not replicated */
+	UPROPERTY(Config)
+	float PushQuantum = 1.0F;
+
+public:
+
+	/** Starts regenerating stamina of the given ASC. Ignored without authority or a LivingAttributeSet */
+	void RegisterAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent);
+
+	/** Stops regenerating stamina of the given ASC */
+	void UnregisterAbilitySystem(UAbilitySystemComponent* AbilitySystemComponent);
+
+	/** Returns the number of ASCs currently regenerating */
+	FORCEINLINE int32 GetNumRegistered() const { return AbilitySystems.Num(); }
+
+protected:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	/** Called whenever a registered ASC's stamina changes by any means */
+	void OnStaminaChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UAbilitySystemComponent> Source);
+
+	/** Called whenever a registered ASC's maximum stamina changes by any means */
+	void OnMaxStaminaChanged(const FOnAttributeChangeData& Data, TWeakObjectPtr<UAbilitySystemComponent> Source);
+
+	/** Writes the simulated value of a slot back to its attribute */
+	void PushStamina(int32 Index);
+
+	/** Removes a slot by swapping the last one into its place */
+	void RemoveAt(int32 Index);
+
+private:
+
+	/** Maps an ASC to its slot in the arrays below */
+	TMap<TObjectKey<UAbilitySystemComponent>, int32> SlotIndices;
+
+	// Structure of arrays, one element per registered ASC. Kept in sync by RegisterAbilitySystem/RemoveAt.
+	TArray<TObjectKey<UAbilitySystemComponent>> SlotKeys;
+	TArray<TWeakObjectPtr<UAbilitySystemComponent>> AbilitySystems;
+	TArray<FDelegateHandle> StaminaDelegateHandles;
+	TArray<FDelegateHandle> MaxStaminaDelegateHandles;
+	TArray<float> Stamina;
+	TArray<float> MaxStamina;
+	TArray<float> RegenDelay;
+	TArray<float> PushCooldown;
+	TArray<float> PushedStamina;
+
+	/** Set while this subsystem writes an attribute so its own change callback is ignored */
+	bool bPushing = false;
+};
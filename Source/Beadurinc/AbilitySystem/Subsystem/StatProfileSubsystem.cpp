@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/Subsystem/StatProfileSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "Engine/DataTable.h"
+#include "Combat/Debug/CombatMemory.h"
+
+void UStatProfileSubsystem::ApplyStatProfile(UAbilitySystemComponent* AbilitySystemComponent, UAttributeSet* AttributeSet, const UDataTable* StatsTable)
+{
+	if (!AbilitySystemComponent || !AttributeSet || !StatsTable)
+	{
+		return;
+	}
+	
+	const FCompiledStatProfile& Profile = GetStatProfile(AttributeSet->GetClass(), StatsTable);
+	
+	for (int32 Index = 0; Index < Profile.Attributes.Num(); ++Index)
+	{
+		if (FGameplayAttributeData* Data = Profile.Attributes[Index].GetGameplayAttributeData(AttributeSet))
+		{
+			Data->SetBaseValue(Profile.Values[Index]);
+			Data->SetCurrentValue(Profile.Values[Index]);
+		}
+	}
+	
+	// One replication update for the whole reset
+	AbilitySystemComponent->ForceReplication();
+}
+
+const FCompiledStatProfile& UStatProfileSubsystem::GetStatProfile(const UClass* AttributeSetClass, const UDataTable* StatsTable)
+{
+	const TPair<TObjectKey<UClass>, TObjectKey<UDataTable>> Key(AttributeSetClass, StatsTable);
+	
+	if (const FCompiledStatProfile* Profile = Profiles.Find(Key))
+	{
+		return *Profile;
+	}
+	
+	return Profiles.Add(Key, Compile(AttributeSetClass, StatsTable));
+}
+
+FCompiledStatProfile UStatProfileSubsystem::Compile(const UClass* AttributeSetClass, const UDataTable* StatsTable)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_AbilitySystem);
+	
+	FCompiledStatProfile Profile;
+	
+	static const FString Context(TEXT("UStatProfileSubsystem::Compile"));
+	
+	for (TFieldIterator<FProperty> It(AttributeSetClass, EFieldIteratorFlags::IncludeSuper); It; ++It)
+	{
+		FProperty* Property = *It;
+		
+		if (!FGameplayAttribute::IsGameplayAttributeDataProperty(Property))
+		{
+			continue;
+		}
+		
+		// Same row naming as UAttributeSet::InitFromMetaDataTable, so existing stats tables work unchanged
+		const FString RowName = FString::Printf(TEXT("%s.%s"), *Property->GetOwnerVariant().GetName(), *Property->GetName());
+		
+		if (const FAttributeMetaData* MetaData = StatsTable->FindRow<FAttributeMetaData>(FName(*RowName), Context, false))
+		{
+			Profile.Attributes.Add(FGameplayAttribute(Property));
+			Profile.Values.Add(MetaData->BaseValue);
+		}
+	}
+	
+	return Profile;
+}
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "StatProfileSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UDataTable;
+
+/** Initial values of one attribute set class from one stats table, resolved to attributes */
+struct FCompiledStatProfile
+{
+	/** Attributes the table has a row for, parallel to Values */
+	TArray<FGameplayAttribute> Attributes;
+	
+	/** Initial value of each attribute */
+	TArray<float> Values;
+};
+
+/**
+ * Caches stats tables compiled per attribute set class.
+ *
+ * UAbilitySystemComponent::InitStats walks every property of the attribute set and looks up
+ * its "ClassName.AttributeName" row by string on every call. The profile does this once per
+ * class and table for the lifetime of the game instance, after which a reset is a single pass
+ * of direct writes. The semantics match InitStats: base and current values are both set.
+ */
+UCLASS()
+class BEADURINC_API UStatProfileSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+	
+public:
+	
+	/** Writes the table's initial values into the attribute set, compiling the profile on first use */
+	void ApplyStatProfile(UAbilitySystemComponent* AbilitySystemComponent, UAttributeSet* AttributeSet, const UDataTable* StatsTable);
+	
+	/** Returns the compiled profile of an attribute set class and stats table */
+	const FCompiledStatProfile& GetStatProfile(const UClass* AttributeSetClass, const UDataTable* StatsTable);
+	
+	/** Returns how many profiles have been compiled */
+	FORCEINLINE int32 GetNumProfiles() const { return Profiles.Num(); }
+	
+private:
+	
+	/** Resolves every attribute of the class that has a row in the table */
+	static FCompiledStatProfile Compile(const UClass* AttributeSetClass, const UDataTable* StatsTable);
+	
+private:
+	
+	/** Compiled profiles by attribute set class and stats table */
+	TMap<TPair<TObjectKey<UClass>, TObjectKey<UDataTable>>, FCompiledStatProfile> Profiles;
+};
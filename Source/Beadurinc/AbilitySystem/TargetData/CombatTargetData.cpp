@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AbilitySystem/TargetData/CombatTargetData.h"
+#include "GameFramework/GameStateBase.h"
+
+bool FCombatTargetData_Timestamp::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << ServerTime;
+	
+	bOutSuccess = true;
+	return true;
+}
+
+double FCombatTargetData_Timestamp::FindServerTime(const FGameplayAbilityTargetDataHandle& TargetData, double Fallback)
+{
+	for (int32 Index = 0; Index < TargetData.Num(); ++Index)
+	{
+		const FGameplayAbilityTargetData* Data = TargetData.Get(Index);
+		
+		if (Data && Data->GetScriptStruct() == StaticStruct())
+		{
+			return static_cast<const FCombatTargetData_Timestamp*>(Data)->ServerTime;
+		}
+	}
+	
+	return Fallback;
+}
+
+double FCombatTargetData_Timestamp::GetServerTime(const UWorld* World)
+{
+	if (!World)
+	{
+		return 0.0;
+	}
+	
+	// Before the game state replicates, the local clock is the best estimate there is
+	if (const AGameStateBase* GameState = World->GetGameState())
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+	
+	return World->GetTimeSeconds();
+}
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "CombatTargetData.generated.h"
+
+/**
+ * Server world time at which a combat action happened on the machine that performed it.
+ *
+ * Sent by clients along with block activation so the server can place the guard window
+ * where the player actually pressed, and attached to hit events so the defender resolves
+ * the hit against the moment it landed instead of the moment it is processed.
+ */
+USTRUCT()
+struct BEADURINC_API FCombatTargetData_Timestamp : public FGameplayAbilityTargetData
+{
+	GENERATED_BODY()
+	
+	FCombatTargetData_Timestamp() = default;
+	
+	explicit FCombatTargetData_Timestamp(double InServerTime) : ServerTime(InServerTime) {}
+	
+	/** Time in the server's world clock, as estimated by AGameStateBase::GetServerWorldTimeSeconds */
+	UPROPERTY()
+	double ServerTime = 0.0;
+	
+	virtual UScriptStruct* GetScriptStruct() const override { return StaticStruct(); }
+	
+	virtual FString ToString() const override { return FString::Printf(TEXT("FCombatTargetData_Timestamp(%.4f)"), ServerTime); }
+	
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	
+	/** Returns the first timestamp in the handle, or Fallback if it carries none */
+	static double FindServerTime(const FGameplayAbilityTargetDataHandle& TargetData, double Fallback);
+	
+	/** Returns the server world time as known to this machine */
+	static double GetServerTime(const UWorld* World);
+};
+
+template<>
+struct TStructOpsTypeTraits<FCombatTargetData_Timestamp> : public TStructOpsTypeTraitsBase2<FCombatTargetData_Timestamp>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -3,6 +3,10 @@
 #include "AncientKingCharacter.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/AbilityId.h"
+#include "AbilitySystem/AbilitySet/FighterAbilitySet.h"
+#include "AbilitySystem/Subsystem/StatProfileSubsystem.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "Engine/GameInstance.h"
 
 // Sets default values
 AAncientKingCharacter::AAncientKingCharacter()
@@ -18,6 +22,8 @@ AAncientKingCharacter::AAncientKingCharacter()
 	
 	// Full -> The GAS components will be replicated all tracking clients
 	AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Full);
+	
+	Team = ECombatTeam::Monster;
 }
 
 void AAncientKingCharacter::BeginPlay()
@@ -27,6 +33,8 @@ void AAncientKingCharacter::BeginPlay()
 	// Initialize only in authorized side to let them replicated to clients by networking
 	if (AbilitySystemComponent && HasAuthority())
 	{
+		LLM_SCOPE_BYTAG(Beadurinc_AbilitySystem);
+		
 		if (AttributeSetClass)
 		{
 			// Create AttributeSet
@@ -42,11 +50,26 @@ void AAncientKingCharacter::BeginPlay()
 		
 		if (InitialStatsTable)
 		{
-			// Initialize stats from data table 
-			AbilitySystemComponent->InitStats(AttributeSetClass, InitialStatsTable);
+			// Initialize stats from the compiled profile of the data table, shared by every spawn
+			if (UStatProfileSubsystem* StatProfiles = UGameInstance::GetSubsystem<UStatProfileSubsystem>(GetGameInstance()))
+			{
+				StatProfiles->ApplyStatProfile(AbilitySystemComponent, AttributeSet, InitialStatsTable);
+			}
+		}
+		
+		RegisterStaminaRegeneration();
+		BindCombatTimeline();
+		
+		if (AbilitySet)
+		{
+			AbilitySetLoadHandle = AbilitySet->LoadAndGiveToAbilitySystem(AbilitySystemComponent, this);
 		}
 		
-		FGameplayAbilitySpec HitReactSpec(HitReactAbility, 1, static_cast<int32>(EAbilityId::Hit_React), this);
-		AbilitySystemComponent->GiveAbility(HitReactSpec);
+		// Hits are only ever reacted to through this ability, so a set authored without it must not leave the king unhittable
+		if (IsValid(HitReactAbility) && (!AbilitySet || !AbilitySet->GetClassPaths().Contains(FSoftObjectPath(HitReactAbility.Get()))))
+		{
+			FGameplayAbilitySpec HitReactSpec(HitReactAbility, 1, static_cast<int32>(EAbilityId::Hit_React), this);
+			AbilitySystemComponent->GiveAbility(HitReactSpec);
+		}
 	}
 }
\ No newline at end of file
@@ -7,7 +7,9 @@
 #include "AncientKingCharacter.generated.h"
 
 class UAbilitySystemComponent;
+class UFighterAbilitySet;
 class ULivingAttributeSet;
+struct FStreamableHandle;
 
 UCLASS()
 class BEADURINC_API AAncientKingCharacter : public AFighterCharacter
@@ -22,10 +24,19 @@ class BEADURINC_API AAncientKingCharacter : public AFighterCharacter
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Gameplay Abilities", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UDataTable> InitialStatsTable;
 	
+	/** Abilities and starting effects granted on spawn. HitReactAbility is granted as well unless the set lists it */
+	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Abilities")
+	TObjectPtr<UFighterAbilitySet> AbilitySet;
+	
+	/** Keeps the ability set's classes loading until they are granted */
+	TSharedPtr<FStreamableHandle> AbilitySetLoadHandle;
+	
 public:
 	
 	virtual void BeginPlay() override;
 	
 	// Sets default values for this character's properties
 	AAncientKingCharacter();
+	
+	FORCEINLINE virtual const UFighterAbilitySet* GetAbilitySet() const override { return AbilitySet; }
 };
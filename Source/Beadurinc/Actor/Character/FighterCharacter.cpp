@@ -3,62 +3,174 @@
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/GameplayTag/GameplayEventTags.h"
+#include "AbilitySystem/Subsystem/StaminaRegenerationSubsystem.h"
+#include "AbilitySystem/TargetData/CombatTargetData.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Animation/Timeline/StateWindowComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Combat/CombatCollision.h"
+#include "Combat/CombatSpatialIndexSubsystem.h"
+#include "Combat/CombatStats.h"
 #include "MotionWarpingComponent.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "GameData/BeadurincGameState.h"
+#include "Net/UnrealNetwork.h"
+
+// Body mask filters only have this many bits, teams past it rely on the hostility test in OnMeleeContacts
+static constexpr uint32 TeamMaskFilterBits = 6;
 
 AFighterCharacter::AFighterCharacter()
 {
+	LLM_SCOPE_BYTAG(Beadurinc_Fighters);
+	
 	// Create Motion Wraping component
 	MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("MotionWarpingComponent"));
+	
+	// Create state window component
+	StateWindowComponent = CreateDefaultSubobject<UStateWindowComponent>(TEXT("StateWindowComponent"));
+	
+	// Create the weapon held in the hand. A component instead of an actor of its own
+	{
+		LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+		
+		WeaponComponent = CreateDefaultSubobject<UWeaponComponent>(TEXT("WeaponComponent"));
+		WeaponComponent->SetupAttachment(GetMesh());
+	}
+	
+	// Fighters are the only bodies that weapon traces can find
+	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_WeaponTrace, ECR_Overlap);
+	
+	Team = ECombatTeam::Neutral;
+	HostileTeamMask = 0;
+	
+	// No guard has been raised yet
+	GuardStartTime = TNumericLimits<double>::Max();
+	GuardEndTime = TNumericLimits<double>::Max();
+	ParryEndTime = TNumericLimits<double>::Max();
+	
+	CombatId = 0;
+	SwingCount = 0;
 }
 
 void AFighterCharacter::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	// Spawn a weapon actor and attach to the hand
-	if (GetMesh() && WeaponActorBlueprint)
+	// Clients receive the id with the fighter's first replication
+	if (HasAuthority())
+	{
+		if (ABeadurincGameState* GameState = GetWorld()->GetGameState<ABeadurincGameState>())
+		{
+			CombatId = GameState->AllocateCombatId();
+		}
+	}
+	
+	// Resolve the hostility matrix once, so melee contacts only need a single AND
+	HostileTeamMask = GetDefault<UCombatTeamSettings>()->GetHostileMask(Team);
+	
+	// Tag own bodies with the team bit so weapon queries of friendly teams skip them
+	const uint32 TeamIndex = static_cast<uint32>(Team);
+	
+	if (TeamIndex < TeamMaskFilterBits)
+	{
+		GetCapsuleComponent()->SetMaskFilterOnBodyInstance(static_cast<FMaskFilter>(1u << TeamIndex));
+		GetMesh()->SetMaskFilterOnBodyInstance(static_cast<FMaskFilter>(1u << TeamIndex));
+	}
+	
+	// Let area attacks find this fighter
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
 	{
-		// Instigator != Owner under certain cases
-		// e.g. Player shots an arrow using bow: Arrow's owner == bow, but arrow's instigator == player
-		FActorSpawnParameters ActorSpawnParameters;
-		ActorSpawnParameters.Owner = this;
-		ActorSpawnParameters.Instigator = GetInstigator();
+		SpatialIndex->RegisterFighter(this);
+	}
+	
+	// Hold the weapon in the hand, reading legacy weapon actors into weapon data
+	if (!WeaponData && WeaponActorBlueprint)
+	{
+		WeaponData = UWeaponDataAsset::GetFromWeaponActor(WeaponActorBlueprint);
+	}
+	
+	if (WeaponData)
+	{
+		LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+		
+		WeaponComponent->Equip(WeaponData);
 		
-		if (AWeaponActor* WeaponActor = GetWorld()->SpawnActor<AWeaponActor>(WeaponActorBlueprint, ActorSpawnParameters))
+		// Skip bodies of every team this fighter cannot hurt before a contact is even reported
+		WeaponComponent->SetIgnoreMask(GetFriendlyMaskFilter());
+		WeaponComponent->OnWeaponContact.AddUObject(this, &AFighterCharacter::OnMeleeContacts);
+		
+		// Nobody looks at poses on a dedicated server, but the weapon is swept where the bones put it.
+		// Posing stops only when every combo attack can be swept along its baked trajectory instead
+		if (GetNetMode() == NM_DedicatedServer && WeaponData->HasAllComboTrajectories())
 		{
-			// Initialize main hand weapon actor
-			WeaponActorInstance = WeaponActor;
-			
-			if (UCapsuleComponent* CapsuleCollider = WeaponActorInstance->FindComponentByClass<UCapsuleComponent>())
-			{
-				// Gives "NoCollision" at first since weapon only can hurt other characters when activated by anim notify.
-				CapsuleCollider->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
-				CapsuleCollider->OnComponentBeginOverlap.AddDynamic(this, &AFighterCharacter::OnMeleeContacts);
-			}
-			
-			WeaponActorInstance->SetActorEnableCollision(false);
-			
-			// Attach a weapon actor to a skeleton socket
-			WeaponActor->AttachToComponent(
-				GetMesh(),
-				FAttachmentTransformRules::SnapToTargetNotIncludingScale,
-				TEXT("Weapon_Socket")
-			);
+			GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickMontagesWhenNotRendered;
+			WeaponComponent->SetTraceFromTrajectories(true);
 		}
 	}
 }
 
-void AFighterCharacter::OnMeleeContacts
-(
-	UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor,
-	UPrimitiveComponent* OtherComp,
-	int32 OtherBodyIndex,
-	bool bFromSweep,
-	const FHitResult& SweepResult
-)
+void AFighterCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_COMBAT_TIMELINE
+	if (AbilitySystemComponent && AbilityActivatedHandle.IsValid())
+	{
+		AbilitySystemComponent->AbilityActivatedCallbacks.Remove(AbilityActivatedHandle);
+		AbilityActivatedHandle.Reset();
+	}
+#endif
+	
+	// PlayerState ASCs outlive the character, so stop regenerating on behalf of this avatar
+	if (UStaminaRegenerationSubsystem* StaminaRegeneration = GetWorld()->GetSubsystem<UStaminaRegenerationSubsystem>())
+	{
+		StaminaRegeneration->UnregisterAbilitySystem(AbilitySystemComponent);
+	}
+	
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterFighter(this);
+	}
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+void AFighterCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	
+	DOREPLIFETIME_CONDITION(AFighterCharacter, CombatId, COND_InitialOnly);
+	DOREPLIFETIME(AFighterCharacter, SwingCount);
+}
+
+void AFighterCharacter::RegisterStaminaRegeneration()
+{
+	if (UStaminaRegenerationSubsystem* StaminaRegeneration = GetWorld()->GetSubsystem<UStaminaRegenerationSubsystem>())
+	{
+		StaminaRegeneration->RegisterAbilitySystem(AbilitySystemComponent);
+	}
+}
+
+void AFighterCharacter::BindCombatTimeline()
+{
+#if WITH_COMBAT_TIMELINE
+	if (!AbilitySystemComponent || AbilityActivatedHandle.IsValid())
+	{
+		return;
+	}
+	
+	AbilityActivatedHandle = AbilitySystemComponent->AbilityActivatedCallbacks.AddWeakLambda(this, [this](UGameplayAbility* Ability)
+	{
+		RECORD_COMBAT_EVENT(this, AbilityActivated, Ability->GetClass()->GetFName());
+	});
+#endif
+}
+
+void AFighterCharacter::OnMeleeContacts(AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& WeaponLocation)
 {
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_MeleeContacts);
+	
 	AFighterCharacter* OtherFighter = Cast<AFighterCharacter>(OtherActor);
 	
 	// Terminate when the other actor is myself or not implementation of AFightCharacter.
@@ -67,40 +179,92 @@ void AFighterCharacter::OnMeleeContacts
 		return;	
 	}
 	
+	// Allies and neutral fighters are rejected before any lookup, payload or trace is made
+	if (!IsHostileTo(OtherFighter))
+	{
+		return;
+	}
+	
 	// Prevents "multiple hits" by checking whether the other actor is registered in HitActor container.
 	if (HitActors.Contains(OtherActor))
 	{
 		return;
 	}
 	
+	// Calculates the first hit location by the ray trace result calculated by "my weapon -> opponent's collider center"
+	// Only the opponent's component can be the answer, so trace against it alone instead of the whole scene
+	FHitResult PreciseHit;
+	FCollisionQueryParams QueryParams;
+	
+	COMBAT_COUNT(Traces);
+	OtherComp->LineTraceComponent(
+		PreciseHit, 
+		WeaponLocation,
+		OtherComp->GetComponentLocation(), 
+		QueryParams
+	);
+	
+	SendHitEvent(OtherActor, WeaponComponent->GetWeaponData(), WeaponComponent->GetWeaponBaseDamage(), PreciseHit);
+}
+
+void AFighterCharacter::SendHitEvent(AActor* Target, const UObject* Source, const float Damage, const FHitResult& Hit)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
 	// Payload to contain data that is used in triggering hurt event 
 	FGameplayEventData EventContext;
 	
 	// Fill the context
 	EventContext.Instigator = this;
-	EventContext.Target = OtherActor;
-	EventContext.OptionalObject = GetWeaponActor();
-	EventContext.EventMagnitude = GetWeaponActor()->GetWeaponBaseDamage();
+	EventContext.Target = Target;
+	EventContext.OptionalObject = Source;
+	EventContext.EventMagnitude = Damage;
 	EventContext.ContextHandle = GetAbilitySystemComponent()->MakeEffectContext();
 	
-	// Calculates the first hit location by the ray trace result calculated by "my collider center -> opponent's collider center"
-	FHitResult PreciseHit;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
+	// Store the hit result to event context (this is used by creating Sound Cue and particles)
+	EventContext.ContextHandle.AddHitResult(Hit);
 	
-	GetWorld()->LineTraceSingleByChannel(
-		PreciseHit, 
-		OverlappedComponent->GetComponentLocation(),
-		OtherComp->GetComponentLocation(), 
-		ECC_Pawn,
-		QueryParams
-	);
+	// The defender resolves guards against the moment the hit landed, not the moment it is processed
+	EventContext.TargetData.Add(new FCombatTargetData_Timestamp(FCombatTargetData_Timestamp::GetServerTime(GetWorld())));
 	
-	// Store the line tracing result to event context (this is used by creating Sound Cue and particles)
-	EventContext.ContextHandle.AddHitResult(PreciseHit);
+	COMBAT_COUNT(Hits);
+	RECORD_COMBAT_EVENT(this, HitDealt, Target->GetFName());
 	
 	// Trigger GameplayEvent
-	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(OtherActor, GameplayEventTags::Event_Combat_Hit, EventContext);
+	UAbilitySystemBlueprintLibrary::SendGameplayEventToActor(Target, GameplayEventTags::Event_Combat_Hit, EventContext);
+}
+
+#if WITH_EDITOR
+void AFighterCharacter::SetWeaponData(UWeaponDataAsset* InWeaponData)
+{
+	WeaponData = InWeaponData;
+	WeaponActorBlueprint = nullptr;
+}
+#endif
+
+ETeamAttitude::Type AFighterCharacter::GetTeamAttitudeTowards(const AActor& Other) const
+{
+	if (const AFighterCharacter* OtherFighter = Cast<AFighterCharacter>(&Other))
+	{
+		if (IsHostileTo(OtherFighter))
+		{
+			return ETeamAttitude::Hostile;
+		}
+		
+		return OtherFighter->Team == Team ? ETeamAttitude::Friendly : ETeamAttitude::Neutral;
+	}
+	
+	return ETeamAttitude::Neutral;
+}
+
+FMaskFilter AFighterCharacter::GetFriendlyMaskFilter() const
+{
+	return static_cast<FMaskFilter>(~HostileTeamMask & ((1u << TeamMaskFilterBits) - 1));
+}
+
+bool AFighterCharacter::IsHoldingWeapon() const
+{
+	return WeaponComponent->GetWeaponData() != nullptr;
 }
 
 void AFighterCharacter::AddHitActor(TObjectPtr<AActor> Opponent)
@@ -108,12 +272,35 @@ void AFighterCharacter::AddHitActor(TObjectPtr<AActor> Opponent)
 	HitActors.Add(Opponent);
 }
 
+void AFighterCharacter::BeginMeleeSwing()
+{
+	// Simulated proxies take the server's count, the owning client counts ahead of it as its swings are predicted
+	if (HasAuthority() || IsLocallyControlled())
+	{
+		++SwingCount;
+	}
+	
+	ResetMeleeSwing();
+}
+
 void AFighterCharacter::ResetMeleeSwing()
 {
 	// Clear hit actors saved during melee track phase
 	HitActors.Empty();
 }
 
+void AFighterCharacter::OpenGuardWindow(const double StartTime, const float ParryDuration)
+{
+	GuardStartTime = StartTime;
+	GuardEndTime = TNumericLimits<double>::Max();
+	ParryEndTime = StartTime + ParryDuration;
+}
+
+void AFighterCharacter::CloseGuardWindow(const double EndTime)
+{
+	GuardEndTime = FMath::Max(EndTime, GuardStartTime);
+}
+
 void AFighterCharacter::HitStopForTime(const float StopTime)
 {
 	CustomTimeDilation = 0.0F;
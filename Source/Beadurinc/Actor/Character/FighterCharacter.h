@@ -3,14 +3,21 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Actor/WeaponHolderInterface.h"
-#include "Actor/WeaponActor.h"
 #include "AbilitySystemInterface.h"
+#include "GenericTeamAgentInterface.h"
+#include "Combat/CombatTeamSettings.h"
+#include "Combat/Debug/CombatTimeline.h"
 #include "FighterCharacter.generated.h"
 
 class UAbilitySystemComponent;
 class UAttributeSet;
+class UFighterAbilitySet;
 class UGameplayEffect;
 class UMotionWarpingComponent;
+class UStateWindowComponent;
+class AWeaponActor;
+class UWeaponComponent;
+class UWeaponDataAsset;
 
 /// Characters can attack, be hurt, die as results of interactions by WeaponActor
 /// in their hand socket belongs to their skeleton.
@@ -18,16 +25,27 @@ class UMotionWarpingComponent;
 /// Stats are managed by AttributeSet which means their modification is conducted
 /// by GameplayEffect based on attack damage attribute.
 UCLASS(abstract)
-class BEADURINC_API AFighterCharacter : public ACharacter, public IAbilitySystemInterface, public IWeaponHolderInterface
+class BEADURINC_API AFighterCharacter : public ACharacter, public IAbilitySystemInterface, public IWeaponHolderInterface, public IGenericTeamAgentInterface
 {
 	GENERATED_BODY()
 	
-	/** Holding weapon class */
+	/** Weapon held in the main hand */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Equipments", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UWeaponDataAsset> WeaponData;
+	
+	/** Legacy weapon actor class, held as weapon data read from it when WeaponData is unset */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Equipments", meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<AWeaponActor> WeaponActorBlueprint;
 	
 protected:
 	
+	/** Team this fighter belongs to. Hostility between teams is defined in UCombatTeamSettings */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Combat")
+	ECombatTeam Team;
+	
+	/** Teams this fighter can hurt, resolved from the hostility matrix on BeginPlay */
+	uint32 HostileTeamMask;
+	
 	/** Gameplay Ability class for Hit React */
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Abilities")
 	TSubclassOf<UGameplayAbility> HitReactAbility;
@@ -36,6 +54,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
 	TObjectPtr<UMotionWarpingComponent> MotionWarpingComponent;
 	
+	/** Mesh and melee trace of the held weapon, attached to the hand socket */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	TObjectPtr<UWeaponComponent> WeaponComponent;
+	
+	/** Holds state tags opened by the state windows of playing montages */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components")
+	TObjectPtr<UStateWindowComponent> StateWindowComponent;
+	
 	/** Gameplay Ability System Component */
 	UPROPERTY()
 	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
@@ -44,13 +70,34 @@ protected:
 	UPROPERTY()
 	TObjectPtr<UAttributeSet> AttributeSet;
 	
-	/** Instance holder generated by WeaponActorBlueprint */
-	UPROPERTY()
-	TObjectPtr<AWeaponActor> WeaponActorInstance;
-	
 	/** List of Actors that hit by "current swing" */
 	TSet<TObjectPtr<AActor>> HitActors;
 	
+	/** Server time the latest guard was raised at */
+	double GuardStartTime;
+	
+	/** Server time the latest guard was lowered at. Infinite while still guarding */
+	double GuardEndTime;
+	
+	/** Server time the parry window of the latest guard closes at */
+	double ParryEndTime;
+	
+	/** Identifies this fighter in combat rolls. Assigned by the server, so it is the same on every machine */
+	UPROPERTY(Replicated)
+	uint32 CombatId;
+	
+	/** Melee swings started by this fighter. Counted by the server and the owning client, and replicated to every other machine */
+	UPROPERTY(Replicated)
+	uint32 SwingCount;
+	
+#if WITH_COMBAT_TIMELINE
+	/** Recent combat events of this fighter, read by the gameplay debugger and Combat.DumpTimeline */
+	FCombatTimeline CombatTimeline;
+	
+	/** Handle of the ability activation callback recording into CombatTimeline */
+	FDelegateHandle AbilityActivatedHandle;
+#endif
+	
 public:
 	
 	/** Constructor */
@@ -60,20 +107,34 @@ protected:
 	/** On character first join the world */
 	virtual void BeginPlay() override;
 	
-	/** Called on the WeaponActor hits any actor when collision activated by anim notify state */
-	UFUNCTION()
-	virtual void OnMeleeContacts
-	(
-		UPrimitiveComponent* OverlappedComponent,
-		AActor* OtherActor,
-		UPrimitiveComponent* OtherComp,
-		int32 OtherBodyIndex,
-		bool bFromSweep,
-		const FHitResult& SweepResult
-	);
+	/** On character removed from the world */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	
+	/** Hands the ASC over to the world's stamina regeneration. Call once attributes are initialized */
+	void RegisterStaminaRegeneration();
+	
+	/** Records ability activations of the ASC into the combat timeline. Call once the ASC is initialized */
+	void BindCombatTimeline();
+	
+	/** Called on the weapon touching any actor while its melee trace is activated by anim notify state */
+	virtual void OnMeleeContacts(AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& WeaponLocation);
 	
 public:
 	
+	/** Sends Event.Combat.Hit to the target on behalf of this fighter, dealt by Source (a weapon or projectile) where Hit landed */
+	void SendHitEvent(AActor* Target, const UObject* Source, const float Damage, const FHitResult& Hit);
+	
+	/** Starts a melee swing: counts it and forgets the actors hit by the previous one */
+	void BeginMeleeSwing();
+	
+	/** Returns the id of this fighter shared by every machine */
+	FORCEINLINE uint32 GetCombatId() const { return CombatId; }
+	
+	/** Returns the number of melee swings this fighter started, the current one included */
+	FORCEINLINE uint32 GetSwingCount() const { return SwingCount; }
+	
 	/** Adds an actor to ignoring entry to avoid hitting same actor twice per swing */
 	void AddHitActor(TObjectPtr<AActor> Opponent);
 	
@@ -83,12 +144,64 @@ public:
 	/** Apply Hit Stop on melee strike */
 	void HitStopForTime(const float StopTime);
 	
+	/** Records a guard raised at StartTime, parrying for its first ParryDuration seconds */
+	void OpenGuardWindow(const double StartTime, const float ParryDuration);
+	
+	/** Records the latest guard lowered at EndTime */
+	void CloseGuardWindow(const double EndTime);
+	
+	/** Returns whether a guard was up at the given server time */
+	FORCEINLINE bool IsGuardingAt(const double Time) const { return Time >= GuardStartTime && Time < GuardEndTime; }
+	
+	/** Returns whether a parry window was open at the given server time */
+	FORCEINLINE bool IsParryingAt(const double Time) const { return Time >= GuardStartTime && Time < FMath::Min(ParryEndTime, GuardEndTime); }
+	
+	/** Returns whether this fighter is allowed to hurt the other one. A single bitmask test */
+	FORCEINLINE bool IsHostileTo(const AFighterCharacter* Other) const { return (HostileTeamMask & UCombatTeamSettings::ToBit(Other->Team)) != 0; }
+	
+	/** Returns the mask of the teams this fighter can hurt */
+	FORCEINLINE uint32 GetHostileTeamMask() const { return HostileTeamMask; }
+	
+	/** Returns the body mask filters of every team this fighter cannot hurt, for its weapon queries to skip */
+	FMaskFilter GetFriendlyMaskFilter() const;
+	
+	/** Returns the team this fighter belongs to */
+	FORCEINLINE ECombatTeam GetTeam() const { return Team; }
+	
+	/** Exposes the team to AI perception and other generic team queries */
+	FORCEINLINE virtual FGenericTeamId GetGenericTeamId() const override { return FGenericTeamId(static_cast<uint8>(Team)); }
+	
+	/** Resolves attitude from the hostility matrix */
+	virtual ETeamAttitude::Type GetTeamAttitudeTowards(const AActor& Other) const override;
+	
+#if WITH_COMBAT_TIMELINE
+	/** Returns the recent combat events of this fighter **/
+	FORCEINLINE FCombatTimeline& GetCombatTimeline() { return CombatTimeline; }
+	FORCEINLINE const FCombatTimeline& GetCombatTimeline() const { return CombatTimeline; }
+#endif
+	
 	/** Returns whether the character is holding weapon in main hand **/
-	FORCEINLINE virtual bool IsHoldingWeapon() const override { return IsValid(WeaponActorInstance); }
+	virtual bool IsHoldingWeapon() const override;
 
-	/** Returns Equipping Weapon Actor in main hand **/
-	FORCEINLINE virtual TObjectPtr<AWeaponActor> GetWeaponActor() const override { return WeaponActorInstance; }
+	/** Returns the weapon in main hand **/
+	FORCEINLINE virtual UWeaponComponent* GetWeapon() const override { return WeaponComponent; }
+	
+	/** Returns the component holding montage state windows **/
+	FORCEINLINE UStateWindowComponent* GetStateWindowComponent() const { return StateWindowComponent; }
 	
 	/** Returns Ability Component object **/
 	FORCEINLINE virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override { return AbilitySystemComponent; };
+	
+	/** Returns the abilities this fighter grants itself, null when they are granted elsewhere **/
+	virtual const UFighterAbilitySet* GetAbilitySet() const { return nullptr; }
+	
+#if WITH_EDITOR
+	/** Returns the weapon data set on this fighter, without reading the legacy weapon actor */
+	FORCEINLINE UWeaponDataAsset* GetEquippedWeaponData() const { return WeaponData; }
+	
+	FORCEINLINE TSubclassOf<AWeaponActor> GetWeaponActorBlueprint() const { return WeaponActorBlueprint; }
+	
+	/** Replaces the legacy weapon actor by weapon data, for fighters migrated by BakeWeaponTrajectories */
+	void SetWeaponData(UWeaponDataAsset* InWeaponData);
+#endif
 };
@@ -13,12 +13,13 @@
 #include "AbilitySystemComponent.h"
 #include "AncientKingCharacter.h"
 #include "AbilitySystem/AbilityId.h"
-#include "EngineUtils.h"
 #include "MotionWarpingComponent.h"
 #include "GameData/BeadurincPlayerState.h"
 
 #include "DrawDebugHelpers.h"
 #include "AbilitySystem/GameplayTag/StateGameplayTags.h"
+#include "Combat/CombatStats.h"
+#include "Combat/LockOn/LockOnComponent.h"
 
 /** Constructor */
 APlayerCharacter::APlayerCharacter()
@@ -54,8 +55,13 @@ APlayerCharacter::APlayerCharacter()
 	FollowCamera = CreateDefaultSubobject<UCameraComponent>(TEXT("FollowCamera"));
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName);
 	FollowCamera->bUsePawnControlRotation = false;
+	
+	// Keep lock-on candidates ready for the camera lock input
+	LockOnComponent = CreateDefaultSubobject<ULockOnComponent>(TEXT("LockOn"));
 
 	bLockingOnCamera = false;
+	
+	Team = ECombatTeam::Player;
 }
 
 // Handle server side respawn
@@ -74,6 +80,13 @@ void APlayerCharacter::PossessedBy(AController* NewController)
 		// Reset stat values to their maximum. Only needs to be called in authorized side
 		// so they automatically be handled by GAS networking.
 		PS->ResetStats();
+		
+		// Regenerate stamina while this character is alive
+		RegisterStaminaRegeneration();
+		
+		// Retry buffered inputs of the listen server's own character
+		BindLockTagEvents();
+		BindCombatTimeline();
 	}
 }
 
@@ -90,6 +103,78 @@ void APlayerCharacter::OnRep_PlayerState()
 		
 		// Set owner as Player State since PlayerCharacter is transient object. (Destroyed on death)
 		AbilitySystemComponent->InitAbilityActorInfo(PS, this);
+		
+		// Retry buffered inputs as soon as the ability locks lift
+		BindLockTagEvents();
+		BindCombatTimeline();
+	}
+}
+
+void APlayerCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindLockTagEvents();
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+void APlayerCharacter::BindLockTagEvents()
+{
+	UnbindLockTagEvents();
+	
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+	
+	// Tags that make an ability refuse activation and get its input buffered
+	const FGameplayTag LockTags[] =
+	{
+		StateGameplayTags::State_ComboLocked,
+		StateGameplayTags::State_BlockingLocked,
+		StateGameplayTags::State_RollingLocked
+	};
+	
+	for (const FGameplayTag& LockTag : LockTags)
+	{
+		const FDelegateHandle Handle = AbilitySystemComponent->RegisterGameplayTagEvent(LockTag, EGameplayTagEventType::NewOrRemoved)
+			.AddUObject(this, &APlayerCharacter::OnLockTagChanged);
+		
+		LockTagEventHandles.Emplace(LockTag, Handle);
+	}
+	
+	LockTagEventSource = AbilitySystemComponent;
+}
+
+void APlayerCharacter::UnbindLockTagEvents()
+{
+	if (UAbilitySystemComponent* ASC = LockTagEventSource.Get())
+	{
+		for (const TPair<FGameplayTag, FDelegateHandle>& EventHandle : LockTagEventHandles)
+		{
+			ASC->UnregisterGameplayTagEvent(EventHandle.Value, EventHandle.Key, EGameplayTagEventType::NewOrRemoved);
+		}
+	}
+	
+	LockTagEventHandles.Reset();
+	LockTagEventSource.Reset();
+}
+
+void APlayerCharacter::OnLockTagChanged(const FGameplayTag LockTag, int32 NewCount)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_InputBuffer);
+	
+	// Only the removal of the last lock of a tag can make a refused ability available
+	if (NewCount > 0 || !IsLocallyControlled() || !HasBufferedInput())
+	{
+		return;
+	}
+	
+	const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromInputID(BufferedInput->InputID);
+	
+	// Keep the input buffered while another lock still refuses it, the next removal retries it
+	if (Spec && Spec->Ability && Spec->Ability->CanActivateAbility(Spec->Handle, AbilitySystemComponent->AbilityActorInfo.Get()))
+	{
+		FlushBufferedInput();
 	}
 }
 
@@ -99,11 +184,11 @@ void APlayerCharacter::Tick(float DeltaSeconds)
 	
 	if (bLockingOnCamera)
 	{
-		// When locking on character no longer valid, unlock the camera
+		// When locking on character no longer valid, or has been out of sight for a while, unlock the camera
 		// Since check for object pointer is conducted in each tick we can ignore
 		// the error message, "Object member 'LockingOnCharacter' can be destroyed
 		// during garbage collection, resulting in a stale pointer"
-		if (!IsValid(LockingOnCharacter))
+		if (!IsValid(LockingOnCharacter) || LockOnComponent->IsLockedTargetLost())
 		{
 			UnlockCamera();
 		}
@@ -149,7 +234,7 @@ void APlayerCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 		// Moving
 		EnhancedInputComponent->BindAction(MoveAction, ETriggerEvent::Triggered, this, &APlayerCharacter::Move);
 		EnhancedInputComponent->BindAction(RunAction, ETriggerEvent::Started, this, &APlayerCharacter::Run);
-		EnhancedInputComponent->BindAction(MouseLookAction, ETriggerEvent::Triggered, this, &APlayerCharacter::Look);
+		EnhancedInputComponent->BindAction(MouseLookAction, ETriggerEvent::Triggered, this, &APlayerCharacter::MouseLook);
 
 		// Looking
 		EnhancedInputComponent->BindAction(LookAction, ETriggerEvent::Triggered, this, &APlayerCharacter::Look);
@@ -197,69 +282,33 @@ void APlayerCharacter::Look(const FInputActionValue& Value)
 	DoLook(LookAxisVector.X, LookAxisVector.Y);
 }
 
-void APlayerCharacter::ToggleCamLock(const FInputActionValue& Value)
+void APlayerCharacter::MouseLook(const FInputActionValue& Value)
 {
-	if (!bLockingOnCamera)
+	// input is a Vector2D of mouse deltas
+	FVector2D LookAxisVector = Value.Get<FVector2D>();
+	
+	// Mouse deltas are no stick deflection, a stroke of the mouse switches the locked target instead of a flick
+	if (bLockingOnCamera && GetController() != nullptr)
 	{
-		// To get a local player's controller, pass 0 to PlayerIndex
-		const APlayerController* PC = Cast<APlayerController>(GetController());
-		
-		if (!PC)
+		if (AFighterCharacter* Target = LockOnComponent->HandleMouseLookInput(LookAxisVector.X))
 		{
-			return;
+			LockCamera(Target);
 		}
-		
-		// Store the viewport size
-		int32 ViewX, ViewY;
-		PC->GetViewportSize(ViewX, ViewY);
-		
-		ACharacter* ClosestActorFromCrosshair = nullptr;
-		double ClosestDistance = 1000000000.0;
-		
-		// Iterates all actors
-		for (TActorIterator<ACharacter> It(GetWorld()); It; ++It)
-		{
-			ACharacter* Character = *It;
-			
-			// Skip the character that is invalid or if it's myself
-			if (!IsValid(Character) || Character == this)
-			{
-				continue;
-			}
-			
-			FVector2D ActorLocationInScreen;
-			
-			// Get a x, y coordinate of an actor in the screen 
-			const bool ConvertSucceeded = PC->ProjectWorldLocationToScreen(
-				Character->GetActorLocation(),
-				ActorLocationInScreen
-			);
-			
-			// A case that the target is not on the screen
-			if (!ConvertSucceeded)
-			{
-				continue;
-			}
-			
-			// Transform the left-top coord system into center-center
-			ActorLocationInScreen.X -= ViewX / 2;
-			ActorLocationInScreen.Y -= ViewY / 2;
-			
-			// Calculates distance
-			const double DistanceFromCrosshair = ActorLocationInScreen.SquaredLength();
-			
-			// Calculate the distance between center of the screen and an actor, if true, memorize the actor and distance
-			if (DistanceFromCrosshair < ClosestDistance)
-			{
-				ClosestActorFromCrosshair = Character;
-				ClosestDistance = DistanceFromCrosshair;
-			}
-		}
-		
-		// If found any nearest target, set locking true
-		if (ClosestActorFromCrosshair != nullptr)
+	}
+	
+	RotateView(LookAxisVector.X, LookAxisVector.Y);
+}
+
+void APlayerCharacter::ToggleCamLock(const FInputActionValue& Value)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_LockOn);
+	
+	if (!bLockingOnCamera)
+	{
+		// Lock on the visible candidate nearest to the crosshair, the list is kept by the lock-on component
+		if (AFighterCharacter* Target = LockOnComponent->FindBestTarget())
 		{
-			LockCamera(ClosestActorFromCrosshair);
+			LockCamera(Target);
 			return;
 		}
 	}
@@ -288,6 +337,23 @@ void APlayerCharacter::DoMove(float Right, float Forward)
 }
 
 void APlayerCharacter::DoLook(float Yaw, float Pitch)
+{
+	if (GetController() != nullptr)
+	{
+		// A flick of the stick switches the locked target to its neighbour on that side
+		if (bLockingOnCamera)
+		{
+			if (AFighterCharacter* Target = LockOnComponent->HandleLookInput(Yaw))
+			{
+				LockCamera(Target);
+			}
+		}
+		
+		RotateView(Yaw, Pitch);
+	}
+}
+
+void APlayerCharacter::RotateView(float Yaw, float Pitch)
 {
 	if (GetController() != nullptr)
 	{
@@ -343,12 +409,18 @@ void APlayerCharacter::ReleaseAbility(int32 InputId)
 /** Buffer an ability input by InputID */
 void APlayerCharacter::BufferInput(int32 InputID)
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_InputBuffer);
+	
 	BufferedInput = {InputID, GetWorld()->GetTimeSeconds()};
+	
+	RECORD_COMBAT_EVENT(this, InputBuffered, NAME_None, InputID);
 }
 
 /** Tryna activate buffered input and flush the buffer */
 void APlayerCharacter::FlushBufferedInput()
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_InputBuffer);
+	
 	// Checks buffered inputs in local client (to avoid unnecessary call)
 	if (IsLocallyControlled() && HasBufferedInput())
 	{
@@ -357,6 +429,8 @@ void APlayerCharacter::FlushBufferedInput()
 		{
 			const int32 InputID = BufferedInput->InputID;
 			
+			RECORD_COMBAT_EVENT(this, InputFlushed, NAME_None, InputID);
+			
 			// On input buffering activation, we do not care about whether it success activating
 			AbilitySystemComponent->AbilityLocalInputPressed(InputID);
 			
@@ -384,6 +458,8 @@ bool APlayerCharacter::HasBufferedInput()
 
 void APlayerCharacter::UpdateCameraLock(float DeltaTime)
 {
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_LockOn);
+	
 	APlayerController* PC = Cast<APlayerController>(GetController());
 	if (!PC) return;
 	
@@ -452,6 +528,7 @@ void APlayerCharacter::LockCamera(ACharacter* Target)
 	
 	bLockingOnCamera = true;
 	LockingOnCharacter = Target;
+	LockOnComponent->SetLockedTarget(Cast<AFighterCharacter>(Target));
 }
 
 void APlayerCharacter::UnlockCamera()
@@ -459,5 +536,6 @@ void APlayerCharacter::UnlockCamera()
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	bLockingOnCamera = false;
 	LockingOnCharacter = nullptr;
+	LockOnComponent->SetLockedTarget(nullptr);
 	MotionWarpingComponent->RemoveWarpTarget(TEXT("AttackTarget"));
 }
@@ -17,6 +17,7 @@
 class USpringArmComponent;
 class UCameraComponent;
 class UInputAction;
+class ULockOnComponent;
 struct FGameplayAbilitySpecHandle;
 struct FInputActionValue;
 
@@ -45,6 +46,10 @@ class APlayerCharacter : public AFighterCharacter
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UCameraComponent* FollowCamera;
 	
+	/** Lock-on candidates and target switching */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	ULockOnComponent* LockOnComponent;
+	
 	/** Jump Input Action */
 	UPROPERTY(EditAnywhere, Category="Input")
 	UInputAction* JumpAction;
@@ -89,11 +94,31 @@ protected:
 	/** On player state replicated in client side */
 	virtual void OnRep_PlayerState() override;
 	
+	/** On character removed from the world */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+private:
+	
+	/** Subscribes to the removal of the lock tags to retry the buffered input as soon as a lock lifts */
+	void BindLockTagEvents();
+	
+	/** Unsubscribes from the lock tags. The ASC lives on the PlayerState and outlives this character */
+	void UnbindLockTagEvents();
+	
+	/** Called when a lock tag is added to or removed from the ASC */
+	void OnLockTagChanged(const FGameplayTag LockTag, int32 NewCount);
+	
 private:
 	
 	/** Used by input buffering system */
 	TOptional<FBufferedInput> BufferedInput;
 	
+	/** Lock tags subscribed by BindLockTagEvents and their delegate handles */
+	TArray<TPair<FGameplayTag, FDelegateHandle>, TInlineAllocator<3>> LockTagEventHandles;
+	
+	/** ASC the lock tag events are bound to */
+	TWeakObjectPtr<UAbilitySystemComponent> LockTagEventSource;
+	
 	/** A character being locked on by the player */
 	TObjectPtr<ACharacter> LockingOnCharacter;
 	
@@ -127,15 +152,15 @@ protected:
 	/** Called for looking input */
 	void Look(const FInputActionValue& Value);
 	
+	/** Called for mouse looking input */
+	void MouseLook(const FInputActionValue& Value);
+	
+	/** Turns the view, slowed down while locked on */
+	void RotateView(float Yaw, float Pitch);
+	
 	/** Called for camera lock input */
 	void ToggleCamLock(const FInputActionValue& Value);
 
-	/** On pressed GAS ability input key */
-	void PressAbility(int32 AbilityID);
-
-	/** On released GAS ability input key */
-	void ReleaseAbility(int32 InputId);
-
 public:
 	
 	/** Handles move inputs from either controls or UI interfaces */
@@ -154,6 +179,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Input")
 	virtual void DoJumpEnd();
 	
+	/** On pressed GAS ability input key. Activates, forwards the press to the active ability, or buffers it */
+	void PressAbility(int32 AbilityID);
+
+	/** On released GAS ability input key */
+	void ReleaseAbility(int32 InputId);
+	
 	/** Buffer an ability input by InputID */
 	virtual void BufferInput(int32 InputID);
 	
@@ -174,6 +205,9 @@ public:
 	/** Returns FollowCamera subobject **/
 	FORCEINLINE UCameraComponent* GetFollowCamera() const { return FollowCamera; }
 	
+	/** Returns LockOnComponent subobject **/
+	FORCEINLINE ULockOnComponent* GetLockOnComponent() const { return LockOnComponent; }
+	
 	/** Updates camera rotation to align a target to crosshair */
 	void UpdateCameraLock(float DeltaTime);
 	
@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Projectile/ProjectileDataAsset.h"
+
+UProjectileDataAsset::UProjectileDataAsset()
+{
+	LaunchSpeed = 4000.0F;
+	GravityScale = 0.5F;
+	Radius = 4.0F;
+	MaxLifetime = 3.0F;
+	BaseDamage = 0.0F;
+	AttackType = ECombatAttackType::Light;
+}
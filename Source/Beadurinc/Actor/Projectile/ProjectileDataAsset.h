@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Combat/CombatAttackSourceInterface.h"
+#include "ProjectileDataAsset.generated.h"
+
+class UStaticMesh;
+
+/**
+ * Everything that defines a ranged projectile: how it flies, what it hits with and how it looks.
+ * Projectiles are not actors, they are simulated by UProjectileSubsystem and only borrow a pooled
+ * actor showing Mesh while in flight.
+ */
+UCLASS(BlueprintType)
+class BEADURINC_API UProjectileDataAsset : public UDataAsset, public ICombatAttackSourceInterface
+{
+	GENERATED_BODY()
+
+	/** Mesh shown while in flight, pointing along the velocity */
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	TObjectPtr<UStaticMesh> Mesh;
+
+	/** Speed at launch in cm/s */
+	UPROPERTY(EditAnywhere, Category = "Flight", meta = (ClampMin = "0.0", Units = "CentimetersPerSecond"))
+	float LaunchSpeed;
+
+	/** Multiplier of the world gravity, zero flies straight */
+	UPROPERTY(EditAnywhere, Category = "Flight")
+	float GravityScale;
+
+	/** Radius of the sphere swept along the flight */
+	UPROPERTY(EditAnywhere, Category = "Flight", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float Radius;
+
+	/** Seconds in flight before the projectile is dropped without hitting anything */
+	UPROPERTY(EditAnywhere, Category = "Flight", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float MaxLifetime;
+
+	/** Damage attribute provided to the instigator */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float BaseDamage;
+
+	/** Row of the combat resolution table hits of this projectile are resolved with */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	ECombatAttackType AttackType;
+
+public:
+
+	UProjectileDataAsset();
+
+	FORCEINLINE UStaticMesh* GetMesh() const { return Mesh; }
+
+	FORCEINLINE float GetLaunchSpeed() const { return LaunchSpeed; }
+
+	FORCEINLINE float GetGravityScale() const { return GravityScale; }
+
+	FORCEINLINE float GetRadius() const { return Radius; }
+
+	FORCEINLINE float GetMaxLifetime() const { return MaxLifetime; }
+
+	FORCEINLINE float GetBaseDamage() const { return BaseDamage; }
+
+	FORCEINLINE virtual ECombatAttackType GetAttackType() const override { return AttackType; }
+};
@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Projectile/ProjectileSubsystem.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Actor/Projectile/ProjectileDataAsset.h"
+#include "Actor/Projectile/ProjectileVisualActor.h"
+#include "Engine/World.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+bool UProjectileSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UProjectileSubsystem::Deinitialize()
+{
+	// The world destroys the pooled actors along with itself
+	for (int32 Index = Positions.Num() - 1; Index >= 0; --Index)
+	{
+		RemoveAt(Index);
+	}
+
+	VisualPool.Empty();
+	FreeVisuals.Empty();
+
+	Super::Deinitialize();
+}
+
+void UProjectileSubsystem::Launch(AFighterCharacter* Instigator, const UProjectileDataAsset* ProjectileData, const FVector& Location, const FVector& Direction)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+
+	if (!Instigator || !ProjectileData)
+	{
+		return;
+	}
+
+	const int32 Index = Positions.Add(Location);
+	Velocities.Add(Direction.GetSafeNormal() * ProjectileData->GetLaunchSpeed());
+	GravityScales.Add(ProjectileData->GetGravityScale());
+	Radii.Add(ProjectileData->GetRadius());
+	Lifetimes.Add(ProjectileData->GetMaxLifetime());
+	SweepHandles.AddDefaulted();
+	VisualIndices.Add(INDEX_NONE);
+	Instigators.Add(Instigator);
+	Data.Add(ProjectileData);
+
+	AcquireVisual(Index);
+}
+
+void UProjectileSubsystem::Tick(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_Projectiles);
+
+	Super::Tick(DeltaTime);
+
+	const int32 NumBeforeHits = Positions.Num();
+
+	if (NumBeforeHits == 0)
+	{
+		return;
+	}
+
+	// Iterate backward since finished slots are swapped out while iterating
+	for (int32 Index = NumBeforeHits - 1; Index >= 0; --Index)
+	{
+		if (ResolveSweep(Index) || Lifetimes[Index] <= 0.0F)
+		{
+			RemoveAt(Index);
+		}
+	}
+
+	const int32 Num = Positions.Num();
+
+	if (Num == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+
+	// Positions at the start of the frame, where this frame's sweeps start from
+	TArray<FVector, TInlineAllocator<64>> PreviousPositions(Positions);
+
+	FVector* RESTRICT PositionData = Positions.GetData();
+	FVector* RESTRICT VelocityData = Velocities.GetData();
+	float* RESTRICT LifetimeData = Lifetimes.GetData();
+	const float* RESTRICT GravityData = GravityScales.GetData();
+	const float GravityStep = World->GetGravityZ() * DeltaTime;
+
+	// Branch-free over contiguous data so the compiler can vectorize the whole pass
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		VelocityData[Index].Z += GravityStep * GravityData[Index];
+		PositionData[Index] += VelocityData[Index] * DeltaTime;
+		LifetimeData[Index] -= DeltaTime;
+	}
+
+	// Bodies, walls and the ground stop projectiles alike. Sweeps of every projectile run together on the async trace task
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+	ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const AFighterCharacter* Instigator = Instigators[Index].Get();
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ProjectileSweep), false, Instigator);
+
+		// Bodies of teams the instigator cannot hurt are skipped by the physics query itself
+		if (Instigator)
+		{
+			QueryParams.IgnoreMask = Instigator->GetFriendlyMaskFilter();
+		}
+
+		COMBAT_COUNT(Traces);
+		SweepHandles[Index] = World->AsyncSweepByObjectType(
+			EAsyncTraceType::Single,
+			PreviousPositions[Index],
+			PositionData[Index],
+			FQuat::Identity,
+			ObjectParams,
+			FCollisionShape::MakeSphere(Radii[Index]),
+			QueryParams
+		);
+	}
+
+	// Move the shown projectiles last, so they are drawn where they are
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		if (VisualIndices[Index] != INDEX_NONE)
+		{
+			VisualPool[VisualIndices[Index]]->SetActorLocationAndRotation(PositionData[Index], VelocityData[Index].Rotation());
+		}
+	}
+}
+
+TStatId UProjectileSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_Combat_Projectiles);
+}
+
+bool UProjectileSubsystem::ResolveSweep(int32 Index)
+{
+	FTraceDatum Sweep;
+
+	// Slots launched this frame have not swept yet
+	if (!SweepHandles[Index].IsValid() || !GetWorld()->QueryTraceData(SweepHandles[Index], Sweep))
+	{
+		return false;
+	}
+
+	if (Sweep.OutHits.IsEmpty() || !Sweep.OutHits[0].bBlockingHit)
+	{
+		return false;
+	}
+
+	const FHitResult& Hit = Sweep.OutHits[0];
+	AFighterCharacter* Instigator = Instigators[Index].Get();
+	AFighterCharacter* Target = Cast<AFighterCharacter>(Hit.GetActor());
+
+	// Anything else stops the projectile without harm, including fighters the instigator cannot hurt
+	if (Instigator && Target && Target != Instigator && Instigator->IsHostileTo(Target))
+	{
+		Instigator->SendHitEvent(Target, Data[Index], Data[Index]->GetBaseDamage(), Hit);
+	}
+
+	return true;
+}
+
+void UProjectileSubsystem::AcquireVisual(int32 Index)
+{
+	UWorld* World = GetWorld();
+
+	if (World->GetNetMode() == NM_DedicatedServer || !Data[Index]->GetMesh())
+	{
+		return;
+	}
+
+	if (FreeVisuals.IsEmpty())
+	{
+		if (VisualPool.Num() >= MaxVisualActors)
+		{
+			return;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transient;
+
+		COMBAT_COUNT(Spawns);
+		AProjectileVisualActor* Visual = World->SpawnActor<AProjectileVisualActor>(Positions[Index], Velocities[Index].Rotation(), SpawnParams);
+
+		if (!Visual)
+		{
+			return;
+		}
+
+		FreeVisuals.Add(VisualPool.Add(Visual));
+	}
+
+	const int32 VisualIndex = FreeVisuals.Pop(EAllowShrinking::No);
+	AProjectileVisualActor* Visual = VisualPool[VisualIndex];
+
+	Visual->SetActorLocationAndRotation(Positions[Index], Velocities[Index].Rotation());
+	Visual->Show(Data[Index]->GetMesh());
+	VisualIndices[Index] = VisualIndex;
+}
+
+void UProjectileSubsystem::RemoveAt(int32 Index)
+{
+	// Hand the shown actor back to the pool
+	if (VisualIndices[Index] != INDEX_NONE)
+	{
+		if (AProjectileVisualActor* Visual = VisualPool[VisualIndices[Index]])
+		{
+			Visual->Show(nullptr);
+		}
+
+		FreeVisuals.Add(VisualIndices[Index]);
+	}
+
+	Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+	Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+	GravityScales.RemoveAtSwap(Index, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, EAllowShrinking::No);
+	Lifetimes.RemoveAtSwap(Index, EAllowShrinking::No);
+	SweepHandles.RemoveAtSwap(Index, EAllowShrinking::No);
+	VisualIndices.RemoveAtSwap(Index, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, EAllowShrinking::No);
+	Data.RemoveAtSwap(Index, EAllowShrinking::No);
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "ProjectileSubsystem.generated.h"
+
+class AFighterCharacter;
+class AProjectileVisualActor;
+class UProjectileDataAsset;
+
+/**
+ * Flies every ranged projectile of the world in a single pass.
+ *
+ * Projectiles are not actors. Their state lives in flat arrays (one slot per projectile) that
+ * are integrated together on tick. Collision is one async sphere sweep per projectile from its
+ * previous to its current position, all issued together and read back the next frame, so the
+ * physics scene is queried in one batch off the game thread. A hit is reported to the target as
+ * Event.Combat.Hit by the instigator, the same event melee contacts send.
+ *
+ * Rendering borrows actors from a small pool, so projectiles in flight beyond the pool size are
+ * simulated but not shown. Dedicated servers never show projectiles.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UProjectileSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+	/** Most pooled actors showing projectiles at once */
+	UPROPERTY(Config)
+	int32 MaxVisualActors = 64;
+
+public:
+
+	/** Fires a projectile from Location toward Direction on behalf of the instigator */
+	void Launch(AFighterCharacter* Instigator, const UProjectileDataAsset* ProjectileData, const FVector& Location, const FVector& Direction);
+
+	/** Returns the number of projectiles in flight */
+	FORCEINLINE int32 GetNumInFlight() const { return Positions.Num(); }
+
+protected:
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+private:
+
+	/** Reads back the sweeps issued last frame and reports their hits. Returns whether the slot hit anything */
+	bool ResolveSweep(int32 Index);
+
+	/** Takes a pooled actor to show a slot, if any is left */
+	void AcquireVisual(int32 Index);
+
+	/** Removes a slot by swapping the last one into its place */
+	void RemoveAt(int32 Index);
+
+private:
+
+	// Structure of arrays, one element per projectile in flight. Kept in sync by Launch/RemoveAt.
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> GravityScales;
+	TArray<float> Radii;
+	TArray<float> Lifetimes;
+	TArray<FTraceHandle> SweepHandles;
+	TArray<int32> VisualIndices;
+	TArray<TWeakObjectPtr<AFighterCharacter>> Instigators;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UProjectileDataAsset>> Data;
+
+	/** Every visual actor spawned so far */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AProjectileVisualActor>> VisualPool;
+
+	/** Indices of VisualPool not showing any projectile */
+	TArray<int32> FreeVisuals;
+};
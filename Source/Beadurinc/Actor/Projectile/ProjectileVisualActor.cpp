@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Projectile/ProjectileVisualActor.h"
+#include "Components/StaticMeshComponent.h"
+
+AProjectileVisualActor::AProjectileVisualActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetReplicates(false);
+	SetCanBeDamaged(false);
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	MeshComponent->SetCanEverAffectNavigation(false);
+	MeshComponent->SetCastShadow(false);
+	MeshComponent->SetMobility(EComponentMobility::Movable);
+	SetRootComponent(MeshComponent);
+
+	SetActorHiddenInGame(true);
+}
+
+void AProjectileVisualActor::Show(UStaticMesh* Mesh)
+{
+	MeshComponent->SetStaticMesh(Mesh);
+	SetActorHiddenInGame(Mesh == nullptr);
+}
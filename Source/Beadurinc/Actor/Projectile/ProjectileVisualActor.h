@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "ProjectileVisualActor.generated.h"
+
+class UStaticMeshComponent;
+
+/**
+ * Shows one in-flight projectile. Owned by UProjectileSubsystem, which moves it every frame and
+ * lends it to the next projectile once the current one is gone. Never ticks, collides or replicates.
+ */
+UCLASS(NotBlueprintable, Transient)
+class BEADURINC_API AProjectileVisualActor : public AActor
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = "Components")
+	TObjectPtr<UStaticMeshComponent> MeshComponent;
+
+public:
+
+	AProjectileVisualActor();
+
+	/** Shows the given mesh, or hides the actor when null */
+	void Show(UStaticMesh* Mesh);
+
+	FORCEINLINE UStaticMeshComponent* GetMeshComponent() const { return MeshComponent; }
+};
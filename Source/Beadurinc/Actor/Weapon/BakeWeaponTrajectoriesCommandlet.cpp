@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Weapon/BakeWeaponTrajectoriesCommandlet.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Actor/Weapon/WeaponDataAsset.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/Skeleton.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Beadurinc.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/Blueprint.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+#if WITH_EDITOR
+#include "Kismet2/BlueprintEditorUtils.h"
+#endif
+
+UBakeWeaponTrajectoriesCommandlet::UBakeWeaponTrajectoriesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBakeWeaponTrajectoriesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Path = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), Path);
+	
+	float SampleRate = 60.0F;
+	FParse::Value(*Params, TEXT("SampleRate="), SampleRate);
+	
+	FString MeshPath;
+	USkeletalMesh* OverrideMesh = FParse::Value(*Params, TEXT("Mesh="), MeshPath) ? LoadObject<USkeletalMesh>(nullptr, *MeshPath) : nullptr;
+	
+	if (!MeshPath.IsEmpty() && !OverrideMesh)
+	{
+		UE_LOG(LogBeadurinc, Error, TEXT("Could not load skeletal mesh %s"), *MeshPath);
+		return 1;
+	}
+	
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+	
+	int32 FailedCount = 0;
+	
+	const auto SaveAsset = [&FailedCount](UObject* Asset)
+	{
+		UPackage* Package = Asset->GetPackage();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		
+		if (UPackage::SavePackage(Package, Asset, *Filename, SaveArgs))
+		{
+			return true;
+		}
+		
+		UE_LOG(LogBeadurinc, Error, TEXT("Could not save %s"), *Filename);
+		++FailedCount;
+		return false;
+	};
+	
+	FARFilter Filter;
+	Filter.PackagePaths.Add(*Path);
+	Filter.ClassPaths.Add(UWeaponDataAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	
+	TArray<UWeaponDataAsset*> Weapons;
+	
+	for (const FAssetData& Asset : Assets)
+	{
+		if (UWeaponDataAsset* WeaponData = Cast<UWeaponDataAsset>(Asset.GetAsset()))
+		{
+			Weapons.AddUnique(WeaponData);
+		}
+	}
+	
+	// Fighters still holding a legacy weapon actor get weapon data saved next to it, which can be baked
+	TSet<FTopLevelAssetPath> FighterClassPaths;
+	AssetRegistry.GetDerivedClassNames({ AFighterCharacter::StaticClass()->GetClassPathName() }, {}, FighterClassPaths);
+	
+	TMap<UClass*, UWeaponDataAsset*> WeaponsFromActors;
+	
+	for (const FTopLevelAssetPath& FighterClassPath : FighterClassPaths)
+	{
+		if (!FighterClassPath.GetPackageName().ToString().StartsWith(Path))
+		{
+			continue;
+		}
+		
+		UClass* FighterClass = LoadObject<UClass>(nullptr, *FighterClassPath.ToString());
+		UBlueprint* FighterBlueprint = FighterClass ? Cast<UBlueprint>(FighterClass->ClassGeneratedBy) : nullptr;
+		AFighterCharacter* Defaults = FighterClass ? FighterClass->GetDefaultObject<AFighterCharacter>() : nullptr;
+		
+		if (!FighterBlueprint || !Defaults || Defaults->GetEquippedWeaponData() || !Defaults->GetWeaponActorBlueprint())
+		{
+			continue;
+		}
+		
+		// A weapon inherited from a parent blueprint is migrated with the parent
+		const AFighterCharacter* ParentDefaults = Cast<AFighterCharacter>(FighterClass->GetSuperClass()->GetDefaultObject());
+		
+		if (ParentDefaults && ParentDefaults->GetWeaponActorBlueprint() == Defaults->GetWeaponActorBlueprint())
+		{
+			continue;
+		}
+		
+		UClass* WeaponActorClass = Defaults->GetWeaponActorBlueprint();
+		UWeaponDataAsset*& WeaponData = WeaponsFromActors.FindOrAdd(WeaponActorClass);
+		
+		if (!WeaponData)
+		{
+			const FString WeaponActorPackageName = WeaponActorClass->GetPackage()->GetName();
+			const FString AssetName = TEXT("DA_") + FPackageName::GetShortName(WeaponActorPackageName);
+			const FString PackageName = FPackageName::GetLongPackagePath(WeaponActorPackageName) / AssetName;
+			
+			WeaponData = LoadObject<UWeaponDataAsset>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet);
+			
+			if (!WeaponData)
+			{
+				UE_LOG(LogBeadurinc, Display, TEXT("Creating %s from %s"), *PackageName, *WeaponActorClass->GetPathName());
+				
+				UPackage* Package = CreatePackage(*PackageName);
+				WeaponData = DuplicateObject<UWeaponDataAsset>(UWeaponDataAsset::GetFromWeaponActor(WeaponActorClass), Package, *AssetName);
+				WeaponData->SetFlags(RF_Public | RF_Standalone);
+				AssetRegistry.AssetCreated(WeaponData);
+				
+				if (!SaveAsset(WeaponData))
+				{
+					continue;
+				}
+			}
+			
+			Weapons.AddUnique(WeaponData);
+		}
+		
+		UE_LOG(LogBeadurinc, Display, TEXT("Pointing %s at %s"), *FighterBlueprint->GetPathName(), *WeaponData->GetPathName());
+		
+		Defaults->Modify();
+		Defaults->SetWeaponData(WeaponData);
+		FBlueprintEditorUtils::MarkBlueprintAsModified(FighterBlueprint);
+		SaveAsset(FighterBlueprint);
+	}
+	
+	// Montages are posed on a mesh component registered to a world of its own
+	UWorld* World = UWorld::CreateWorld(EWorldType::Inactive, false);
+	USkeletalMeshComponent* Mesh = NewObject<USkeletalMeshComponent>(GetTransientPackage());
+	Mesh->RegisterComponentWithWorld(World);
+	
+	int32 BakedCount = 0;
+	
+	for (UWeaponDataAsset* WeaponData : Weapons)
+	{
+		const FString WeaponName = WeaponData->GetPackage()->GetName();
+		TArray<FWeaponTrajectory> Trajectories;
+		
+		for (uint32 Index = 0; Index < WeaponData->GetComboSequenceLength(); ++Index)
+		{
+			UAnimMontage* Montage = WeaponData->GetComboAttackAt(Index);
+			USkeletalMesh* SkeletalMesh = OverrideMesh ? OverrideMesh : (Montage && Montage->GetSkeleton() ? Montage->GetSkeleton()->GetPreviewMesh(true) : nullptr);
+			
+			if (!SkeletalMesh)
+			{
+				UE_LOG(LogBeadurinc, Warning, TEXT("Combo attack %u of %s has no mesh to evaluate it on, pass -Mesh="), Index, *WeaponName);
+				continue;
+			}
+			
+			Mesh->SetSkeletalMeshAsset(SkeletalMesh);
+			
+			FWeaponTrajectory Trajectory = FWeaponTrajectory::Bake(Mesh, Montage, WeaponData->GetAttachSocket(), SampleRate);
+			
+			if (!Trajectory.IsValid())
+			{
+				UE_LOG(LogBeadurinc, Warning, TEXT("Could not bake combo attack %u of %s, is %s a socket of %s?"), Index, *WeaponName, *WeaponData->GetAttachSocket().ToString(), *SkeletalMesh->GetName());
+				continue;
+			}
+			
+			Trajectories.Add(MoveTemp(Trajectory));
+		}
+		
+		if (Trajectories == WeaponData->GetComboTrajectories())
+		{
+			continue;
+		}
+		
+		UE_LOG(LogBeadurinc, Display, TEXT("Baking %d trajectories of %s"), Trajectories.Num(), *WeaponName);
+		
+		WeaponData->Modify();
+		WeaponData->SetComboTrajectories(MoveTemp(Trajectories));
+		
+		if (SaveAsset(WeaponData))
+		{
+			++BakedCount;
+		}
+	}
+	
+	Mesh->UnregisterComponent();
+	World->DestroyWorld(false);
+	
+	UE_LOG(LogBeadurinc, Display, TEXT("%d of %d weapons under %s were baked"), BakedCount, Weapons.Num(), *Path);
+	
+	return FailedCount > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
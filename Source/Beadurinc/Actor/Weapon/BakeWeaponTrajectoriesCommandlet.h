@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeWeaponTrajectoriesCommandlet.generated.h"
+
+/**
+ * Bakes the trajectory of the attach socket through every combo attack of every weapon data asset
+ * under a path, and saves the weapons whose trajectories changed. Montages are evaluated on their
+ * skeleton's preview mesh unless a mesh is given.
+ *
+ * Fighter blueprints under the path that still equip a weapon actor blueprint are first given a
+ * weapon data asset, saved as DA_<weapon actor> next to it, so their weapons can be baked too. Run
+ * before cooking, together with BakeMontageTimelines:
+ *
+ *   UnrealEditor-Cmd Beadurinc.uproject -run=BakeWeaponTrajectories -Path=/Game/Weapons [-Mesh=/Game/Path/To/SkeletalMesh] [-SampleRate=60]
+ */
+UCLASS()
+class BEADURINC_API UBakeWeaponTrajectoriesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	
+	UBakeWeaponTrajectoriesCommandlet();
+	
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Beadurinc.h"
+#include "Combat/CombatCollision.h"
+#include "Combat/CombatStats.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+
+// A fast swing is split into sub-sweeps so the blade's arc is followed rather than cut short
+static constexpr int32 MaxSubSweeps = 4;
+
+namespace WeaponSweeps
+{
+	/** Weapons and montages a missing trajectory was reported for, so each is reported once */
+	static TSet<TObjectKey<UObject>> ReportedMissingTrajectories;
+
+	static bool ShouldReportMissingTrajectory(const UObject* Asset)
+	{
+		bool bAlreadyReported = false;
+		ReportedMissingTrajectories.Add(Asset, &bAlreadyReported);
+		return !bAlreadyReported;
+	}
+}
+
+UWeaponComponent::UWeaponComponent()
+{
+	// Only ticks while a melee trace is active, after the skeleton has been posed
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	// Hits are found by sweeps, the mesh never needs a physics body
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	SetGenerateOverlapEvents(false);
+	SetCanEverAffectNavigation(false);
+	CanCharacterStepUpOn = ECB_No;
+
+	IgnoreMask = 0;
+	TraceTrajectory = nullptr;
+	PosedMeshTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+	bTracing = false;
+	bRecordNextSweep = false;
+	bTraceFromTrajectories = false;
+}
+
+void UWeaponComponent::Equip(const UWeaponDataAsset* InWeaponData)
+{
+	EndTrace();
+
+	WeaponData = InWeaponData;
+
+	if (!WeaponData)
+	{
+		SetStaticMesh(nullptr);
+		return;
+	}
+
+	SetStaticMesh(WeaponData->GetMesh());
+
+	if (USceneComponent* Parent = GetAttachParent())
+	{
+		AttachToComponent(Parent, FAttachmentTransformRules::SnapToTargetNotIncludingScale, WeaponData->GetAttachSocket());
+	}
+
+	SetRelativeTransform(WeaponData->GetAttachOffset());
+}
+
+void UWeaponComponent::SetTraceFromTrajectories(bool bEnable)
+{
+	bTraceFromTrajectories = bEnable && WeaponData && WeaponData->HasAllComboTrajectories();
+
+	if (bEnable && WeaponData && !bTraceFromTrajectories && WeaponSweeps::ShouldReportMissingTrajectory(WeaponData))
+	{
+		UE_LOG(LogBeadurinc, Warning, TEXT("%s lacks baked trajectories, its holders keep posing bones to sweep it. Run BakeWeaponTrajectories"), *WeaponData->GetPathName());
+	}
+}
+
+void UWeaponComponent::BeginTrace()
+{
+	if (!WeaponData)
+	{
+		return;
+	}
+
+	EndTrace();
+
+	bTracing = true;
+
+	if (bTraceFromTrajectories)
+	{
+		USkeletalMeshComponent* Mesh = Cast<USkeletalMeshComponent>(GetAttachParent());
+		const UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+		const UAnimMontage* Montage = AnimInstance ? AnimInstance->GetCurrentActiveMontage() : nullptr;
+
+		TraceTrajectory = WeaponData->FindComboTrajectory(Montage);
+
+		// Montages outside the combo, such as ability attacks, have no trajectory. Their trace poses the mesh instead
+		if (!TraceTrajectory && Mesh)
+		{
+			if (Montage && WeaponSweeps::ShouldReportMissingTrajectory(Montage))
+			{
+				UE_LOG(LogBeadurinc, Warning, TEXT("%s traces %s, which is no combo attack of it and has no trajectory. The holder is posed while it traces"), *WeaponData->GetPathName(), *Montage->GetPathName());
+			}
+
+			PosedMesh = Mesh;
+			PosedMeshTickOption = Mesh->VisibilityBasedAnimTickOption;
+			Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+			// The socket holds a stale pose until the mesh is next evaluated, the first sweep starts from there
+			bRecordNextSweep = true;
+			SetComponentTickEnabled(true);
+			return;
+		}
+	}
+
+	// The first sweep starts from where the weapon is when the trace begins
+	SweepShapes(true);
+	SetComponentTickEnabled(true);
+}
+
+void UWeaponComponent::EndTrace()
+{
+	if (USkeletalMeshComponent* Mesh = PosedMesh.Get())
+	{
+		Mesh->VisibilityBasedAnimTickOption = PosedMeshTickOption;
+	}
+
+	PosedMesh.Reset();
+	bTracing = false;
+	bRecordNextSweep = false;
+	TraceTrajectory = nullptr;
+	SetComponentTickEnabled(false);
+}
+
+void UWeaponComponent::ReportContact(AActor* OtherActor, UPrimitiveComponent* OtherComp)
+{
+	OnWeaponContact.Broadcast(OtherActor, OtherComp, GetComponentLocation());
+}
+
+void UWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bTracing)
+	{
+		SweepShapes(bRecordNextSweep);
+		bRecordNextSweep = false;
+	}
+}
+
+void UWeaponComponent::SweepShapes(bool bRecordOnly)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_WeaponSweeps);
+
+	const TArray<FWeaponTraceShape>& Shapes = WeaponData->GetTraceShapes();
+	FTransform WeaponTransform;
+
+	if (!GetTraceTransform(WeaponTransform))
+	{
+		return;
+	}
+
+	if (bRecordOnly || PreviousShapeEnds.Num() != Shapes.Num())
+	{
+		PreviousShapeEnds.SetNum(Shapes.Num());
+
+		for (int32 Index = 0; Index < Shapes.Num(); ++Index)
+		{
+			PreviousShapeEnds[Index] = { WeaponTransform.TransformPosition(Shapes[Index].Start), WeaponTransform.TransformPosition(Shapes[Index].End) };
+		}
+
+		return;
+	}
+
+	UWorld* World = GetWorld();
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponTrace), false, GetOwner());
+	QueryParams.IgnoreMask = IgnoreMask;
+
+	// A body touched by several shapes or sub-sweeps is reported once
+	TArray<AActor*, TInlineAllocator<4>> ContactedActors;
+	TArray<FHitResult> Hits;
+
+	for (int32 Index = 0; Index < Shapes.Num(); ++Index)
+	{
+		const FWeaponTraceShape& Shape = Shapes[Index];
+		const FVector Start = WeaponTransform.TransformPosition(Shape.Start);
+		const FVector End = WeaponTransform.TransformPosition(Shape.End);
+		const TPair<FVector, FVector> Previous = PreviousShapeEnds[Index];
+
+		PreviousShapeEnds[Index] = { Start, End };
+
+		const float Travel = FMath::Max(FVector::Dist(Previous.Key, Start), FVector::Dist(Previous.Value, End));
+		const int32 SubSweeps = FMath::Clamp(FMath::CeilToInt32(Travel / FMath::Max(Shape.Radius * 2.0F, 1.0F)), 1, MaxSubSweeps);
+
+		FVector SweepFrom = (Previous.Key + Previous.Value) * 0.5;
+
+		for (int32 Step = 1; Step <= SubSweeps; ++Step)
+		{
+			const float Alpha = static_cast<float>(Step) / SubSweeps;
+			const FVector StepStart = FMath::Lerp(Previous.Key, Start, Alpha);
+			const FVector StepEnd = FMath::Lerp(Previous.Value, End, Alpha);
+			const FVector Axis = StepEnd - StepStart;
+			const FVector SweepTo = (StepStart + StepEnd) * 0.5;
+
+			const FCollisionShape Capsule = FCollisionShape::MakeCapsule(Shape.Radius, Axis.Size() * 0.5F + Shape.Radius);
+			const FQuat Rotation = Axis.IsNearlyZero() ? FQuat::Identity : FRotationMatrix::MakeFromZ(Axis).ToQuat();
+
+			COMBAT_COUNT(Traces);
+			Hits.Reset();
+			World->SweepMultiByChannel(Hits, SweepFrom, SweepTo, Rotation, ECC_WeaponTrace, Capsule, QueryParams);
+
+			for (const FHitResult& Hit : Hits)
+			{
+				AActor* HitActor = Hit.GetActor();
+
+				if (!HitActor || ContactedActors.Contains(HitActor))
+				{
+					continue;
+				}
+
+				ContactedActors.Add(HitActor);
+				OnWeaponContact.Broadcast(HitActor, Hit.GetComponent(), SweepTo);
+			}
+
+			SweepFrom = SweepTo;
+		}
+	}
+}
+
+bool UWeaponComponent::GetTraceTransform(FTransform& OutTransform) const
+{
+	if (!TraceTrajectory)
+	{
+		// The posed weapon, whether the mesh always poses or was made to for this trace
+		OutTransform = GetComponentTransform();
+		return true;
+	}
+
+	const USkeletalMeshComponent* Mesh = Cast<USkeletalMeshComponent>(GetAttachParent());
+	const UAnimInstance* AnimInstance = Mesh ? Mesh->GetAnimInstance() : nullptr;
+
+	// The socket was never posed, so there is nothing to fall back to once the traced montage is gone
+	if (!AnimInstance || !AnimInstance->Montage_IsPlaying(TraceTrajectory->Montage))
+	{
+		return false;
+	}
+
+	// Weapon relative to the socket, the socket relative to the mesh, the mesh in the world
+	const FTransform SocketTransform = TraceTrajectory->Evaluate(AnimInstance->Montage_GetPosition(TraceTrajectory->Montage));
+	OutTransform = WeaponData->GetAttachOffset() * SocketTransform * Mesh->GetComponentTransform();
+	return true;
+}
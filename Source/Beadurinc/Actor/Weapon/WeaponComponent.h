@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StaticMeshComponent.h"
+#include "Actor/Weapon/WeaponDataAsset.h"
+#include "WeaponComponent.generated.h"
+
+class USkeletalMeshComponent;
+enum class EVisibilityBasedAnimTickOption : uint8;
+
+/** Reports a body the weapon's trace touched, along with where the weapon was */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FWeaponContactSignature, AActor* /* OtherActor */, UPrimitiveComponent* /* OtherComp */, const FVector& /* WeaponLocation */);
+
+/**
+ * A weapon held by its owner: the weapon's mesh attached to a socket of the owner's skeleton.
+ *
+ * Has no collision of its own. While a melee trace is active it sweeps the weapon's trace shapes
+ * from where they were last frame to where they are now on the weapon trace channel, so fast
+ * swings cannot skip a body between frames, and reports every body found through OnWeaponContact.
+ * Ticks only while tracing.
+ *
+ * Where the owner's mesh does not pose bones, as on dedicated servers, the weapon's transform is
+ * rebuilt from the baked trajectory of the combo attack playing and the mesh's transform instead.
+ */
+UCLASS(ClassGroup = (Beadurinc), meta = (BlueprintSpawnableComponent))
+class BEADURINC_API UWeaponComponent : public UStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UWeaponComponent();
+
+	/** Holds a weapon: shows its mesh on its socket of the parent mesh. Null puts the weapon away */
+	void Equip(const UWeaponDataAsset* InWeaponData);
+
+	/** Starts sweeping the trace shapes every frame */
+	void BeginTrace();
+
+	/** Stops sweeping the trace shapes */
+	void EndTrace();
+
+	/** Reports a contact as if a sweep had found it */
+	void ReportContact(AActor* OtherActor, UPrimitiveComponent* OtherComp);
+
+	/**
+	 * Sweeps from baked combo trajectories instead of the posed weapon, for meshes that do not evaluate
+	 * animation. Stays off, with a warning, while the held weapon lacks a trajectory for a combo attack.
+	 * Traces of montages outside the combo pose the mesh for as long as they last.
+	 */
+	void SetTraceFromTrajectories(bool bEnable);
+
+	/** Sets the body mask filters sweeps skip, so bodies of friendly teams are never reported */
+	FORCEINLINE void SetIgnoreMask(FMaskFilter InIgnoreMask) { IgnoreMask = InIgnoreMask; }
+
+	/** Returns the data of the held weapon, null when none is held */
+	FORCEINLINE const UWeaponDataAsset* GetWeaponData() const { return WeaponData; }
+
+	FORCEINLINE bool IsTracing() const { return bTracing; }
+
+	/** Returns a combo attack montage of the held weapon for given index */
+	FORCEINLINE UAnimMontage* GetComboAttackAt(uint32 Index) const { return WeaponData ? WeaponData->GetComboAttackAt(Index) : nullptr; }
+
+	FORCEINLINE uint32 GetComboSequenceLength() const { return WeaponData ? WeaponData->GetComboSequenceLength() : 0; }
+
+	FORCEINLINE float GetWeaponBaseDamage() const { return WeaponData ? WeaponData->GetWeaponBaseDamage() : 0.0F; }
+
+	FORCEINLINE ECombatAttackType GetAttackType() const { return WeaponData ? WeaponData->GetAttackType() : ECombatAttackType::Light; }
+
+	/** Called for every body a sweep touches, once per sweep */
+	FWeaponContactSignature OnWeaponContact;
+
+protected:
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+
+	/** Sweeps every trace shape from its previous to its current position. With bRecordOnly, only records the positions */
+	void SweepShapes(bool bRecordOnly);
+
+	/**
+	 * Gets the weapon's world transform for sweeping, from the trajectory of the montage being traced if
+	 * there is one. Returns false once that montage stopped, as the trajectory no longer says where the weapon is.
+	 */
+	bool GetTraceTransform(FTransform& OutTransform) const;
+
+private:
+
+	/** Data of the held weapon */
+	UPROPERTY()
+	TObjectPtr<const UWeaponDataAsset> WeaponData;
+
+	/** World positions of each trace shape's ends at the previous sweep */
+	TArray<TPair<FVector, FVector>, TInlineAllocator<2>> PreviousShapeEnds;
+
+	/** Body mask filters sweeps skip */
+	FMaskFilter IgnoreMask;
+
+	/** Baked trajectory of the montage the current trace began in, owned by WeaponData */
+	const FWeaponTrajectory* TraceTrajectory;
+
+	/** Mesh posed for a trace without a trajectory, and the tick option it is given back at the end of the trace */
+	TWeakObjectPtr<USkeletalMeshComponent> PosedMesh;
+
+	EVisibilityBasedAnimTickOption PosedMeshTickOption;
+
+	bool bTracing;
+
+	/** Set while the first sweep waits for the mesh to be posed */
+	bool bRecordNextSweep;
+
+	bool bTraceFromTrajectories;
+};
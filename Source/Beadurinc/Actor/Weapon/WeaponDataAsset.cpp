@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Weapon/WeaponDataAsset.h"
+#include "Actor/WeaponActor.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Engine/SCS_Node.h"
+#include "Engine/SimpleConstructionScript.h"
+#include "UObject/Package.h"
+#include "Combat/Debug/CombatMemory.h"
+
+namespace WeaponDataAsset
+{
+	/** Weapon data built from weapon actor classes. Kept alive by the fighters holding it */
+	static TMap<TObjectKey<UClass>, TWeakObjectPtr<UWeaponDataAsset>> DataFromWeaponActors;
+
+	/**
+	 * Finds the first component template of a type in an actor class, native or blueprint added,
+	 * and returns its transform relative to the actor's root. The root itself sits on the socket.
+	 */
+	template<typename ComponentType>
+	static const ComponentType* FindComponentTemplate(const UClass* ActorClass, FTransform& OutRootTransform)
+	{
+		OutRootTransform = FTransform::Identity;
+
+		const AActor* Defaults = ActorClass->GetDefaultObject<AActor>();
+
+		if (const ComponentType* Native = Defaults->FindComponentByClass<ComponentType>())
+		{
+			if (Native != Defaults->GetRootComponent())
+			{
+				OutRootTransform = Native->GetRelativeTransform();
+			}
+
+			return Native;
+		}
+
+		for (const UBlueprintGeneratedClass* Class = Cast<UBlueprintGeneratedClass>(ActorClass); Class; Class = Cast<UBlueprintGeneratedClass>(Class->GetSuperClass()))
+		{
+			if (!Class->SimpleConstructionScript)
+			{
+				continue;
+			}
+
+			// Weapon blueprints keep their components directly under the root
+			for (const USCS_Node* Node : Class->SimpleConstructionScript->GetAllNodes())
+			{
+				if (const ComponentType* Template = Cast<ComponentType>(Node->ComponentTemplate))
+				{
+					if (!Class->SimpleConstructionScript->GetRootNodes().Contains(Node))
+					{
+						OutRootTransform = Template->GetRelativeTransform();
+					}
+
+					return Template;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+}
+
+UWeaponDataAsset::UWeaponDataAsset()
+{
+	AttachSocket = TEXT("Weapon_Socket");
+	BaseDamage = 0.0F;
+	AttackType = ECombatAttackType::Light;
+}
+
+UAnimMontage* UWeaponDataAsset::GetComboAttackAt(uint32 Index) const
+{
+	return Index < GetComboSequenceLength() ? ComboAttacks[Index].Get() : nullptr;
+}
+
+const FWeaponTrajectory* UWeaponDataAsset::FindComboTrajectory(const UAnimMontage* Montage) const
+{
+	return Montage ? ComboTrajectories.FindByPredicate([Montage](const FWeaponTrajectory& Trajectory)
+	{
+		return Trajectory.Montage == Montage && Trajectory.IsValid();
+	}) : nullptr;
+}
+
+bool UWeaponDataAsset::HasAllComboTrajectories() const
+{
+	if (ComboAttacks.IsEmpty())
+	{
+		return false;
+	}
+
+	for (const UAnimMontage* Montage : ComboAttacks)
+	{
+		if (!FindComboTrajectory(Montage))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+UWeaponDataAsset* UWeaponDataAsset::GetFromWeaponActor(TSubclassOf<AWeaponActor> WeaponActorClass)
+{
+	if (!WeaponActorClass)
+	{
+		return nullptr;
+	}
+
+	TWeakObjectPtr<UWeaponDataAsset>& Cached = WeaponDataAsset::DataFromWeaponActors.FindOrAdd(WeaponActorClass.Get());
+
+	if (UWeaponDataAsset* Data = Cached.Get())
+	{
+		return Data;
+	}
+
+	LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+
+	const AWeaponActor* Defaults = WeaponActorClass->GetDefaultObject<AWeaponActor>();
+	UWeaponDataAsset* Data = NewObject<UWeaponDataAsset>(GetTransientPackage(), MakeUniqueObjectName(GetTransientPackage(), StaticClass(), WeaponActorClass->GetFName()));
+
+	Data->ComboAttacks = Defaults->GetComboAttacks();
+	Data->BaseDamage = Defaults->GetWeaponBaseDamage();
+	Data->AttackType = Defaults->GetAttackType();
+
+	FTransform MeshToRoot;
+
+	if (const UStaticMeshComponent* MeshTemplate = WeaponDataAsset::FindComponentTemplate<UStaticMeshComponent>(WeaponActorClass, MeshToRoot))
+	{
+		Data->Mesh = MeshTemplate->GetStaticMesh();
+		Data->AttachOffset = MeshToRoot;
+	}
+
+	FTransform CapsuleToRoot;
+
+	if (const UCapsuleComponent* CapsuleTemplate = WeaponDataAsset::FindComponentTemplate<UCapsuleComponent>(WeaponActorClass, CapsuleToRoot))
+	{
+		// The collider becomes a swept capsule in the mesh's space
+		const FTransform CapsuleToMesh = CapsuleToRoot.GetRelativeTransform(MeshToRoot);
+		const float HalfSegment = FMath::Max(CapsuleTemplate->GetUnscaledCapsuleHalfHeight() - CapsuleTemplate->GetUnscaledCapsuleRadius(), 0.0F);
+
+		FWeaponTraceShape& Shape = Data->TraceShapes.AddDefaulted_GetRef();
+		Shape.Start = CapsuleToMesh.TransformPosition(FVector(0.0, 0.0, -HalfSegment));
+		Shape.End = CapsuleToMesh.TransformPosition(FVector(0.0, 0.0, HalfSegment));
+		Shape.Radius = CapsuleTemplate->GetUnscaledCapsuleRadius() * CapsuleToMesh.GetMinimumAxisScale();
+	}
+
+	Cached = Data;
+	return Data;
+}
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Combat/CombatAttackSourceInterface.h"
+#include "Actor/Weapon/WeaponTrajectory.h"
+#include "WeaponDataAsset.generated.h"
+
+class AWeaponActor;
+class UAnimMontage;
+class UStaticMesh;
+
+/** A capsule swept by a weapon while its melee trace is active, in the weapon mesh's space */
+USTRUCT(BlueprintType)
+struct FWeaponTraceShape
+{
+	GENERATED_BODY()
+
+	/** Center of one end of the capsule */
+	UPROPERTY(EditAnywhere, Category = "Trace")
+	FVector Start = FVector::ZeroVector;
+
+	/** Center of the other end of the capsule */
+	UPROPERTY(EditAnywhere, Category = "Trace")
+	FVector End = FVector(0.0, 0.0, 100.0);
+
+	UPROPERTY(EditAnywhere, Category = "Trace", meta = (ClampMin = "0.0"))
+	float Radius = 5.0F;
+};
+
+/**
+ * Everything that defines a weapon: its mesh, the montages of its combo, its damage and the
+ * shapes its melee trace sweeps. Shared by every fighter holding it, which only adds a
+ * UWeaponComponent for the mesh instead of spawning a weapon actor.
+ */
+UCLASS(BlueprintType)
+class BEADURINC_API UWeaponDataAsset : public UDataAsset, public ICombatAttackSourceInterface
+{
+	GENERATED_BODY()
+
+	/** Mesh attached to the holder's hand */
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	TObjectPtr<UStaticMesh> Mesh;
+
+	/** Socket of the holder's skeleton the mesh is attached to */
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	FName AttachSocket;
+
+	/** Transform of the mesh relative to the socket */
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	FTransform AttachOffset;
+
+	/** Combo attack sequence for the holder */
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	TArray<TObjectPtr<UAnimMontage>> ComboAttacks;
+
+	/** Damage attribute provided to the holder */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	float BaseDamage;
+
+	/** Row of the combat resolution table hits of this weapon are resolved with */
+	UPROPERTY(EditAnywhere, Category = "Attribute")
+	ECombatAttackType AttackType;
+
+	/** Shapes swept from their previous to their current position every frame of a melee trace */
+	UPROPERTY(EditAnywhere, Category = "Trace")
+	TArray<FWeaponTraceShape> TraceShapes;
+
+	/** Path of the attach socket through each combo attack, baked by UBakeWeaponTrajectoriesCommandlet for servers that never pose fighters */
+	UPROPERTY(VisibleAnywhere, Category = "Trace")
+	TArray<FWeaponTrajectory> ComboTrajectories;
+
+public:
+
+	UWeaponDataAsset();
+
+	/** Returns a combo attack montage for given index */
+	UAnimMontage* GetComboAttackAt(uint32 Index) const;
+
+	FORCEINLINE uint32 GetComboSequenceLength() const { return ComboAttacks.Num(); }
+
+	FORCEINLINE float GetWeaponBaseDamage() const { return BaseDamage; }
+
+	FORCEINLINE virtual ECombatAttackType GetAttackType() const override { return AttackType; }
+
+	FORCEINLINE UStaticMesh* GetMesh() const { return Mesh; }
+
+	FORCEINLINE FName GetAttachSocket() const { return AttachSocket; }
+
+	FORCEINLINE const FTransform& GetAttachOffset() const { return AttachOffset; }
+
+	FORCEINLINE const TArray<FWeaponTraceShape>& GetTraceShapes() const { return TraceShapes; }
+
+	/** Returns the baked trajectory of a combo attack montage, null when it was not baked */
+	const FWeaponTrajectory* FindComboTrajectory(const UAnimMontage* Montage) const;
+
+	/** Returns whether every combo attack has a baked trajectory, so the weapon can be swept without posing its holder */
+	bool HasAllComboTrajectories() const;
+
+#if WITH_EDITOR
+	/** Replaces the baked trajectories of the combo attacks */
+	FORCEINLINE void SetComboTrajectories(TArray<FWeaponTrajectory>&& InComboTrajectories) { ComboTrajectories = MoveTemp(InComboTrajectories); }
+
+	FORCEINLINE const TArray<FWeaponTrajectory>& GetComboTrajectories() const { return ComboTrajectories; }
+#endif
+
+	/**
+	 * Returns weapon data read from a weapon actor blueprint: its montages, damage and attack type,
+	 * its static mesh and its capsule as the trace shape. Lets fighters still pointing at a weapon
+	 * actor hold it as a component until they are given a data asset. Built once per class.
+	 */
+	static UWeaponDataAsset* GetFromWeaponActor(TSubclassOf<AWeaponActor> WeaponActorClass);
+};
@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actor/Weapon/WeaponTrajectory.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Combat/Debug/CombatMemory.h"
+
+namespace WeaponTrajectory
+{
+	static constexpr float PositionSteps = static_cast<float>(TNumericLimits<uint16>::Max());
+	static constexpr float RotationSteps = static_cast<float>(TNumericLimits<int16>::Max());
+
+	static FVector DecodePosition(const FWeaponTrajectory& Trajectory, int32 Sample)
+	{
+		const uint16* Encoded = &Trajectory.Positions[Sample * 3];
+
+		return FVector
+		(
+			Trajectory.PositionMin.X + Trajectory.PositionExtent.X * (Encoded[0] / PositionSteps),
+			Trajectory.PositionMin.Y + Trajectory.PositionExtent.Y * (Encoded[1] / PositionSteps),
+			Trajectory.PositionMin.Z + Trajectory.PositionExtent.Z * (Encoded[2] / PositionSteps)
+		);
+	}
+
+	static FQuat DecodeRotation(const FWeaponTrajectory& Trajectory, int32 Sample)
+	{
+		const int16* Encoded = &Trajectory.Rotations[Sample * 3];
+		const double X = Encoded[0] / RotationSteps;
+		const double Y = Encoded[1] / RotationSteps;
+		const double Z = Encoded[2] / RotationSteps;
+
+		return FQuat(X, Y, Z, FMath::Sqrt(FMath::Max(1.0 - X * X - Y * Y - Z * Z, 0.0)));
+	}
+}
+
+FTransform FWeaponTrajectory::Evaluate(float Position) const
+{
+	const int32 NumSamples = GetNumSamples();
+
+	if (NumSamples == 0)
+	{
+		return FTransform::Identity;
+	}
+
+	const float SamplePosition = FMath::Clamp(Position * SampleRate, 0.0F, static_cast<float>(NumSamples - 1));
+	const int32 First = FMath::FloorToInt32(SamplePosition);
+	const int32 Second = FMath::Min(First + 1, NumSamples - 1);
+	const float Alpha = SamplePosition - First;
+
+	const FVector Location = FMath::Lerp(WeaponTrajectory::DecodePosition(*this, First), WeaponTrajectory::DecodePosition(*this, Second), Alpha);
+	const FQuat Rotation = FQuat::Slerp(WeaponTrajectory::DecodeRotation(*this, First), WeaponTrajectory::DecodeRotation(*this, Second), Alpha);
+
+	return FTransform(Rotation, Location);
+}
+
+FWeaponTrajectory FWeaponTrajectory::Compress(UAnimMontage* InMontage, float InSampleRate, TConstArrayView<FTransform> Samples)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+
+	FWeaponTrajectory Trajectory;
+	Trajectory.Montage = InMontage;
+	Trajectory.SampleRate = InSampleRate;
+
+	if (Samples.IsEmpty())
+	{
+		return Trajectory;
+	}
+
+	FBox3f Bounds(ForceInit);
+
+	for (const FTransform& Sample : Samples)
+	{
+		Bounds += FVector3f(Sample.GetLocation());
+	}
+
+	Trajectory.PositionMin = Bounds.Min;
+	Trajectory.PositionExtent = Bounds.Max - Bounds.Min;
+	Trajectory.Positions.Reserve(Samples.Num() * 3);
+	Trajectory.Rotations.Reserve(Samples.Num() * 3);
+
+	for (const FTransform& Sample : Samples)
+	{
+		const FVector3f Location = FVector3f(Sample.GetLocation());
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Fraction = Trajectory.PositionExtent[Axis] > UE_KINDA_SMALL_NUMBER ? (Location[Axis] - Trajectory.PositionMin[Axis]) / Trajectory.PositionExtent[Axis] : 0.0F;
+			Trajectory.Positions.Add(static_cast<uint16>(FMath::RoundToInt32(FMath::Clamp(Fraction, 0.0F, 1.0F) * WeaponTrajectory::PositionSteps)));
+		}
+
+		// q and -q are the same rotation, so w is kept positive and left out
+		FQuat Rotation = Sample.GetRotation().GetNormalized();
+
+		if (Rotation.W < 0.0)
+		{
+			Rotation = -Rotation;
+		}
+
+		Trajectory.Rotations.Add(static_cast<int16>(FMath::RoundToInt32(Rotation.X * WeaponTrajectory::RotationSteps)));
+		Trajectory.Rotations.Add(static_cast<int16>(FMath::RoundToInt32(Rotation.Y * WeaponTrajectory::RotationSteps)));
+		Trajectory.Rotations.Add(static_cast<int16>(FMath::RoundToInt32(Rotation.Z * WeaponTrajectory::RotationSteps)));
+	}
+
+	return Trajectory;
+}
+
+FWeaponTrajectory FWeaponTrajectory::Bake(USkeletalMeshComponent* Mesh, UAnimMontage* InMontage, FName Socket, float InSampleRate)
+{
+	if (!Mesh || !InMontage || !Mesh->DoesSocketExist(Socket) || InSampleRate <= 0.0F)
+	{
+		return FWeaponTrajectory();
+	}
+
+	// The montage alone, without a locomotion pose or slot blending underneath it
+	Mesh->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+	Mesh->SetAnimation(InMontage);
+	Mesh->SetPlayRate(0.0F);
+
+	const float Length = InMontage->GetPlayLength();
+	const int32 NumSamples = FMath::FloorToInt32(Length * InSampleRate) + 1;
+
+	TArray<FTransform> Samples;
+	Samples.Reserve(NumSamples);
+
+	for (int32 Index = 0; Index < NumSamples; ++Index)
+	{
+		Mesh->SetPosition(FMath::Min(Index / InSampleRate, Length), false);
+		Mesh->TickAnimation(0.0F, false);
+		Mesh->RefreshBoneTransforms();
+
+		Samples.Add(Mesh->GetSocketTransform(Socket, RTS_Component));
+	}
+
+	return Compress(InMontage, InSampleRate, Samples);
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponTrajectory.generated.h"
+
+class UAnimMontage;
+class USkeletalMeshComponent;
+
+/**
+ * The path of the weapon socket through a montage, relative to the skeletal mesh component,
+ * sampled at a fixed rate and quantized to 12 bytes a sample.
+ *
+ * Lets a server that never poses its fighters rebuild where the weapon is from the montage
+ * position and the mesh's transform alone. Positions are stored as 16 bit fractions of the
+ * bounds of the path, rotations as the 16 bit x, y and z of a quaternion with a positive w.
+ */
+USTRUCT()
+struct BEADURINC_API FWeaponTrajectory
+{
+	GENERATED_BODY()
+
+	/** Montage the trajectory was sampled from */
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	TObjectPtr<UAnimMontage> Montage;
+
+	/** Samples per second of montage time */
+	UPROPERTY(VisibleAnywhere, Category = "Trajectory")
+	float SampleRate = 60.0F;
+
+	/** Corner of the bounds of the socket's path */
+	UPROPERTY()
+	FVector3f PositionMin = FVector3f::ZeroVector;
+
+	/** Size of the bounds of the socket's path */
+	UPROPERTY()
+	FVector3f PositionExtent = FVector3f::ZeroVector;
+
+	/** Three fractions of the bounds per sample */
+	UPROPERTY()
+	TArray<uint16> Positions;
+
+	/** Quaternion x, y and z per sample */
+	UPROPERTY()
+	TArray<int16> Rotations;
+
+	FORCEINLINE int32 GetNumSamples() const { return Positions.Num() / 3; }
+
+	FORCEINLINE bool IsValid() const { return Montage && GetNumSamples() > 0; }
+
+	bool operator==(const FWeaponTrajectory& Other) const
+	{
+		return Montage == Other.Montage && SampleRate == Other.SampleRate && PositionMin == Other.PositionMin && PositionExtent == Other.PositionExtent && Positions == Other.Positions && Rotations == Other.Rotations;
+	}
+
+	/** Returns the socket's transform relative to the mesh component at a montage position, interpolated between samples */
+	FTransform Evaluate(float Position) const;
+
+	/** Quantizes sampled socket transforms, the first at montage position 0 and one every 1 / InSampleRate seconds after */
+	static FWeaponTrajectory Compress(UAnimMontage* InMontage, float InSampleRate, TConstArrayView<FTransform> Samples);
+
+	/**
+	 * Samples a montage by fully evaluating it on a registered mesh component. The mesh is left
+	 * playing the montage as a single animation.
+	 */
+	static FWeaponTrajectory Bake(USkeletalMeshComponent* Mesh, UAnimMontage* InMontage, FName Socket, float InSampleRate);
+};
@@ -2,11 +2,16 @@
 
 #include "WeaponActor.h"
 #include "GameFramework/Character.h"
+#include "Combat/Debug/CombatMemory.h"
 
 AWeaponActor::AWeaponActor()
 {
+	LLM_SCOPE_BYTAG(Beadurinc_Weapons);
+	
  	// Instead of update colliding actors in each tick, 
 	PrimaryActorTick.bCanEverTick = false;
+	
+	AttackType = ECombatAttackType::Light;
 }
 
 TObjectPtr<UAnimMontage> AWeaponActor::GetComboAttackAt(const unsigned int& Index) const
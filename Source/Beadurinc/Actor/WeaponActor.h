@@ -5,10 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameplayEffect.h"
+#include "Combat/CombatResolutionTable.h"
 #include "WeaponActor.generated.h"
 
 class ACharacter;
 
+/**
+ * Legacy weapon blueprint. Fighters no longer spawn it: a fighter still pointing at one reads it
+ * into a UWeaponDataAsset and holds it as a UWeaponComponent. New weapons are data assets.
+ */
 UCLASS()
 class BEADURINC_API AWeaponActor : public AActor
 {
@@ -22,6 +27,10 @@ class BEADURINC_API AWeaponActor : public AActor
 	UPROPERTY(EditAnywhere, Category="Attribute", meta=(AllowPrivateAccess=true))
 	float WeaponBaseDamage;
 	
+	/** Row of the combat resolution table hits of this weapon are resolved with */
+	UPROPERTY(EditAnywhere, Category="Attribute", meta=(AllowPrivateAccess=true))
+	ECombatAttackType AttackType;
+	
 public:	
 	// Sets default values for this actor's properties
 	AWeaponActor();
@@ -30,7 +39,11 @@ public:
 	// Returns a combo attack montage for given index
 	TObjectPtr<UAnimMontage> GetComboAttackAt(const unsigned int& Index) const;
 	
+	FORCEINLINE const TArray<TObjectPtr<UAnimMontage>>& GetComboAttacks() const { return WeaponComboAttacks; };
+	
 	FORCEINLINE uint32 GetComboSequenceLength() const { return WeaponComboAttacks.Num(); };
 	
 	FORCEINLINE float GetWeaponBaseDamage() const { return WeaponBaseDamage; };
+	
+	FORCEINLINE ECombatAttackType GetAttackType() const { return AttackType; };
 };
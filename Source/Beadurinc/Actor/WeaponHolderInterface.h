@@ -6,12 +6,12 @@
 #include "WeaponHolderInterface.generated.h"
 
 class AActor;
-class AWeaponActor;
+class UWeaponComponent;
 
 /// Usually characters that grab a weapon in their hand.
 /// 
-/// this will help get a weapon actor to toggle its collider
-/// in notifies, and hook the overlap event to apply damage and stuns.
+/// this will help get a weapon to start and stop its melee trace
+/// in notifies, and hook the contact event to apply damage and stuns.
 /// 
 /// NAMING RULE MATTERS: In Unreal Engine, Interfaces consist of a stub
 /// class that inherits `UInterface` and declared by `UINTERFACE` macro,
@@ -33,9 +33,9 @@ class IWeaponHolderInterface
 	GENERATED_BODY()
 public:
 	
-	/** Returns whether this character is holding a weapon actor */
+	/** Returns whether this character is holding a weapon */
 	virtual bool IsHoldingWeapon() const = 0;
 	
-	/** Returns a weapon in an actor's main hand */
-	virtual TObjectPtr<AWeaponActor> GetWeaponActor() const = 0;
+	/** Returns the weapon in an actor's main hand */
+	virtual UWeaponComponent* GetWeapon() const = 0;
 };
\ No newline at end of file
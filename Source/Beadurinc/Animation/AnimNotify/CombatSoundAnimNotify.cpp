@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Animation/AnimNotify/CombatSoundAnimNotify.h"
+
+#include "Combat/Audio/CombatAudioSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void UCombatSoundAnimNotify::Notify
+(
+	USkeletalMeshComponent* MeshComp,
+	UAnimSequenceBase* Animation,
+	const FAnimNotifyEventReference& EventReference
+)
+{
+	if (!MeshComp) return;
+	
+	// Editor previews have no combat audio and play the sound directly
+	UCombatAudioSubsystem::PlayCombatSound(MeshComp, Sound, Category, MeshComp->GetSocketLocation(Socket));
+}
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "Combat/Audio/CombatAudio.h"
+#include "CombatSoundAnimNotify.generated.h"
+
+class USoundBase;
+
+/**
+ * Plays a sound of a montage (a swing, a roll) through the combat audio budget instead of
+ * taking a voice of its own every time.
+ */
+UCLASS(meta = (DisplayName = "Play Combat Sound"))
+class BEADURINC_API UCombatSoundAnimNotify : public UAnimNotify
+{
+	GENERATED_BODY()
+	
+	/** Sound played */
+	UPROPERTY(EditAnywhere, Category = "Sound", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<USoundBase> Sound;
+	
+	/** Voice budget the sound is played within */
+	UPROPERTY(EditAnywhere, Category = "Sound", meta = (AllowPrivateAccess = "true"))
+	ECombatSoundCategory Category = ECombatSoundCategory::Swing;
+	
+	/** Socket the sound is played at. The mesh's location when unset or missing */
+	UPROPERTY(EditAnywhere, Category = "Sound", meta = (AllowPrivateAccess = "true"))
+	FName Socket;
+	
+public:
+	
+	virtual void Notify
+	(
+		USkeletalMeshComponent* MeshComp,
+		UAnimSequenceBase* Animation,
+		const FAnimNotifyEventReference& EventReference
+	) override;
+};
@@ -4,6 +4,7 @@
 #include "Animation/AnimNotify/FireBufferedInputAnimNotify.h"
 
 #include "Actor/Character/PlayerCharacter.h"
+#include "Animation/Timeline/StateWindowComponent.h"
 
 void UFireBufferedInputAnimNotify::Notify
 (
@@ -18,8 +19,8 @@ void UFireBufferedInputAnimNotify::Notify
 	
 	if (APlayerCharacter* OwnerCharacter = Cast<APlayerCharacter>(Owner))
 	{
-		// Triggers the notify only in local client
-		if (OwnerCharacter->IsLocallyControlled())
+		// Triggers the notify only in local client, unless the montage timeline flushes for it
+		if (OwnerCharacter->IsLocallyControlled() && !OwnerCharacter->GetStateWindowComponent()->DrivesCombatNotifies())
 		{
 			OwnerCharacter->FlushBufferedInput();
 		}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Animation/AnimNotify/LaunchProjectileAnimNotify.h"
+
+#include "Actor/Character/FighterCharacter.h"
+#include "Actor/Projectile/ProjectileSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void ULaunchProjectileAnimNotify::Notify
+(
+	USkeletalMeshComponent* MeshComp,
+	UAnimSequenceBase* Animation,
+	const FAnimNotifyEventReference& EventReference
+)
+{
+	if (!MeshComp) return;
+	
+	AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(MeshComp->GetOwner());
+	UWorld* World = MeshComp->GetWorld();
+	
+	if (!FighterCharacter || !World)
+	{
+		return;
+	}
+	
+	if (UProjectileSubsystem* Projectiles = World->GetSubsystem<UProjectileSubsystem>())
+	{
+		// Aim follows the controller when possessed, the actor's facing otherwise
+		Projectiles->Launch(
+			FighterCharacter,
+			Projectile,
+			MeshComp->GetSocketLocation(LaunchSocket),
+			FighterCharacter->GetBaseAimRotation().Vector()
+		);
+	}
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotify.h"
+#include "LaunchProjectileAnimNotify.generated.h"
+
+class UProjectileDataAsset;
+
+/**
+ * Launches a projectile from a socket of the owner's skeleton toward where the owner aims,
+ * e.g. on the release frame of a bow shot.
+ */
+UCLASS()
+class BEADURINC_API ULaunchProjectileAnimNotify : public UAnimNotify
+{
+	GENERATED_BODY()
+	
+	/** Projectile launched */
+	UPROPERTY(EditAnywhere, Category = "Projectile", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UProjectileDataAsset> Projectile;
+	
+	/** Socket the projectile leaves from */
+	UPROPERTY(EditAnywhere, Category = "Projectile", meta = (AllowPrivateAccess = "true"))
+	FName LaunchSocket = TEXT("Weapon_Socket");
+	
+public:
+	
+	virtual void Notify
+	(
+		USkeletalMeshComponent* MeshComp,
+		UAnimSequenceBase* Animation,
+		const FAnimNotifyEventReference& EventReference
+	) override;
+};
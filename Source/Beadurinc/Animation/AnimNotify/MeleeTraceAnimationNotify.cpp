@@ -1,7 +1,8 @@
 #include "MeleeTraceAnimationNotify.h"
 
-#include "Actor/WeaponActor.h"
+#include "Actor/Weapon/WeaponComponent.h"
 #include "Actor/Character/FighterCharacter.h"
+#include "Animation/Timeline/StateWindowComponent.h"
 
 void UMeleeTraceAnimationNotify::NotifyBegin
 (
@@ -11,12 +12,16 @@ void UMeleeTraceAnimationNotify::NotifyBegin
 	const FAnimNotifyEventReference& EventReference
 )
 {
-	// Check if the owner is a weapon holdable character
-	if (AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(MeshComp->GetOwner()))
+	// Check if the owner is a weapon holdable character. Servers sweep from the montage timeline instead
+	AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(MeshComp->GetOwner());
+	
+	if (FighterCharacter && !FighterCharacter->GetStateWindowComponent()->DrivesCombatNotifies())
 	{
-		// Activate collision check when contacting phase starts
-		FighterCharacter->ResetMeleeSwing();
-		FighterCharacter->GetWeaponActor()->SetActorEnableCollision(true);
+		// Start sweeping the weapon when contacting phase starts
+		FighterCharacter->BeginMeleeSwing();
+		FighterCharacter->GetWeapon()->BeginTrace();
+		
+		RECORD_COMBAT_EVENT(FighterCharacter, TraceBegin, Animation->GetFName());
 	}
 }
 
@@ -27,11 +32,15 @@ void UMeleeTraceAnimationNotify::NotifyEnd
 	const FAnimNotifyEventReference& EventReference
 )
 {
-	// Check if the owner is a weapon holdable character
-	if (AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(MeshComp->GetOwner()))
+	// Check if the owner is a weapon holdable character. Servers sweep from the montage timeline instead
+	AFighterCharacter* FighterCharacter = Cast<AFighterCharacter>(MeshComp->GetOwner());
+	
+	if (FighterCharacter && !FighterCharacter->GetStateWindowComponent()->DrivesCombatNotifies())
 	{
-		// Deactivate collision check when contacting phase ends
+		// Stop sweeping the weapon when contacting phase ends
 		FighterCharacter->ResetMeleeSwing();
-		FighterCharacter->GetWeaponActor()->SetActorEnableCollision(false);
+		FighterCharacter->GetWeapon()->EndTrace();
+		
+		RECORD_COMBAT_EVENT(FighterCharacter, TraceEnd, Animation->GetFName());
 	}
 }
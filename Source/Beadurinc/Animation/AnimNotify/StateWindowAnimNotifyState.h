@@ -8,8 +8,9 @@
 /**
  * A notify state for determining a character's state by FGameplayTag.
  * 
- * At the beginning of notify, called on NotifyBegin, adds the pre-defined
- * gameplay tag to the owner's gameplay ability system. 
+ * Marks the time range of a montage in which the owner holds the pre-defined
+ * gameplay tag. The range is read once into the montage's timeline, and
+ * UStateWindowComponent opens and closes the window as the montage plays.
  */
 UCLASS()
 class BEADURINC_API UStateWindowAnimNotifyState : public UAnimNotifyState
@@ -19,20 +20,8 @@ class BEADURINC_API UStateWindowAnimNotifyState : public UAnimNotifyState
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "StateTag", meta = (AllowPrivateAccess = true))
 	FGameplayTag StateTag;
 	
-protected:
+public:
 	
-	virtual void NotifyBegin
-	(
-		USkeletalMeshComponent* MeshComp,
-		UAnimSequenceBase* Animation,
-		float TotalDuration,
-		const FAnimNotifyEventReference& EventReference
-	) override;
-	
-	virtual void NotifyEnd
-	(
-		USkeletalMeshComponent* MeshComp,
-		UAnimSequenceBase* Animation,
-		const FAnimNotifyEventReference& EventReference
-	) override;
+	/** Returns the tag held while inside this window */
+	FORCEINLINE const FGameplayTag& GetStateTag() const { return StateTag; }
 };
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Animation/Timeline/BakeMontageTimelinesCommandlet.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/Timeline/MontageTimelineSubsystem.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Beadurinc.h"
+#include "Misc/PackageName.h"
+#include "UObject/SavePackage.h"
+
+UBakeMontageTimelinesCommandlet::UBakeMontageTimelinesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBakeMontageTimelinesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString Path = TEXT("/Game");
+	FParse::Value(*Params, TEXT("Path="), Path);
+	
+	const bool bCheckOnly = FParse::Param(*Params, TEXT("Check"));
+	
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+	
+	FARFilter Filter;
+	Filter.PackagePaths.Add(*Path);
+	Filter.ClassPaths.Add(UAnimMontage::StaticClass()->GetClassPathName());
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	
+	int32 StaleCount = 0;
+	int32 FailedCount = 0;
+	
+	for (const FAssetData& Asset : Assets)
+	{
+		UAnimMontage* Montage = Cast<UAnimMontage>(Asset.GetAsset());
+		
+		if (!Montage)
+		{
+			continue;
+		}
+		
+		const FMontageNotifyTimeline Timeline = FMontageNotifyTimeline::Build(Montage);
+		UMontageTimelineAssetUserData* Baked = Montage->GetAssetUserData<UMontageTimelineAssetUserData>();
+		
+		// Montages without combat notifies carry no bake, and drop one left from earlier edits
+		if (Timeline.IsEmpty() ? !Baked : (Baked && Baked->Timeline == Timeline))
+		{
+			continue;
+		}
+		
+		++StaleCount;
+		UE_LOG(LogBeadurinc, Display, TEXT("%s timeline of %s"), bCheckOnly ? TEXT("Stale") : TEXT("Baking"), *Asset.PackageName.ToString());
+		
+		if (bCheckOnly)
+		{
+			continue;
+		}
+		
+		Montage->Modify();
+		
+		if (Timeline.IsEmpty())
+		{
+			Montage->RemoveUserDataOfClass(UMontageTimelineAssetUserData::StaticClass());
+		}
+		else
+		{
+			if (!Baked)
+			{
+				Baked = NewObject<UMontageTimelineAssetUserData>(Montage, NAME_None, RF_Public | RF_Transactional);
+				Montage->AddAssetUserData(Baked);
+			}
+			
+			Baked->Timeline = Timeline;
+		}
+		
+		UPackage* Package = Montage->GetPackage();
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		
+		if (!UPackage::SavePackage(Package, Montage, *Filename, SaveArgs))
+		{
+			UE_LOG(LogBeadurinc, Error, TEXT("Could not save %s"), *Filename);
+			++FailedCount;
+		}
+	}
+	
+	UE_LOG(LogBeadurinc, Display, TEXT("%d of %d montages under %s %s"), StaleCount, Assets.Num(), *Path, bCheckOnly ? TEXT("have stale timelines") : TEXT("were baked"));
+	
+	return (bCheckOnly ? StaleCount : FailedCount) > 0 ? 1 : 0;
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeMontageTimelinesCommandlet.generated.h"
+
+/**
+ * Bakes the notify timeline of every montage under a path into its UMontageTimelineAssetUserData
+ * and saves the montages whose bake changed, so dedicated servers open and close combat windows
+ * from montage time without reading notify tracks. Cooking rebakes existing timelines by itself,
+ * this adds them to montages that have none and keeps the saved assets current:
+ *
+ *   UnrealEditor-Cmd Beadurinc.uproject -run=BakeMontageTimelines -Path=/Game/Characters
+ *
+ * Pass -Check to only report stale bakes and fail without saving, for build machines.
+ */
+UCLASS()
+class BEADURINC_API UBakeMontageTimelinesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	
+	UBakeMontageTimelinesCommandlet();
+	
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Animation/Timeline/MontageTimelineSubsystem.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimNotify/FireBufferedInputAnimNotify.h"
+#include "Animation/AnimNotify/MeleeTraceAnimationNotify.h"
+#include "Animation/AnimNotify/StateWindowAnimNotifyState.h"
+#include "Beadurinc.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "UObject/ObjectSaveContext.h"
+
+FMontageNotifyTimeline FMontageNotifyTimeline::Build(const UAnimMontage* Montage)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_Animation);
+
+	FMontageNotifyTimeline Timeline;
+
+	if (!Montage)
+	{
+		return Timeline;
+	}
+
+	for (const FAnimNotifyEvent& NotifyEvent : Montage->Notifies)
+	{
+		if (const UStateWindowAnimNotifyState* StateWindow = Cast<UStateWindowAnimNotifyState>(NotifyEvent.NotifyStateClass))
+		{
+			if (StateWindow->GetStateTag().IsValid())
+			{
+				FStateWindowSpan& Span = Timeline.Windows.AddDefaulted_GetRef();
+				Span.StateTag = StateWindow->GetStateTag();
+				Span.StartTime = NotifyEvent.GetTriggerTime();
+				Span.EndTime = NotifyEvent.GetEndTriggerTime();
+			}
+		}
+		else if (NotifyEvent.NotifyStateClass && NotifyEvent.NotifyStateClass->IsA<UMeleeTraceAnimationNotify>())
+		{
+			FMeleeTraceSpan& Span = Timeline.TraceWindows.AddDefaulted_GetRef();
+			Span.StartTime = NotifyEvent.GetTriggerTime();
+			Span.EndTime = NotifyEvent.GetEndTriggerTime();
+		}
+		else if (NotifyEvent.Notify && NotifyEvent.Notify->IsA<UFireBufferedInputAnimNotify>())
+		{
+			Timeline.BufferFlushTimes.Add(NotifyEvent.GetTriggerTime());
+		}
+	}
+
+	Timeline.Windows.Sort([](const FStateWindowSpan& A, const FStateWindowSpan& B)
+	{
+		return A.StartTime < B.StartTime;
+	});
+
+	Timeline.TraceWindows.Sort([](const FMeleeTraceSpan& A, const FMeleeTraceSpan& B)
+	{
+		return A.StartTime < B.StartTime;
+	});
+
+	Timeline.BufferFlushTimes.Sort();
+
+	// Open windows are tracked as bits of a uint64
+	if (Timeline.Windows.Num() > 64)
+	{
+		UE_LOG(LogBeadurinc, Warning, TEXT("Montage %s has %d state windows, only the first 64 are evaluated"), *Montage->GetName(), Timeline.Windows.Num());
+		Timeline.Windows.SetNum(64);
+	}
+
+	return Timeline;
+}
+
+bool FMontageNotifyTimeline::operator==(const FMontageNotifyTimeline& Other) const
+{
+	if (Windows.Num() != Other.Windows.Num() || TraceWindows.Num() != Other.TraceWindows.Num() || BufferFlushTimes != Other.BufferFlushTimes)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Windows.Num(); ++Index)
+	{
+		const FStateWindowSpan& A = Windows[Index];
+		const FStateWindowSpan& B = Other.Windows[Index];
+
+		if (A.StateTag != B.StateTag || A.StartTime != B.StartTime || A.EndTime != B.EndTime)
+		{
+			return false;
+		}
+	}
+
+	for (int32 Index = 0; Index < TraceWindows.Num(); ++Index)
+	{
+		if (TraceWindows[Index].StartTime != Other.TraceWindows[Index].StartTime || TraceWindows[Index].EndTime != Other.TraceWindows[Index].EndTime)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UMontageTimelineAssetUserData::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+#if WITH_EDITOR
+	// Cooked builds trust the bake, so notifies edited since the last BakeMontageTimelines must not ship stale
+	if (ObjectSaveContext.IsCooking())
+	{
+		if (const UAnimMontage* Montage = GetTypedOuter<UAnimMontage>())
+		{
+			const FMontageNotifyTimeline Built = FMontageNotifyTimeline::Build(Montage);
+
+			if (!(Built == Timeline))
+			{
+				UE_LOG(LogBeadurinc, Display, TEXT("Rebaking the stale timeline of %s for cooking"), *Montage->GetPathName());
+				Timeline = Built;
+			}
+		}
+	}
+#endif
+}
+
+const FMontageNotifyTimeline& UMontageTimelineSubsystem::GetTimeline(const UAnimMontage* Montage)
+{
+	if (const FMontageNotifyTimeline* const* Timeline = Timelines.Find(Montage))
+	{
+		return **Timeline;
+	}
+
+	LLM_SCOPE_BYTAG(Beadurinc_Animation);
+
+#if !WITH_EDITOR
+	// IInterface_AssetUserData has no const accessors
+	if (UMontageTimelineAssetUserData* Baked = Montage ? const_cast<UAnimMontage*>(Montage)->GetAssetUserData<UMontageTimelineAssetUserData>() : nullptr)
+	{
+		BakedTimelines.Add(Baked);
+		return *Timelines.Add(Montage, &Baked->Timeline);
+	}
+#endif
+
+	const FMontageNotifyTimeline* Built = BuiltTimelines.Add_GetRef(MakeUnique<FMontageNotifyTimeline>(FMontageNotifyTimeline::Build(Montage))).Get();
+	return *Timelines.Add(Montage, Built);
+}
@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Engine/AssetUserData.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MontageTimelineSubsystem.generated.h"
+
+class UAnimMontage;
+
+/** A time range of a montage in which a state tag is held */
+USTRUCT()
+struct FStateWindowSpan
+{
+	GENERATED_BODY()
+
+	/** Tag held while the montage position is inside the window */
+	UPROPERTY()
+	FGameplayTag StateTag;
+
+	/** Montage position the window opens at */
+	UPROPERTY()
+	float StartTime = 0.0F;
+
+	/** Montage position the window closes at */
+	UPROPERTY()
+	float EndTime = 0.0F;
+};
+
+/** A time range of a montage in which the weapon is swept, from a UMeleeTraceAnimationNotify */
+USTRUCT()
+struct FMeleeTraceSpan
+{
+	GENERATED_BODY()
+
+	/** Montage position the weapon starts sweeping at */
+	UPROPERTY()
+	float StartTime = 0.0F;
+
+	/** Montage position the weapon stops sweeping at */
+	UPROPERTY()
+	float EndTime = 0.0F;
+};
+
+/**
+ * The combat notifies of a montage flattened into spans and markers sorted by time.
+ * Built once per montage, so evaluating windows needs no notify dispatch, Cast or lookup, and
+ * only the montage position has to advance for the windows to open and close.
+ */
+USTRUCT()
+struct FMontageNotifyTimeline
+{
+	GENERATED_BODY()
+
+	/** UStateWindowAnimNotifyState windows sorted by StartTime. At most 64 per montage, one bit each in the open mask */
+	UPROPERTY()
+	TArray<FStateWindowSpan> Windows;
+
+	/** UMeleeTraceAnimationNotify windows sorted by StartTime */
+	UPROPERTY()
+	TArray<FMeleeTraceSpan> TraceWindows;
+
+	/** Sorted positions of the UFireBufferedInputAnimNotify notifies */
+	UPROPERTY()
+	TArray<float> BufferFlushTimes;
+
+	/** Extracts the combat notifies out of a montage's notify tracks */
+	static FMontageNotifyTimeline Build(const UAnimMontage* Montage);
+
+	/** Returns true when the montage has no combat notify at all */
+	FORCEINLINE bool IsEmpty() const { return Windows.IsEmpty() && TraceWindows.IsEmpty() && BufferFlushTimes.IsEmpty(); }
+
+	bool operator==(const FMontageNotifyTimeline& Other) const;
+};
+
+/**
+ * A montage's timeline baked ahead of time by UBakeMontageTimelinesCommandlet. Cooked builds read
+ * it instead of walking the notify tracks; the editor always rebuilds so edited montages never
+ * play a stale bake, and cooking rebuilds it from the montage so cooked builds never do either.
+ */
+UCLASS()
+class BEADURINC_API UMontageTimelineAssetUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(VisibleAnywhere, Category = "Timeline")
+	FMontageNotifyTimeline Timeline;
+
+	/** Rebuilds the timeline from the owning montage when cooking */
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+};
+
+/**
+ * Per-world cache of montage timelines. Timelines are read from the montage's baked user data or
+ * built the first time a montage is played in this world, and reused by every fighter playing it
+ * afterwards.
+ */
+UCLASS()
+class BEADURINC_API UMontageTimelineSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Returns the notify timeline of a montage, building it on first request. The reference stays valid for the world's lifetime */
+	const FMontageNotifyTimeline& GetTimeline(const UAnimMontage* Montage);
+
+private:
+
+	/** Timelines by montage, either baked or one of BuiltTimelines */
+	TMap<TObjectKey<UAnimMontage>, const FMontageNotifyTimeline*> Timelines;
+
+	/** Timelines built at runtime. Heap allocated so references survive growing the array */
+	TArray<TUniquePtr<FMontageNotifyTimeline>> BuiltTimelines;
+
+	/** Baked timelines handed out, kept alive for the world's lifetime like the built ones */
+	UPROPERTY()
+	TArray<TObjectPtr<UMontageTimelineAssetUserData>> BakedTimelines;
+};
@@ -0,0 +1,391 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Animation/Timeline/StateWindowComponent.h"
+#include "AbilitySystemBlueprintLibrary.h"
+#include "AbilitySystemComponent.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/Timeline/MontageTimelineSubsystem.h"
+#include "Actor/Character/PlayerCharacter.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatTimeline.h"
+#include "GameFramework/Character.h"
+#include "Combat/Debug/CombatMemory.h"
+
+UStateWindowComponent::UStateWindowComponent()
+{
+	// Only ticks while a montage with state windows is playing
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UStateWindowComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const ACharacter* Character = GetOwner<ACharacter>();
+
+	if (!Character || !Character->GetMesh())
+	{
+		return;
+	}
+
+	// Evaluate after the mesh has advanced its montages this frame
+	AddTickPrerequisiteComponent(Character->GetMesh());
+
+	// Nobody looks at poses on a dedicated server, where combat windows follow montage time instead of notifies.
+	// Whether bones are still posed depends on the weapon, decided by the fighter once it is equipped
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		bDrivesCombatNotifies = true;
+	}
+
+	if (UAnimInstance* OwnerAnimInstance = Character->GetMesh()->GetAnimInstance())
+	{
+		AnimInstance = OwnerAnimInstance;
+		OwnerAnimInstance->OnMontageStarted.AddDynamic(this, &UStateWindowComponent::OnMontageStarted);
+		OwnerAnimInstance->OnMontageBlendingOut.AddDynamic(this, &UStateWindowComponent::OnMontageBlendingOut);
+		OwnerAnimInstance->OnMontageEnded.AddDynamic(this, &UStateWindowComponent::OnMontageEnded);
+	}
+}
+
+void UStateWindowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The ASC may outlive this avatar (PlayerState owned), so never leave a window's tag behind
+	while (ActiveMontages.Num() > 0)
+	{
+		ReleaseMontage(ActiveMontages.Last().Montage.Get());
+	}
+
+	if (UAnimInstance* OwnerAnimInstance = AnimInstance.Get())
+	{
+		OwnerAnimInstance->OnMontageStarted.RemoveDynamic(this, &UStateWindowComponent::OnMontageStarted);
+		OwnerAnimInstance->OnMontageBlendingOut.RemoveDynamic(this, &UStateWindowComponent::OnMontageBlendingOut);
+		OwnerAnimInstance->OnMontageEnded.RemoveDynamic(this, &UStateWindowComponent::OnMontageEnded);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UStateWindowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_StateWindows);
+	
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const UAnimInstance* OwnerAnimInstance = AnimInstance.Get();
+	FWindowChanges Changes;
+
+	for (int32 Index = ActiveMontages.Num() - 1; Index >= 0; --Index)
+	{
+		const UAnimMontage* Montage = ActiveMontages[Index].Montage.Get();
+
+		if (!OwnerAnimInstance || !Montage)
+		{
+			ReleaseMontage(Montage);
+			continue;
+		}
+
+		EvaluateMontage(ActiveMontages[Index], OwnerAnimInstance->Montage_GetPosition(Montage), Changes);
+	}
+
+	ApplyChanges(Changes);
+}
+
+void UStateWindowComponent::OpenWindow(const FGameplayTag& StateTag)
+{
+	int32& Count = WindowCounts.FindOrAdd(StateTag);
+
+	if (++Count == 1)
+	{
+		if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+		{
+			ASC->AddLooseGameplayTag(StateTag);
+		}
+		
+		RECORD_COMBAT_EVENT(GetOwner(), WindowOpened, StateTag.GetTagName());
+	}
+}
+
+void UStateWindowComponent::CloseWindow(const FGameplayTag& StateTag)
+{
+	int32* Count = WindowCounts.Find(StateTag);
+
+	if (!Count)
+	{
+		return;
+	}
+
+	if (--(*Count) <= 0)
+	{
+		WindowCounts.Remove(StateTag);
+
+		if (UAbilitySystemComponent* ASC = GetAbilitySystemComponent())
+		{
+			ASC->RemoveLooseGameplayTag(StateTag);
+		}
+		
+		RECORD_COMBAT_EVENT(GetOwner(), WindowClosed, StateTag.GetTagName());
+	}
+}
+
+void UStateWindowComponent::HandOverWindow(const UAnimMontage* Montage, const FGameplayTag& StateTag)
+{
+	FActiveMontageWindows* Active = ActiveMontages.FindByPredicate([Montage](const FActiveMontageWindows& Entry)
+	{
+		return Entry.Montage.Get() == Montage;
+	});
+
+	if (!Active)
+	{
+		CloseWindow(StateTag);
+		return;
+	}
+
+	Active->LeadingTags.Add(StateTag);
+}
+
+void UStateWindowComponent::OnMontageStarted(UAnimMontage* Montage)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_Animation);
+	
+	UMontageTimelineSubsystem* TimelineSubsystem = GetWorld()->GetSubsystem<UMontageTimelineSubsystem>();
+
+	if (!Montage || !TimelineSubsystem)
+	{
+		return;
+	}
+
+	// Restarting the same montage begins a fresh set of windows
+	ReleaseMontage(Montage);
+
+	const FMontageNotifyTimeline& Timeline = TimelineSubsystem->GetTimeline(Montage);
+
+	if (!NeedsEvaluation(Timeline))
+	{
+		return;
+	}
+
+	FActiveMontageWindows& Active = ActiveMontages.AddDefaulted_GetRef();
+	Active.Montage = Montage;
+	Active.Timeline = &Timeline;
+
+	SetComponentTickEnabled(true);
+
+	// Windows starting at the first frame are open in the same frame the montage starts
+	if (const UAnimInstance* OwnerAnimInstance = AnimInstance.Get())
+	{
+		FWindowChanges Changes;
+		EvaluateMontage(Active, OwnerAnimInstance->Montage_GetPosition(Montage), Changes);
+		ApplyChanges(Changes);
+	}
+}
+
+void UStateWindowComponent::OnMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted)
+{
+	// An interrupted montage keeps blending out, but its windows must not outlive the interruption
+	if (bInterrupted)
+	{
+		ReleaseMontage(Montage);
+	}
+}
+
+void UStateWindowComponent::OnMontageEnded(UAnimMontage* Montage, bool bInterrupted)
+{
+	ReleaseMontage(Montage);
+}
+
+void UStateWindowComponent::ReleaseMontage(const UAnimMontage* Montage)
+{
+	const int32 Index = ActiveMontages.IndexOfByPredicate([Montage](const FActiveMontageWindows& Entry)
+	{
+		return Entry.Montage.Get() == Montage;
+	});
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FActiveMontageWindows Active = MoveTemp(ActiveMontages[Index]);
+	ActiveMontages.RemoveAtSwap(Index);
+
+	for (int32 WindowIndex = 0; WindowIndex < Active.Timeline->Windows.Num(); ++WindowIndex)
+	{
+		if (Active.OpenMask & (1ull << WindowIndex))
+		{
+			CloseWindow(Active.Timeline->Windows[WindowIndex].StateTag);
+		}
+	}
+
+	for (const FGameplayTag& LeadingTag : Active.LeadingTags)
+	{
+		CloseWindow(LeadingTag);
+	}
+
+	if (Active.bTracing)
+	{
+		SetMeleeTrace(false, Active.Montage.IsValid() ? Active.Montage->GetFName() : NAME_None);
+	}
+
+	if (ActiveMontages.IsEmpty())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UStateWindowComponent::EvaluateMontage(FActiveMontageWindows& Active, float Position, FWindowChanges& OutChanges)
+{
+	const TArray<FStateWindowSpan>& Windows = Active.Timeline->Windows;
+
+	// Windows lying wholly between the last and the current position were played over this frame.
+	// Nothing was played over when the montage just started or jumped back to an earlier section.
+	const bool bAdvanced = Active.LastPosition != TNumericLimits<float>::Lowest() && Position >= Active.LastPosition;
+
+	for (int32 WindowIndex = 0; WindowIndex < Windows.Num(); ++WindowIndex)
+	{
+		const FStateWindowSpan& Window = Windows[WindowIndex];
+		const uint64 Bit = 1ull << WindowIndex;
+		const bool bShouldBeOpen = Position >= Window.StartTime && Position < Window.EndTime;
+		const bool bIsOpen = (Active.OpenMask & Bit) != 0;
+
+		if (bShouldBeOpen && !bIsOpen)
+		{
+			Active.OpenMask |= Bit;
+			OutChanges.Opened.Add(Window.StateTag);
+		}
+		else if (!bShouldBeOpen && !bIsOpen && bAdvanced && Window.StartTime >= Active.LastPosition && Window.EndTime <= Position)
+		{
+			// Shorter than a frame: opened and closed at once, so the tag's add and remove events still fire
+			OutChanges.Opened.Add(Window.StateTag);
+			OutChanges.Closed.Add(Window.StateTag);
+
+			if (Active.LeadingTags.RemoveSingleSwap(Window.StateTag) > 0)
+			{
+				OutChanges.Closed.Add(Window.StateTag);
+			}
+		}
+		else if (!bShouldBeOpen && bIsOpen)
+		{
+			Active.OpenMask &= ~Bit;
+			OutChanges.Closed.Add(Window.StateTag);
+
+			// A window handed over ahead of the timeline ends together with the montage's own window
+			if (Active.LeadingTags.RemoveSingleSwap(Window.StateTag) > 0)
+			{
+				OutChanges.Closed.Add(Window.StateTag);
+			}
+		}
+	}
+
+	const float LastPosition = Active.LastPosition;
+	Active.LastPosition = Position;
+
+	if (!bDrivesCombatNotifies)
+	{
+		return;
+	}
+
+	bool bShouldTrace = false;
+
+	for (const FMeleeTraceSpan& TraceWindow : Active.Timeline->TraceWindows)
+	{
+		if (TraceWindow.StartTime > Position)
+		{
+			break;
+		}
+
+		bShouldTrace |= Position < TraceWindow.EndTime;
+	}
+
+	if (bShouldTrace != Active.bTracing)
+	{
+		Active.bTracing = bShouldTrace;
+		++(bShouldTrace ? OutChanges.TraceBegins : OutChanges.TraceEnds);
+		OutChanges.TraceLabel = Active.Montage->GetFName();
+	}
+
+	// Jumping back to an earlier section replays the flushes up to the new position
+	const float FlushFrom = Position < LastPosition ? TNumericLimits<float>::Lowest() : LastPosition;
+
+	for (const float FlushTime : Active.Timeline->BufferFlushTimes)
+	{
+		if (FlushTime > Position)
+		{
+			break;
+		}
+
+		OutChanges.BufferFlushes += FlushTime > FlushFrom ? 1 : 0;
+	}
+}
+
+void UStateWindowComponent::ApplyChanges(const FWindowChanges& Changes)
+{
+	// Opening first keeps a tag continuous when one window hands over to another in the same frame.
+	// Removing a tag may activate abilities that play montages, so nothing here touches ActiveMontages.
+	for (const FGameplayTag& StateTag : Changes.Opened)
+	{
+		OpenWindow(StateTag);
+	}
+
+	for (const FGameplayTag& StateTag : Changes.Closed)
+	{
+		CloseWindow(StateTag);
+	}
+
+	// A swing ending in one montage while the next begins in another resets between them
+	for (int32 Index = 0; Index < Changes.TraceEnds; ++Index)
+	{
+		SetMeleeTrace(false, Changes.TraceLabel);
+	}
+
+	for (int32 Index = 0; Index < Changes.TraceBegins; ++Index)
+	{
+		SetMeleeTrace(true, Changes.TraceLabel);
+	}
+
+	if (Changes.BufferFlushes > 0)
+	{
+		APlayerCharacter* PlayerCharacter = GetOwner<APlayerCharacter>();
+
+		// Buffered input belongs to the owning client, as in UFireBufferedInputAnimNotify
+		if (PlayerCharacter && PlayerCharacter->IsLocallyControlled())
+		{
+			PlayerCharacter->FlushBufferedInput();
+		}
+	}
+}
+
+void UStateWindowComponent::SetMeleeTrace(bool bTrace, FName Label)
+{
+	AFighterCharacter* FighterCharacter = GetOwner<AFighterCharacter>();
+
+	if (!FighterCharacter)
+	{
+		return;
+	}
+
+	if (bTrace)
+	{
+		FighterCharacter->BeginMeleeSwing();
+		FighterCharacter->GetWeapon()->BeginTrace();
+		RECORD_COMBAT_EVENT(FighterCharacter, TraceBegin, Label);
+	}
+	else
+	{
+		FighterCharacter->ResetMeleeSwing();
+		FighterCharacter->GetWeapon()->EndTrace();
+		RECORD_COMBAT_EVENT(FighterCharacter, TraceEnd, Label);
+	}
+}
+
+bool UStateWindowComponent::NeedsEvaluation(const FMontageNotifyTimeline& Timeline) const
+{
+	return !Timeline.Windows.IsEmpty() || (bDrivesCombatNotifies && (!Timeline.TraceWindows.IsEmpty() || !Timeline.BufferFlushTimes.IsEmpty()));
+}
+
+UAbilitySystemComponent* UStateWindowComponent::GetAbilitySystemComponent() const
+{
+	return UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(GetOwner());
+}
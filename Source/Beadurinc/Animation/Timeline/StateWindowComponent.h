@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "StateWindowComponent.generated.h"
+
+class UAbilitySystemComponent;
+class UAnimInstance;
+class UAnimMontage;
+struct FMontageNotifyTimeline;
+
+/**
+ * Holds the state tags opened by UStateWindowAnimNotifyState windows of the owner's montages.
+ *
+ * Windows are reference counted per tag: the loose tag is added when the first window of a tag
+ * opens and removed only when the last one closes. Blending montages or overlapping windows of
+ * the same tag therefore no longer remove a tag another window still needs.
+ *
+ * Windows are evaluated from each playing montage's precomputed timeline against its current
+ * position, and every window a montage opened is closed when that montage is interrupted or ends.
+ *
+ * On dedicated servers the component also drives the melee trace windows and buffer flushes from
+ * the timeline. Combat windows then open and close by montage time alone, whether or not the mesh
+ * evaluates poses, and the matching notifies stand down.
+ */
+UCLASS(ClassGroup = (Beadurinc), meta = (BlueprintSpawnableComponent))
+class BEADURINC_API UStateWindowComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	/** A montage currently playing on the owner and the windows of it that are open */
+	struct FActiveMontageWindows
+	{
+		TWeakObjectPtr<UAnimMontage> Montage;
+		const FMontageNotifyTimeline* Timeline = nullptr;
+		uint64 OpenMask = 0;
+		
+		/** Whether this montage's trace windows have the weapon sweeping */
+		bool bTracing = false;
+		
+		/** Position evaluated last. Windows and buffer flushes past it and up to the current position were played over */
+		float LastPosition = TNumericLimits<float>::Lowest();
+		
+		/** Windows handed over ahead of the timeline, held until the montage closes a window of the same tag */
+		TArray<FGameplayTag, TInlineAllocator<2>> LeadingTags;
+	};
+
+	/** Window transitions found while evaluating, applied once evaluation is done */
+	struct FWindowChanges
+	{
+		TArray<FGameplayTag, TInlineAllocator<4>> Opened;
+		TArray<FGameplayTag, TInlineAllocator<4>> Closed;
+		int32 TraceBegins = 0;
+		int32 TraceEnds = 0;
+		int32 BufferFlushes = 0;
+		FName TraceLabel;
+	};
+
+public:
+
+	UStateWindowComponent();
+
+	/** Opens a window of the given tag. Adds the loose tag if this is the first open window of it */
+	void OpenWindow(const FGameplayTag& StateTag);
+
+	/** Closes a window of the given tag. Removes the loose tag when no window of it remains open */
+	void CloseWindow(const FGameplayTag& StateTag);
+
+	/**
+	 * Hands a window opened with OpenWindow over to a playing montage. It then closes together with
+	 * the montage's own window of that tag, or when the montage stops, so abilities can lock a state
+	 * before playing a montage whose window begins a few frames later. Closes right away if the
+	 * montage is not playing.
+	 */
+	void HandOverWindow(const UAnimMontage* Montage, const FGameplayTag& StateTag);
+
+	/** Returns how many windows of the given tag are open */
+	FORCEINLINE int32 GetWindowCount(const FGameplayTag& StateTag) const { return WindowCounts.FindRef(StateTag); }
+
+	/** Returns true when melee traces and buffer flushes are driven from montage timelines instead of their notifies */
+	FORCEINLINE bool DrivesCombatNotifies() const { return bDrivesCombatNotifies; }
+
+protected:
+
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+
+	UFUNCTION()
+	void OnMontageStarted(UAnimMontage* Montage);
+
+	UFUNCTION()
+	void OnMontageBlendingOut(UAnimMontage* Montage, bool bInterrupted);
+
+	UFUNCTION()
+	void OnMontageEnded(UAnimMontage* Montage, bool bInterrupted);
+
+	/** Closes every window the montage opened and stops tracking it */
+	void ReleaseMontage(const UAnimMontage* Montage);
+
+	/** Finds the windows of a montage to open and close to match its position */
+	void EvaluateMontage(FActiveMontageWindows& Active, float Position, FWindowChanges& OutChanges);
+
+	/** Opens and closes the windows found by EvaluateMontage */
+	void ApplyChanges(const FWindowChanges& Changes);
+
+	/** Starts or stops sweeping the owner's weapon, as UMeleeTraceAnimationNotify does */
+	void SetMeleeTrace(bool bTrace, FName Label);
+
+	/** Returns true when a montage of this timeline has anything for this component to evaluate */
+	bool NeedsEvaluation(const FMontageNotifyTimeline& Timeline) const;
+
+	/** Returns the ASC of the owner, which may live on the PlayerState */
+	UAbilitySystemComponent* GetAbilitySystemComponent() const;
+
+private:
+
+	/** Anim instance of the owner's mesh whose montage events are bound */
+	TWeakObjectPtr<UAnimInstance> AnimInstance;
+
+	/** Montages being tracked, usually one or two while blending */
+	TArray<FActiveMontageWindows> ActiveMontages;
+
+	/** Open window count per tag */
+	TMap<FGameplayTag, int32> WindowCounts;
+
+	/** Set on dedicated servers, where the mesh may not evaluate poses and notifies are not relied on */
+	bool bDrivesCombatNotifies = false;
+};
@@ -22,11 +22,23 @@ public class Beadurinc : ModuleRules
 			"GameplayAbilities",
 			"GameplayTasks",
 			"GameplayTags",
-			"MotionWarping"
+			"MotionWarping",
+			"Niagara",
+			"DeveloperSettings",
+			"ReplicationGraph"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
 
+		// Commandlets that migrate blueprint content
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "UnrealEd", "BlueprintGraph" });
+		}
+
+		// Gameplay debugger categories are only registered in builds the engine enables the debugger for
+		SetupGameplayDebuggerSupport(Target);
+
 		PublicIncludePaths.AddRange(new string[] {
 			"Beadurinc"
 		});
@@ -2,7 +2,53 @@
 
 #include "Beadurinc.h"
 #include "Modules/ModuleManager.h"
+#include "Combat/Debug/CombatHitchMonitor.h"
+#include "GameData/BeadurincReplicationGraph.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Beadurinc, "Beadurinc" );
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "Combat/Debug/GameplayDebuggerCategory_CombatTimeline.h"
+#endif
 
-DEFINE_LOG_CATEGORY(LogBeadurinc)
\ No newline at end of file
+/** Game module, registers the project's debugging tools, starts the hitch monitor and installs the replication graph */
+class FBeadurincModule : public FDefaultGameModuleImpl
+{
+public:
+	
+	virtual void StartupModule() override
+	{
+		FCombatHitchMonitor::Startup();
+		
+		UReplicationDriver::CreateReplicationDriverDelegate().BindStatic(&UBeadurincReplicationGraph::CreateForNetDriver);
+		
+#if WITH_GAMEPLAY_DEBUGGER
+		IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+		GameplayDebugger.RegisterCategory(
+			TEXT("CombatTimeline"),
+			IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_CombatTimeline::MakeInstance),
+			EGameplayDebuggerCategoryState::EnabledInGameAndSimulate
+		);
+		GameplayDebugger.NotifyCategoriesChanged();
+#endif
+	}
+	
+	virtual void ShutdownModule() override
+	{
+#if WITH_GAMEPLAY_DEBUGGER
+		if (IGameplayDebugger::IsAvailable())
+		{
+			IGameplayDebugger& GameplayDebugger = IGameplayDebugger::Get();
+			GameplayDebugger.UnregisterCategory(TEXT("CombatTimeline"));
+			GameplayDebugger.NotifyCategoriesChanged();
+		}
+#endif
+		
+		UReplicationDriver::CreateReplicationDriverDelegate().Unbind();
+		
+		FCombatHitchMonitor::Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FBeadurincModule, Beadurinc, "Beadurinc" );
+
+DEFINE_LOG_CATEGORY(LogBeadurinc)
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Combat/CombatAreaShape.h"
+#include "Combat/CombatAttackSourceInterface.h"
+#include "AreaAttackDataAsset.generated.h"
+
+class UAnimMontage;
+
+/** One hit of an area attack: where it lands and when */
+USTRUCT(BlueprintType)
+struct FAreaAttackPulse
+{
+	GENERATED_BODY()
+	
+	/** Seconds after the attack starts */
+	UPROPERTY(EditAnywhere, Category = "Pulse", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float Time = 0.0F;
+	
+	/** Area covered, placed relative to the attacker at that moment */
+	UPROPERTY(EditAnywhere, Category = "Pulse")
+	FCombatAreaShape Shape;
+	
+	/** Damage attribute provided to the attacker for every fighter inside */
+	UPROPERTY(EditAnywhere, Category = "Pulse")
+	float Damage = 0.0F;
+};
+
+/**
+ * An attack that hits every hostile fighter inside an area, e.g. a ground slam or a sweeping
+ * cleave. Played by UAreaAttackGameplayAbility: the montage plays while each pulse is resolved
+ * by the combat spatial index at its time.
+ */
+UCLASS(BlueprintType)
+class BEADURINC_API UAreaAttackDataAsset : public UDataAsset, public ICombatAttackSourceInterface
+{
+	GENERATED_BODY()
+	
+	/** Montage played by the attacker */
+	UPROPERTY(EditAnywhere, Category = "Animation")
+	TObjectPtr<UAnimMontage> Montage;
+	
+	/** Hits of the attack, in any order */
+	UPROPERTY(EditAnywhere, Category = "Attack")
+	TArray<FAreaAttackPulse> Pulses;
+	
+	/** Row of the combat resolution table hits of this attack are resolved with */
+	UPROPERTY(EditAnywhere, Category = "Attack")
+	ECombatAttackType AttackType = ECombatAttackType::Heavy;
+	
+public:
+	
+	FORCEINLINE UAnimMontage* GetMontage() const { return Montage; }
+	
+	FORCEINLINE const TArray<FAreaAttackPulse>& GetPulses() const { return Pulses; }
+	
+	FORCEINLINE virtual ECombatAttackType GetAttackType() const override { return AttackType; }
+};
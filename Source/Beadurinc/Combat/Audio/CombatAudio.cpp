@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Audio/CombatAudio.h"
+
+void CombatAudio::DecideCombatSounds
+(
+	TConstArrayView<FCombatSoundRequest> Requests,
+	TConstArrayView<FVector> Listeners,
+	TConstArrayView<FCombatSoundBudget> Budgets,
+	TConstArrayView<int32> ActiveVoices,
+	TArrayView<ECombatSoundDecision> OutDecisions
+)
+{
+	constexpr int32 CategoryCount = static_cast<int32>(ECombatSoundCategory::MAX);
+	
+	check(Budgets.Num() == CategoryCount && ActiveVoices.Num() == CategoryCount && OutDecisions.Num() == Requests.Num());
+	
+	const int32 Num = Requests.Num();
+	
+	// Distance of every request to its nearest listener
+	TArray<double, TInlineAllocator<64>> DistancesSquared;
+	DistancesSquared.SetNumUninitialized(Num);
+	
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		double Nearest = Listeners.IsEmpty() ? 0.0 : TNumericLimits<double>::Max();
+		
+		for (const FVector& Listener : Listeners)
+		{
+			Nearest = FMath::Min(Nearest, FVector::DistSquared(Listener, Requests[Index].Location));
+		}
+		
+		DistancesSquared[Index] = Nearest;
+	}
+	
+	// Serve each category nearest first. Ties keep the order of the requests, so decisions are stable
+	TArray<int32, TInlineAllocator<64>> Order;
+	Order.SetNumUninitialized(Num);
+	
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Order[Index] = Index;
+	}
+	
+	Order.Sort([&Requests, &DistancesSquared](int32 A, int32 B)
+	{
+		if (Requests[A].Category != Requests[B].Category)
+		{
+			return Requests[A].Category < Requests[B].Category;
+		}
+		
+		return DistancesSquared[A] != DistancesSquared[B] ? DistancesSquared[A] < DistancesSquared[B] : A < B;
+	});
+	
+	int32 Voices[CategoryCount];
+	
+	for (int32 Category = 0; Category < CategoryCount; ++Category)
+	{
+		Voices[Category] = ActiveVoices[Category];
+	}
+	
+	TArray<int32, TInlineAllocator<64>> Played;
+	
+	for (const int32 Index : Order)
+	{
+		const FCombatSoundRequest& Request = Requests[Index];
+		const int32 Category = static_cast<int32>(Request.Category);
+		const FCombatSoundBudget& Budget = Budgets[Category];
+		
+		if (DistancesSquared[Index] > FMath::Square(static_cast<double>(Budget.MaxDistance)))
+		{
+			OutDecisions[Index] = ECombatSoundDecision::Virtualized;
+			continue;
+		}
+		
+		const double MergeRadiusSquared = FMath::Square(static_cast<double>(Budget.MergeRadius));
+		bool bMerged = false;
+		
+		for (const int32 PlayedIndex : Played)
+		{
+			if (Requests[PlayedIndex].Sound == Request.Sound && FVector::DistSquared(Requests[PlayedIndex].Location, Request.Location) <= MergeRadiusSquared)
+			{
+				bMerged = true;
+				break;
+			}
+		}
+		
+		if (bMerged)
+		{
+			OutDecisions[Index] = ECombatSoundDecision::Merged;
+		}
+		else if (Voices[Category] >= Budget.MaxVoices)
+		{
+			OutDecisions[Index] = ECombatSoundDecision::Virtualized;
+		}
+		else
+		{
+			OutDecisions[Index] = ECombatSoundDecision::Play;
+			++Voices[Category];
+			Played.Add(Index);
+		}
+	}
+}
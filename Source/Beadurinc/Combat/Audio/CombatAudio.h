@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatAudio.generated.h"
+
+class USoundBase;
+
+/** Kinds of combat sound, each with a voice budget of its own */
+UENUM(BlueprintType)
+enum class ECombatSoundCategory : uint8
+{
+	Swing,
+	Hit,
+	Block,
+	Movement,
+	
+	MAX UMETA(Hidden)
+};
+
+/** How many sounds of a category may play at once, and which requests are not worth a voice */
+USTRUCT()
+struct FCombatSoundBudget
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(Config, EditAnywhere, Category = "Budget")
+	ECombatSoundCategory Category = ECombatSoundCategory::Hit;
+	
+	/** Most voices of the category playing at once */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0"))
+	int32 MaxVoices = 4;
+	
+	/** The same sound requested closer than this to one played the same frame is merged into it */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float MergeRadius = 150.0F;
+	
+	/** Requests farther than this from every listener are not played */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float MaxDistance = 4000.0F;
+};
+
+/** A sound some combat event wants to play this frame */
+struct FCombatSoundRequest
+{
+	const USoundBase* Sound = nullptr;
+	FVector Location = FVector::ZeroVector;
+	ECombatSoundCategory Category = ECombatSoundCategory::Hit;
+};
+
+/** What became of a request */
+enum class ECombatSoundDecision : uint8
+{
+	/** Takes a voice */
+	Play,
+	
+	/** Heard through an identical sound played nearby */
+	Merged,
+	
+	/** Out of range or over budget, never reaches the mixer */
+	Virtualized
+};
+
+namespace CombatAudio
+{
+	/**
+	 * Decides which of a frame's requests get a voice. A pure function of its arguments, so it can
+	 * be tested without an audio device.
+	 *
+	 * Requests of a category are served nearest to a listener first. A request is virtualized when
+	 * every listener is farther than its category's MaxDistance, merged when the same sound was
+	 * played within MergeRadius before it in this batch, and virtualized when its category already
+	 * has MaxVoices playing. Without listeners every request is considered next to one.
+	 *
+	 * @param Budgets		One budget per category, indexed by category
+	 * @param ActiveVoices	Voices of each category still playing from earlier frames, indexed by category
+	 * @param OutDecisions	One decision per request, in the order of Requests
+	 */
+	BEADURINC_API void DecideCombatSounds
+	(
+		TConstArrayView<FCombatSoundRequest> Requests,
+		TConstArrayView<FVector> Listeners,
+		TConstArrayView<FCombatSoundBudget> Budgets,
+		TConstArrayView<int32> ActiveVoices,
+		TArrayView<ECombatSoundDecision> OutDecisions
+	);
+}
@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Audio/CombatAudioSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+bool UCombatAudioSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+	
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UCombatAudioSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	for (int32 Category = 0; Category < static_cast<int32>(ECombatSoundCategory::MAX); ++Category)
+	{
+		CategoryBudgets[Category].Category = static_cast<ECombatSoundCategory>(Category);
+	}
+	
+	for (const FCombatSoundBudget& Budget : Budgets)
+	{
+		if (Budget.Category < ECombatSoundCategory::MAX)
+		{
+			CategoryBudgets[static_cast<int32>(Budget.Category)] = Budget;
+		}
+	}
+}
+
+void UCombatAudioSubsystem::RequestSound(USoundBase* Sound, ECombatSoundCategory Category, const FVector& Location)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	if (Sound && Category < ECombatSoundCategory::MAX)
+	{
+		PendingRequests.Add({ Sound, Location, Category });
+	}
+}
+
+void UCombatAudioSubsystem::PlayCombatSound(const UObject* WorldContextObject, USoundBase* Sound, ECombatSoundCategory Category, const FVector& Location)
+{
+	if (!Sound)
+	{
+		return;
+	}
+	
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	
+	if (UCombatAudioSubsystem* CombatAudio = World ? World->GetSubsystem<UCombatAudioSubsystem>() : nullptr)
+	{
+		CombatAudio->RequestSound(Sound, Category, Location);
+	}
+	else
+	{
+		UGameplayStatics::PlaySoundAtLocation(WorldContextObject, Sound, Location);
+	}
+}
+
+void UCombatAudioSubsystem::Tick(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_Audio);
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	Super::Tick(DeltaTime);
+	
+	UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	
+	// Release the voices whose sound has ended
+	int32 ActiveVoices[static_cast<int32>(ECombatSoundCategory::MAX)];
+	
+	for (int32 Category = 0; Category < static_cast<int32>(ECombatSoundCategory::MAX); ++Category)
+	{
+		VoiceEndTimes[Category].RemoveAllSwap([Now](double EndTime) { return EndTime <= Now; }, EAllowShrinking::No);
+		ActiveVoices[Category] = VoiceEndTimes[Category].Num();
+	}
+	
+	if (PendingRequests.IsEmpty())
+	{
+		return;
+	}
+	
+	// Every local player hears the world from its own listener
+	TArray<FVector, TInlineAllocator<4>> Listeners;
+	
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		
+		if (PlayerController && PlayerController->IsLocalController())
+		{
+			FVector Location;
+			FVector FrontDirection;
+			FVector RightDirection;
+			
+			PlayerController->GetAudioListenerPosition(Location, FrontDirection, RightDirection);
+			Listeners.Add(Location);
+		}
+	}
+	
+	Decisions.SetNumUninitialized(PendingRequests.Num(), EAllowShrinking::No);
+	CombatAudio::DecideCombatSounds(PendingRequests, Listeners, MakeArrayView(CategoryBudgets), MakeArrayView(ActiveVoices), Decisions);
+	
+	for (int32 Index = 0; Index < PendingRequests.Num(); ++Index)
+	{
+		const FCombatSoundRequest& Request = PendingRequests[Index];
+		
+		switch (Decisions[Index])
+		{
+		case ECombatSoundDecision::Play:
+		{
+			USoundBase* Sound = const_cast<USoundBase*>(Request.Sound);
+			COMBAT_COUNT(Spawns);
+			UGameplayStatics::PlaySoundAtLocation(World, Sound, Request.Location);
+			
+			VoiceEndTimes[static_cast<int32>(Request.Category)].Add(Now + FMath::Clamp(Sound->GetDuration(), 0.0F, MaxVoiceSeconds));
+			break;
+		}
+		case ECombatSoundDecision::Merged:
+			COMBAT_COUNT(SoundsMerged);
+			break;
+		case ECombatSoundDecision::Virtualized:
+			COMBAT_COUNT(SoundsVirtualized);
+			break;
+		}
+	}
+	
+	PendingRequests.Reset();
+}
+
+TStatId UCombatAudioSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_Combat_Audio);
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/Audio/CombatAudio.h"
+#include "CombatAudioSubsystem.generated.h"
+
+class USoundBase;
+
+/**
+ * Plays the world's combat sounds within a voice budget per category.
+ *
+ * Swings, hits, blocks and rolls request their sounds here instead of playing them. Requests
+ * are collected over the frame and decided together on tick by CombatAudio::DecideCombatSounds:
+ * nearest to a listener first, identical sounds close together merged into one voice, and the
+ * rest virtualized once a category runs out of voices. Voices are counted for the duration of
+ * their sound, so a budget holds across frames.
+ *
+ * Not created on dedicated servers, which have no audio.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UCombatAudioSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+	
+	/** Budgets of the categories. Categories without an entry use the defaults of FCombatSoundBudget */
+	UPROPERTY(Config)
+	TArray<FCombatSoundBudget> Budgets;
+	
+	/** Longest a voice is counted for, so looping or long sounds cannot hold a budget forever */
+	UPROPERTY(Config)
+	float MaxVoiceSeconds = 3.0F;
+	
+public:
+	
+	/** Asks for a sound to be played at a location by the end of this frame */
+	void RequestSound(USoundBase* Sound, ECombatSoundCategory Category, const FVector& Location);
+	
+	/** Returns the budget of a category */
+	FORCEINLINE const FCombatSoundBudget& GetBudget(ECombatSoundCategory Category) const { return CategoryBudgets[static_cast<int32>(Category)]; }
+	
+	/** Returns the voices of a category counted as playing */
+	FORCEINLINE int32 GetActiveVoices(ECombatSoundCategory Category) const { return VoiceEndTimes[static_cast<int32>(Category)].Num(); }
+	
+	/**
+	 * Plays a combat sound through the world's combat audio, or directly where there is none
+	 * (editor previews). Null sounds are ignored.
+	 */
+	static void PlayCombatSound(const UObject* WorldContextObject, USoundBase* Sound, ECombatSoundCategory Category, const FVector& Location);
+	
+protected:
+	
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	
+	virtual void Tick(float DeltaTime) override;
+	
+	virtual TStatId GetStatId() const override;
+	
+private:
+	
+	/** Budgets indexed by category, compiled from Budgets */
+	FCombatSoundBudget CategoryBudgets[static_cast<int32>(ECombatSoundCategory::MAX)];
+	
+	/** World times the counted voices of each category end at */
+	TArray<double> VoiceEndTimes[static_cast<int32>(ECombatSoundCategory::MAX)];
+	
+	/** Requests since the last tick. Sounds are referenced by whoever requested them for the frame */
+	TArray<FCombatSoundRequest> PendingRequests;
+	
+	/** Decisions of the running tick, kept to reuse their memory */
+	TArray<ECombatSoundDecision> Decisions;
+};
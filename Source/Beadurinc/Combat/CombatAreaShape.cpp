@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatAreaShape.h"
+
+bool FCombatAreaShape::Overlaps(const FTransform& Transform, const FVector& BodyCenter, float BodyRadius, float BodyHalfHeight, FVector& OutClosest) const
+{
+	// Everything is tested in the space of the area, where the body stays upright as long as the area is
+	const FVector Local = Transform.InverseTransformPositionNoScale(BodyCenter);
+	const double SegmentHalfHeight = FMath::Max(BodyHalfHeight - BodyRadius, 0.0F);
+	
+	switch (Type)
+	{
+	case ECombatAreaShapeType::Sphere:
+	{
+		// Closest point of the body's axis to the center
+		const FVector OnAxis(Local.X, Local.Y, FMath::Clamp(0.0, Local.Z - SegmentHalfHeight, Local.Z + SegmentHalfHeight));
+		OutClosest = Transform.TransformPositionNoScale(OnAxis.GetClampedToMaxSize(Radius));
+		return OnAxis.SizeSquared() <= FMath::Square(Radius + BodyRadius);
+	}
+	case ECombatAreaShapeType::Box:
+	{
+		const FVector Clamped = Local.BoundToBox(-HalfExtent, HalfExtent);
+		OutClosest = Transform.TransformPositionNoScale(Clamped);
+		return FMath::Abs(Local.X) <= HalfExtent.X + BodyRadius
+			&& FMath::Abs(Local.Y) <= HalfExtent.Y + BodyRadius
+			&& FMath::Abs(Local.Z) <= HalfExtent.Z + BodyHalfHeight;
+	}
+	case ECombatAreaShapeType::Sector:
+	{
+		const double Distance2D = Local.Size2D();
+		OutClosest = Transform.TransformPositionNoScale(FVector(Local.X, Local.Y, 0.0).GetClampedToMaxSize(Radius) + FVector(0.0, 0.0, FMath::Clamp(Local.Z, -static_cast<double>(HalfHeight), static_cast<double>(HalfHeight))));
+		
+		if (Distance2D > Radius + BodyRadius || FMath::Abs(Local.Z) > HalfHeight + BodyHalfHeight)
+		{
+			return false;
+		}
+		
+		// A body standing on the apex is always inside. Otherwise its radius widens the angle it can be seen at
+		if (Distance2D <= BodyRadius)
+		{
+			return true;
+		}
+		
+		const double BodyHalfAngle = FMath::Asin(FMath::Min(BodyRadius / Distance2D, 1.0));
+		const double Angle = FMath::Atan2(FMath::Abs(Local.Y), Local.X);
+		return Angle <= FMath::DegreesToRadians(HalfAngle) + BodyHalfAngle;
+	}
+	}
+	
+	return false;
+}
+
+float FCombatAreaShape::GetBoundingRadius() const
+{
+	return Type == ECombatAreaShapeType::Box ? FVector2D(HalfExtent.X, HalfExtent.Y).Size() : Radius;
+}
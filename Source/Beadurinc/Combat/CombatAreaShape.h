@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatAreaShape.generated.h"
+
+/** Kinds of area an area attack covers */
+UENUM(BlueprintType)
+enum class ECombatAreaShapeType : uint8
+{
+	/** Everything within Radius of the center, e.g. a ground slam */
+	Sphere,
+	
+	/** An oriented box, e.g. a shockwave running forward */
+	Box,
+	
+	/** A slice of a cylinder facing forward, e.g. a sweeping cleave */
+	Sector,
+};
+
+/** An area in the space of the fighter attacking: X forward, Z up */
+USTRUCT(BlueprintType)
+struct BEADURINC_API FCombatAreaShape
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, Category = "Shape")
+	ECombatAreaShapeType Type = ECombatAreaShapeType::Sphere;
+	
+	/** Center of the area relative to the attacker */
+	UPROPERTY(EditAnywhere, Category = "Shape")
+	FVector Offset = FVector::ZeroVector;
+	
+	/** Radius of a sphere or sector */
+	UPROPERTY(EditAnywhere, Category = "Shape", meta = (ClampMin = "0.0", Units = "Centimeters", EditCondition = "Type != ECombatAreaShapeType::Box", EditConditionHides))
+	float Radius = 300.0F;
+	
+	/** Half size of a box */
+	UPROPERTY(EditAnywhere, Category = "Shape", meta = (EditCondition = "Type == ECombatAreaShapeType::Box", EditConditionHides))
+	FVector HalfExtent = FVector(200.0, 100.0, 100.0);
+	
+	/** Half of the angle a sector spans around the forward axis */
+	UPROPERTY(EditAnywhere, Category = "Shape", meta = (ClampMin = "0.0", ClampMax = "180.0", Units = "Degrees", EditCondition = "Type == ECombatAreaShapeType::Sector", EditConditionHides))
+	float HalfAngle = 60.0F;
+	
+	/** Half height of a sector */
+	UPROPERTY(EditAnywhere, Category = "Shape", meta = (ClampMin = "0.0", Units = "Centimeters", EditCondition = "Type == ECombatAreaShapeType::Sector", EditConditionHides))
+	float HalfHeight = 100.0F;
+	
+	/**
+	 * Returns whether a standing body overlaps the area placed at Transform, the body being
+	 * a vertical capsule. OutClosest is the point of the area closest to the body's center.
+	 */
+	bool Overlaps(const FTransform& Transform, const FVector& BodyCenter, float BodyRadius, float BodyHalfHeight, FVector& OutClosest) const;
+	
+	/** Returns the horizontal radius around the area's center that bounds the whole area */
+	float GetBoundingRadius() const;
+};
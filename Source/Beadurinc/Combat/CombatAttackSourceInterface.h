@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Interface.h"
+#include "Combat/CombatResolutionTable.h"
+#include "CombatAttackSourceInterface.generated.h"
+
+/// Whatever deals a hit: a held weapon, a projectile or an area attack.
+/// 
+/// Sent as the OptionalObject of Event.Combat.Hit, so the defender can
+/// resolve the hit against the row of its attack type without knowing
+/// which kind of attack landed.
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UCombatAttackSourceInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class ICombatAttackSourceInterface
+{
+	GENERATED_BODY()
+public:
+	
+	/** Returns the row of the combat resolution table hits of this source are resolved with */
+	virtual ECombatAttackType GetAttackType() const = 0;
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Object channel the weapon colliders belong to. Declared as "Weapon" in DefaultEngine.ini
+#define ECC_Weapon ECC_GameTraceChannel1
+
+// Trace channel used by weapon traces and sweeps. Only fighter capsules respond to it (Overlap),
+// so world geometry and other non-combat bodies never show up in melee queries.
+// Declared as "WeaponTrace" in DefaultEngine.ini
+#define ECC_WeaponTrace ECC_GameTraceChannel2
+
+namespace CombatCollision
+{
+	/** Collision profile for weapon colliders: query only, overlaps Pawn and ignores everything else */
+	inline const FName WeaponTraceProfile = TEXT("WeaponTrace");
+}
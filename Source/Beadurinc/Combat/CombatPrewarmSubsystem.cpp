@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatPrewarmSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystem/AbilitySet/FighterAbilitySet.h"
+#include "AbilitySystem/GameplayCue/GameplayCueEffectPoolSubsystem.h"
+#include "AbilitySystem/GameplayCue/PooledBurstGameplayCueNotify.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Beadurinc.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameData/BeadurincPlayerState.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameplayCueManager.h"
+#include "GameplayCueSet.h"
+#include "Combat/CombatStats.h"
+
+bool UCombatPrewarmSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+	
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UCombatPrewarmSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	
+	SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddUObject(this, &UCombatPrewarmSubsystem::OnSyncLoadPackage);
+}
+
+void UCombatPrewarmSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	
+	PrewarmStartTime = FPlatformTime::Seconds();
+	
+	TArray<FSoftObjectPath> FighterPaths;
+	
+	for (const TSoftClassPtr<AActor>& Fighter : Fighters)
+	{
+		if (!Fighter.IsNull())
+		{
+			FighterPaths.Add(Fighter.ToSoftObjectPath());
+		}
+	}
+	
+	if (FighterPaths.IsEmpty())
+	{
+		OnFightersLoaded();
+		return;
+	}
+	
+	// Fighters hold their weapons, montages and hit reactions directly, so those come along
+	LoadHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(FighterPaths),
+		FStreamableDelegate::CreateWeakLambda(this, [this] { OnFightersLoaded(); })
+	));
+}
+
+void UCombatPrewarmSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+	SyncLoadHandle.Reset();
+	
+	for (const TSharedPtr<FStreamableHandle>& Handle : LoadHandles)
+	{
+		if (Handle.IsValid())
+		{
+			Handle->CancelHandle();
+		}
+	}
+	
+	LoadHandles.Empty();
+	
+	Super::Deinitialize();
+}
+
+void UCombatPrewarmSubsystem::OnFightersLoaded()
+{
+	TArray<const UFighterAbilitySet*, TInlineAllocator<4>> AbilitySets;
+	
+	for (const TSoftClassPtr<AActor>& Fighter : Fighters)
+	{
+		const AFighterCharacter* Defaults = Fighter.IsValid() ? Cast<AFighterCharacter>(Fighter->GetDefaultObject()) : nullptr;
+		
+		if (Defaults && Defaults->GetAbilitySet())
+		{
+			AbilitySets.AddUnique(Defaults->GetAbilitySet());
+		}
+	}
+	
+	// Players are granted their abilities by their player state
+	const UWorld* World = GetWorld();
+	const AGameModeBase* GameMode = World->GetAuthGameMode();
+	const AGameStateBase* GameState = World->GetGameState();
+	
+	if (!GameMode && GameState && GameState->GameModeClass)
+	{
+		GameMode = GameState->GameModeClass->GetDefaultObject<AGameModeBase>();
+	}
+	
+	if (const ABeadurincPlayerState* PlayerState = GameMode && GameMode->PlayerStateClass ? Cast<ABeadurincPlayerState>(GameMode->PlayerStateClass->GetDefaultObject()) : nullptr)
+	{
+		if (PlayerState->GetAbilitySet())
+		{
+			AbilitySets.AddUnique(PlayerState->GetAbilitySet());
+		}
+	}
+	
+	TArray<FSoftObjectPath> Paths;
+	
+	for (const UFighterAbilitySet* AbilitySet : AbilitySets)
+	{
+		Paths.Append(AbilitySet->GetClassPaths());
+	}
+	
+	GatherCueNotifyPaths(CueNotifyPaths);
+	Paths.Append(CueNotifyPaths);
+	
+	if (Paths.IsEmpty())
+	{
+		OnAbilitiesAndCuesLoaded();
+		return;
+	}
+	
+	LoadHandles.Add(UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths),
+		FStreamableDelegate::CreateWeakLambda(this, [this] { OnAbilitiesAndCuesLoaded(); })
+	));
+}
+
+void UCombatPrewarmSubsystem::OnAbilitiesAndCuesLoaded()
+{
+	// Dedicated servers play no cues and have no pool
+	if (UGameplayCueEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UGameplayCueEffectPoolSubsystem>())
+	{
+		for (const FSoftObjectPath& Path : CueNotifyPaths)
+		{
+			const UClass* NotifyClass = Cast<UClass>(Path.ResolveObject());
+			const UPooledBurstGameplayCueNotify* Notify = NotifyClass ? Cast<UPooledBurstGameplayCueNotify>(NotifyClass->GetDefaultObject()) : nullptr;
+			
+			if (Notify)
+			{
+				EffectPool->PrewarmEffect(Notify->GetEffect(), PooledEffectsPerCue);
+			}
+		}
+	}
+	
+	bPrewarmed = true;
+	
+	UE_LOG(LogBeadurinc, Log, TEXT("Combat prewarm finished in %.2fs"), FPlatformTime::Seconds() - PrewarmStartTime);
+}
+
+void UCombatPrewarmSubsystem::GatherCueNotifyPaths(TArray<FSoftObjectPath>& OutPaths) const
+{
+	const UGameplayCueManager* CueManager = UAbilitySystemGlobals::Get().GetGameplayCueManager();
+	const UGameplayCueSet* CueSet = CueManager ? CueManager->GetRuntimeCueSet() : nullptr;
+	
+	if (!CueSet || CueTags.IsEmpty())
+	{
+		return;
+	}
+	
+	for (const FGameplayCueNotifyData& CueData : CueSet->GameplayCueData)
+	{
+		if (CueData.GameplayCueTag.MatchesAny(CueTags) && CueData.GameplayCueNotifyObj.IsValid())
+		{
+			OutPaths.AddUnique(CueData.GameplayCueNotifyObj);
+		}
+	}
+}
+
+void UCombatPrewarmSubsystem::OnSyncLoadPackage(const FString& PackageName)
+{
+	// Loading screens and level loads are expected to block, fights are not
+	if (!IsInGameThread() || !GetWorld()->HasBegunPlay() || !IsCombatActive())
+	{
+		return;
+	}
+	
+	COMBAT_COUNT(SyncLoads);
+	CSV_EVENT_GLOBAL(TEXT("SyncLoad %s"), *PackageName);
+	
+	UE_LOG(LogBeadurinc, Warning, TEXT("%s was loaded synchronously during combat. Add what references it to the combat prewarm"), *PackageName);
+}
+
+bool UCombatPrewarmSubsystem::IsCombatActive() const
+{
+	// Only runs on a synchronous load, which is rare enough to afford walking the fighters
+	for (TActorIterator<AFighterCharacter> It(GetWorld()); It; ++It)
+	{
+		const UAbilitySystemComponent* AbilitySystemComponent = It->GetAbilitySystemComponent();
+		
+		if (!AbilitySystemComponent)
+		{
+			continue;
+		}
+		
+		for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+		{
+			if (Spec.IsActive())
+			{
+				return true;
+			}
+		}
+	}
+	
+	return false;
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatPrewarmSubsystem.generated.h"
+
+class AActor;
+struct FStreamableHandle;
+
+/**
+ * Loads everything combat needs before the first fight, and reports what it still missed.
+ *
+ * When the world begins play, the fighter blueprints listed in Fighters and the game mode's
+ * player state are loaded with everything they hold: weapons, montages, projectiles and hit
+ * react abilities. Then the classes of their ability sets follow, together with the notifies of
+ * the cues under CueTags. Once loaded, the effects of pooled cue notifies are created in the
+ * cue effect pool. Everything stays resident for the world's lifetime, so the first swing, block
+ * or roll of a session no longer loads anything on the game thread.
+ *
+ * Any package still loaded synchronously afterwards while an ability is active is logged as a
+ * warning and counted as SyncLoads in "stat Combat", to tell what the lists above are missing.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UCombatPrewarmSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+	
+	/** Fighter blueprints that may take part in fights of this game */
+	UPROPERTY(Config)
+	TArray<TSoftClassPtr<AActor>> Fighters;
+	
+	/** Cues whose notifies are loaded ahead, with their child tags */
+	UPROPERTY(Config)
+	FGameplayTagContainer CueTags;
+	
+	/** Components created per effect of a pooled cue notify */
+	UPROPERTY(Config)
+	int32 PooledEffectsPerCue = 4;
+	
+public:
+	
+	/** Returns whether everything has been loaded and created */
+	FORCEINLINE bool IsPrewarmed() const { return bPrewarmed; }
+	
+protected:
+	
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	
+	virtual void Deinitialize() override;
+	
+private:
+	
+	/** Loads the ability set classes of the loaded fighters and the cue notifies */
+	void OnFightersLoaded();
+	
+	/** Creates the pooled effects of the loaded cue notifies */
+	void OnAbilitiesAndCuesLoaded();
+	
+	/** Appends the notify paths of the cues under CueTags */
+	void GatherCueNotifyPaths(TArray<FSoftObjectPath>& OutPaths) const;
+	
+	/** Reports a package loaded synchronously */
+	void OnSyncLoadPackage(const FString& PackageName);
+	
+	/** Returns whether a fighter of this world has an ability active */
+	bool IsCombatActive() const;
+	
+private:
+	
+	/** Keep the prewarmed assets resident */
+	TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+	
+	/** Cue notify classes loaded ahead */
+	TArray<FSoftObjectPath> CueNotifyPaths;
+	
+	FDelegateHandle SyncLoadHandle;
+	
+	/** World time the prewarm began at */
+	double PrewarmStartTime = 0.0;
+	
+	bool bPrewarmed = false;
+};
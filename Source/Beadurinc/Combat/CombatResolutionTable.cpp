@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatResolutionTable.h"
+
+ECombatHitOutcome UCombatResolutionTable::Resolve(ECombatAttackType AttackType, uint8 DefenderStates, FRandomStream& Stream) const
+{
+	const int32 TypeIndex = FMath::Min(static_cast<int32>(AttackType), static_cast<int32>(ECombatAttackType::MAX) - 1);
+	const FCompiledOutcome& Entry = Compiled[TypeIndex][DefenderStates & (CombatDefenderStateCount - 1)];
+	
+	// Certain outcomes do not consume the stream, so they cannot shift the rolls of later hits
+	if (Entry.Chance >= 1.0F)
+	{
+		return Entry.Outcome;
+	}
+	
+	return Stream.FRand() < Entry.Chance ? Entry.Outcome : Entry.FallbackOutcome;
+}
+
+ECombatHitOutcome UCombatResolutionTable::ResolveDefault(ECombatAttackType AttackType, uint8 DefenderStates)
+{
+	const ECombatDefenderState States = static_cast<ECombatDefenderState>(DefenderStates);
+	
+	if (EnumHasAnyFlags(States, ECombatDefenderState::Invincible))
+	{
+		return ECombatHitOutcome::Ignored;
+	}
+	
+	if (AttackType == ECombatAttackType::Unblockable || !EnumHasAnyFlags(States, ECombatDefenderState::FacingAttacker))
+	{
+		return ECombatHitOutcome::Hurt;
+	}
+	
+	if (EnumHasAnyFlags(States, ECombatDefenderState::Parrying))
+	{
+		return ECombatHitOutcome::Parried;
+	}
+	
+	return EnumHasAnyFlags(States, ECombatDefenderState::Blocking) ? ECombatHitOutcome::Blocked : ECombatHitOutcome::Hurt;
+}
+
+void UCombatResolutionTable::SetRules(const TArray<FCombatResolutionRule>& InRules, float InFacingCosine)
+{
+	Rules = InRules;
+	FacingCosine = InFacingCosine;
+	
+	CompileRules();
+}
+
+void UCombatResolutionTable::PostLoad()
+{
+	Super::PostLoad();
+	
+	CompileRules();
+}
+
+#if WITH_EDITOR
+void UCombatResolutionTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	
+	CompileRules();
+}
+#endif
+
+void UCombatResolutionTable::CompileRules()
+{
+	for (int32 TypeIndex = 0; TypeIndex < static_cast<int32>(ECombatAttackType::MAX); ++TypeIndex)
+	{
+		for (int32 States = 0; States < CombatDefenderStateCount; ++States)
+		{
+			FCompiledOutcome& Entry = Compiled[TypeIndex][States];
+			Entry = FCompiledOutcome();
+			
+			// First matching rule wins, so designers can order specific rules above general ones
+			for (const FCombatResolutionRule& Rule : Rules)
+			{
+				if (static_cast<int32>(Rule.AttackType) != TypeIndex
+					|| (States & Rule.RequiredStates) != Rule.RequiredStates
+					|| (States & Rule.ForbiddenStates) != 0)
+				{
+					continue;
+				}
+				
+				Entry.Outcome = Rule.Outcome;
+				Entry.FallbackOutcome = Rule.FallbackOutcome;
+				Entry.Chance = Rule.Chance;
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CombatResolutionTable.generated.h"
+
+struct FRandomStream;
+
+/** Kind of attack a hit was made with. Each type has its own row of outcomes */
+UENUM(BlueprintType)
+enum class ECombatAttackType : uint8
+{
+	Light,
+	Heavy,
+	Unblockable,
+	
+	MAX UMETA(Hidden)
+};
+
+/** What a hit does to its defender */
+UENUM(BlueprintType)
+enum class ECombatHitOutcome : uint8
+{
+	Hurt,
+	Blocked,
+	Parried,
+	Ignored
+};
+
+/** Defender states a hit is resolved against. Combined as bits into a state index */
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECombatDefenderState : uint8
+{
+	None = 0 UMETA(Hidden),
+	Blocking = 1 << 0,
+	Parrying = 1 << 1,
+	Invincible = 1 << 2,
+	FacingAttacker = 1 << 3
+};
+ENUM_CLASS_FLAGS(ECombatDefenderState);
+
+/** Number of distinct defender state combinations */
+static constexpr int32 CombatDefenderStateCount = 16;
+
+/** One authored row: applies to the states that have every required and no forbidden flag */
+USTRUCT(BlueprintType)
+struct FCombatResolutionRule
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, Category = "Rule")
+	ECombatAttackType AttackType = ECombatAttackType::Light;
+	
+	UPROPERTY(EditAnywhere, Category = "Rule", meta = (Bitmask, BitmaskEnum = "/Script/Beadurinc.ECombatDefenderState"))
+	uint8 RequiredStates = 0;
+	
+	UPROPERTY(EditAnywhere, Category = "Rule", meta = (Bitmask, BitmaskEnum = "/Script/Beadurinc.ECombatDefenderState"))
+	uint8 ForbiddenStates = 0;
+	
+	/** Outcome when the roll succeeds */
+	UPROPERTY(EditAnywhere, Category = "Rule")
+	ECombatHitOutcome Outcome = ECombatHitOutcome::Hurt;
+	
+	/** Probability of Outcome. Otherwise FallbackOutcome applies */
+	UPROPERTY(EditAnywhere, Category = "Rule", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float Chance = 1.0F;
+	
+	UPROPERTY(EditAnywhere, Category = "Rule")
+	ECombatHitOutcome FallbackOutcome = ECombatHitOutcome::Hurt;
+};
+
+/**
+ * Data-driven hit resolution. Rules are compiled into a lookup table indexed by attack type
+ * and the defender's state bits, so resolving a hit is one array read and at most one roll
+ * from a stream the caller seeds deterministically. Client and server given the same seed
+ * and state compute the same outcome.
+ *
+ * Rules are matched top to bottom, the first rule matching a state combination wins.
+ * Combinations no rule matches are Hurt.
+ */
+UCLASS(BlueprintType)
+class BEADURINC_API UCombatResolutionTable : public UDataAsset
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(EditAnywhere, Category = "Resolution")
+	TArray<FCombatResolutionRule> Rules;
+	
+	/** Minimum cosine between the defender's forward and the direction to the attacker to count as facing */
+	UPROPERTY(EditAnywhere, Category = "Resolution", meta = (ClampMin = "-1.0", ClampMax = "1.0"))
+	float FacingCosine = 0.0F;
+	
+	/** Compiled lookup, one entry per attack type and state combination */
+	struct FCompiledOutcome
+	{
+		ECombatHitOutcome Outcome = ECombatHitOutcome::Hurt;
+		ECombatHitOutcome FallbackOutcome = ECombatHitOutcome::Hurt;
+		float Chance = 1.0F;
+	};
+	
+	FCompiledOutcome Compiled[static_cast<int32>(ECombatAttackType::MAX)][CombatDefenderStateCount];
+	
+public:
+	
+	/** Returns the outcome of a hit. Rolls the stream only when the matching rule has a chance below one */
+	ECombatHitOutcome Resolve(ECombatAttackType AttackType, uint8 DefenderStates, FRandomStream& Stream) const;
+	
+	/** Returns the facing threshold used to set ECombatDefenderState::FacingAttacker */
+	FORCEINLINE float GetFacingCosine() const { return FacingCosine; }
+	
+	/** Replaces the rules and recompiles the lookup, for tables built at runtime */
+	void SetRules(const TArray<FCombatResolutionRule>& InRules, float InFacingCosine = 0.0F);
+	
+	/** Built-in resolution used when no table is assigned: a raised guard facing the attacker blocks or parries */
+	static ECombatHitOutcome ResolveDefault(ECombatAttackType AttackType, uint8 DefenderStates);
+	
+	virtual void PostLoad() override;
+	
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	
+private:
+	
+	/** Rebuilds Compiled from Rules */
+	void CompileRules();
+};
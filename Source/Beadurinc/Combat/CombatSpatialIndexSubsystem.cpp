@@ -0,0 +1,287 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatSpatialIndexSubsystem.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Combat/CombatStats.h"
+#include "Combat/Debug/CombatMemory.h"
+
+namespace CombatSpatialIndex
+{
+	/** A fighter found inside a queued area, reported once the pass is over */
+	struct FAreaHit
+	{
+		int32 QueryIndex;
+		TWeakObjectPtr<AFighterCharacter> Target;
+		FVector Location;
+	};
+}
+
+bool UCombatSpatialIndexSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+	
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UCombatSpatialIndexSubsystem::Deinitialize()
+{
+	SlotIndices.Empty();
+	SlotKeys.Empty();
+	Fighters.Empty();
+	Positions.Empty();
+	Radii.Empty();
+	HalfHeights.Empty();
+	TeamBits.Empty();
+	SortedSlots.Empty();
+	CellRanges.Empty();
+	PendingQueries.Empty();
+	ResolvingQueries.Empty();
+	
+	Super::Deinitialize();
+}
+
+template<typename FunctionType>
+void UCombatSpatialIndexSubsystem::ForEachSlotInCells(const FVector& Center, float Extent, FunctionType&& Visitor) const
+{
+	// Bodies standing in a neighbouring cell can still reach into the area
+	const FIntPoint Min = ToCell(Center - FVector(Extent + MaxRadius));
+	const FIntPoint Max = ToCell(Center + FVector(Extent + MaxRadius));
+	
+	// An area wider than the occupied cells visits the occupied cells instead
+	if (static_cast<int64>(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1) > CellRanges.Num())
+	{
+		for (const TPair<FIntPoint, TPair<int32, int32>>& Cell : CellRanges)
+		{
+			if (Cell.Key.X >= Min.X && Cell.Key.X <= Max.X && Cell.Key.Y >= Min.Y && Cell.Key.Y <= Max.Y)
+			{
+				for (int32 Index = Cell.Value.Key; Index < Cell.Value.Key + Cell.Value.Value; ++Index)
+				{
+					Visitor(SortedSlots[Index]);
+				}
+			}
+		}
+		
+		return;
+	}
+	
+	for (int32 X = Min.X; X <= Max.X; ++X)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			if (const TPair<int32, int32>* Range = CellRanges.Find(FIntPoint(X, Y)))
+			{
+				for (int32 Index = Range->Key; Index < Range->Key + Range->Value; ++Index)
+				{
+					Visitor(SortedSlots[Index]);
+				}
+			}
+		}
+	}
+}
+
+void UCombatSpatialIndexSubsystem::RegisterFighter(AFighterCharacter* Fighter)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_Fighters);
+	
+	if (!Fighter)
+	{
+		return;
+	}
+	
+	// Registered again before the pass dropped it
+	if (const int32* Index = SlotIndices.Find(Fighter))
+	{
+		Fighters[*Index] = Fighter;
+		return;
+	}
+	
+	const int32 Index = Fighters.Add(Fighter);
+	SlotKeys.Add(Fighter);
+	SlotIndices.Add(Fighter, Index);
+	
+	Positions.Add(Fighter->GetActorLocation());
+	Radii.Add(Fighter->GetCapsuleComponent()->GetScaledCapsuleRadius());
+	HalfHeights.Add(Fighter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+	TeamBits.Add(UCombatTeamSettings::ToBit(Fighter->GetTeam()));
+}
+
+void UCombatSpatialIndexSubsystem::UnregisterFighter(AFighterCharacter* Fighter)
+{
+	// The slot is dropped by the next pass, so slots and cells stay valid until then
+	if (const int32* Index = SlotIndices.Find(Fighter))
+	{
+		Fighters[*Index].Reset();
+	}
+}
+
+void UCombatSpatialIndexSubsystem::QueueAreaQuery(FCombatAreaQuery&& Query)
+{
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	PendingQueries.Add(MoveTemp(Query));
+}
+
+void UCombatSpatialIndexSubsystem::FindFightersInRadius(const FVector& Center, float Radius, TArray<AFighterCharacter*>& OutFighters) const
+{
+	ForEachSlotInCells(Center, Radius, [this, &Center, Radius, &OutFighters](int32 Slot)
+	{
+		AFighterCharacter* Fighter = Fighters[Slot].Get();
+		
+		if (Fighter && FVector::DistSquared2D(Positions[Slot], Center) <= FMath::Square(Radius + Radii[Slot]))
+		{
+			OutFighters.Add(Fighter);
+		}
+	});
+}
+
+void UCombatSpatialIndexSubsystem::Tick(float DeltaTime)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_AreaAttacks);
+	LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+	
+	Super::Tick(DeltaTime);
+	
+	RebuildGrid();
+	
+	if (PendingQueries.IsEmpty())
+	{
+		return;
+	}
+	
+	Swap(PendingQueries, ResolvingQueries);
+	
+	// Test every area first, so hit reactions that move or remove fighters cannot disturb the pass
+	TArray<CombatSpatialIndex::FAreaHit, TInlineAllocator<64>> Hits;
+	
+	for (int32 QueryIndex = 0; QueryIndex < ResolvingQueries.Num(); ++QueryIndex)
+	{
+		const FCombatAreaQuery& Query = ResolvingQueries[QueryIndex];
+		const AFighterCharacter* Instigator = Query.Instigator.Get();
+		
+		if (!Instigator)
+		{
+			continue;
+		}
+		
+		COMBAT_COUNT(Traces);
+		
+		const uint32 HostileMask = Instigator->GetHostileTeamMask();
+		const FVector Center = Query.Transform.GetLocation();
+		
+		ForEachSlotInCells(Center, Query.Shape.GetBoundingRadius(), [this, &Query, &Hits, QueryIndex, HostileMask, Instigator](int32 Slot)
+		{
+			// Allies and neutral fighters are rejected with a single AND
+			if ((TeamBits[Slot] & HostileMask) == 0)
+			{
+				return;
+			}
+			
+			AFighterCharacter* Target = Fighters[Slot].Get();
+			FVector Location;
+			
+			if (Target && Target != Instigator && Query.Shape.Overlaps(Query.Transform, Positions[Slot], Radii[Slot], HalfHeights[Slot], Location))
+			{
+				Hits.Add({ QueryIndex, Target, Location });
+			}
+		});
+	}
+	
+	// Fan the hits out through the same event melee contacts send
+	for (const CombatSpatialIndex::FAreaHit& AreaHit : Hits)
+	{
+		const FCombatAreaQuery& Query = ResolvingQueries[AreaHit.QueryIndex];
+		AFighterCharacter* Instigator = Query.Instigator.Get();
+		AFighterCharacter* Target = AreaHit.Target.Get();
+		
+		if (!Instigator || !Target)
+		{
+			continue;
+		}
+		
+		const FVector Normal = (AreaHit.Location - Query.Transform.GetLocation()).GetSafeNormal();
+		const FHitResult Hit(Target, Target->GetCapsuleComponent(), AreaHit.Location, Normal);
+		
+		Instigator->SendHitEvent(Target, Query.Source.Get(), Query.Damage, Hit);
+	}
+	
+	ResolvingQueries.Reset();
+}
+
+TStatId UCombatSpatialIndexSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_Combat_AreaAttacks);
+}
+
+void UCombatSpatialIndexSubsystem::RebuildGrid()
+{
+	// Iterate backward since dropped slots are swapped out while iterating
+	for (int32 Index = Fighters.Num() - 1; Index >= 0; --Index)
+	{
+		if (!Fighters[Index].IsValid())
+		{
+			RemoveAt(Index);
+		}
+	}
+	
+	const int32 Num = Fighters.Num();
+	
+	SortedSlots.SetNumUninitialized(Num, EAllowShrinking::No);
+	CellRanges.Reset();
+	MaxRadius = 0.0F;
+	
+	if (Num == 0)
+	{
+		return;
+	}
+	
+	TArray<FIntPoint, TInlineAllocator<64>> Cells;
+	Cells.SetNumUninitialized(Num);
+	
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Positions[Index] = Fighters[Index]->GetActorLocation();
+		Cells[Index] = ToCell(Positions[Index]);
+		SortedSlots[Index] = Index;
+		MaxRadius = FMath::Max(MaxRadius, Radii[Index]);
+	}
+	
+	SortedSlots.Sort([&Cells](int32 A, int32 B)
+	{
+		return Cells[A].X != Cells[B].X ? Cells[A].X < Cells[B].X : Cells[A].Y < Cells[B].Y;
+	});
+	
+	// Each run of equal cells becomes one range
+	int32 RunStart = 0;
+	
+	for (int32 Index = 1; Index <= Num; ++Index)
+	{
+		if (Index == Num || Cells[SortedSlots[Index]] != Cells[SortedSlots[RunStart]])
+		{
+			CellRanges.Add(Cells[SortedSlots[RunStart]], { RunStart, Index - RunStart });
+			RunStart = Index;
+		}
+	}
+}
+
+void UCombatSpatialIndexSubsystem::RemoveAt(int32 Index)
+{
+	// The last slot moves into the removed one, so its index has to follow
+	SlotIndices.Remove(SlotKeys[Index]);
+	
+	if (Index != SlotKeys.Num() - 1)
+	{
+		SlotIndices[SlotKeys.Last()] = Index;
+	}
+	
+	SlotKeys.RemoveAtSwap(Index, EAllowShrinking::No);
+	Fighters.RemoveAtSwap(Index, EAllowShrinking::No);
+	Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+	Radii.RemoveAtSwap(Index, EAllowShrinking::No);
+	HalfHeights.RemoveAtSwap(Index, EAllowShrinking::No);
+	TeamBits.RemoveAtSwap(Index, EAllowShrinking::No);
+}
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Combat/CombatAreaShape.h"
+#include "CombatSpatialIndexSubsystem.generated.h"
+
+class AFighterCharacter;
+
+/** An area attack waiting for the next overlap pass */
+struct FCombatAreaQuery
+{
+	/** Fighter the hits are dealt on behalf of */
+	TWeakObjectPtr<AFighterCharacter> Instigator;
+	
+	/** Sent as the hits' source, resolves their attack type */
+	TWeakObjectPtr<const UObject> Source;
+	
+	/** Area placed in the world */
+	FCombatAreaShape Shape;
+	FTransform Transform;
+	
+	float Damage = 0.0F;
+};
+
+/**
+ * Knows where every fighter of the world stands, bucketed in a uniform grid of the ground plane.
+ *
+ * Area attacks are not physics queries. Any number of them can be queued during a frame, and on
+ * tick the grid is rebuilt once from the fighters' positions and every queued area is tested
+ * against the fighters of the cells it covers in one pass. Each fighter inside an area is sent
+ * Event.Combat.Hit by the area's instigator, so the cost follows the number of fighters near the
+ * areas rather than the number of bodies in the physics scene.
+ */
+UCLASS(Config = Game)
+class BEADURINC_API UCombatSpatialIndexSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+	
+	/** Side of a grid cell in cm, about the reach of the widest area attack */
+	UPROPERTY(Config)
+	float CellSize = 500.0F;
+	
+public:
+	
+	/** Starts indexing a fighter */
+	void RegisterFighter(AFighterCharacter* Fighter);
+	
+	/** Stops indexing a fighter */
+	void UnregisterFighter(AFighterCharacter* Fighter);
+	
+	/** Queues an area attack for the overlap pass at the end of this frame */
+	void QueueAreaQuery(FCombatAreaQuery&& Query);
+	
+	/** Appends every fighter within Radius of Center on the ground plane, as of the latest pass */
+	void FindFightersInRadius(const FVector& Center, float Radius, TArray<AFighterCharacter*>& OutFighters) const;
+	
+	/** Returns the number of fighters indexed */
+	FORCEINLINE int32 GetNumRegistered() const { return Fighters.Num(); }
+	
+protected:
+	
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	
+	virtual void Deinitialize() override;
+	
+	virtual void Tick(float DeltaTime) override;
+	
+	virtual TStatId GetStatId() const override;
+	
+private:
+	
+	/** Reads the fighters' positions and buckets them into cells */
+	void RebuildGrid();
+	
+	/** Calls Visitor with the slot of every fighter in the cells covering Center +- Extent */
+	template<typename FunctionType>
+	void ForEachSlotInCells(const FVector& Center, float Extent, FunctionType&& Visitor) const;
+	
+	/** Returns the cell holding a position */
+	FORCEINLINE FIntPoint ToCell(const FVector& Position) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize));
+	}
+	
+	/** Removes a slot by swapping the last one into its place */
+	void RemoveAt(int32 Index);
+	
+private:
+	
+	/** Maps a fighter to its slot in the arrays below */
+	TMap<TObjectKey<AFighterCharacter>, int32> SlotIndices;
+	
+	// Structure of arrays, one element per indexed fighter. Kept in sync by RegisterFighter/RemoveAt.
+	TArray<TObjectKey<AFighterCharacter>> SlotKeys;
+	TArray<TWeakObjectPtr<AFighterCharacter>> Fighters;
+	TArray<FVector> Positions;
+	TArray<float> Radii;
+	TArray<float> HalfHeights;
+	TArray<uint32> TeamBits;
+	
+	/** Slots sorted by cell, so the fighters of a cell are contiguous */
+	TArray<int32> SortedSlots;
+	
+	/** Range of SortedSlots each occupied cell covers */
+	TMap<FIntPoint, TPair<int32, int32>> CellRanges;
+	
+	/** Largest body radius indexed, how far a body can reach out of its cell */
+	float MaxRadius = 0.0F;
+	
+	/** Area attacks queued since the last pass */
+	TArray<FCombatAreaQuery> PendingQueries;
+	
+	/** Area attacks of the running pass. Hit reactions may queue more meanwhile */
+	TArray<FCombatAreaQuery> ResolvingQueries;
+};
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatStats.h"
+
+DEFINE_STAT(STAT_Combat_AbilityActivation);
+DEFINE_STAT(STAT_Combat_MeleeContacts);
+DEFINE_STAT(STAT_Combat_WeaponSweeps);
+DEFINE_STAT(STAT_Combat_Projectiles);
+DEFINE_STAT(STAT_Combat_AreaAttacks);
+DEFINE_STAT(STAT_Combat_Audio);
+DEFINE_STAT(STAT_Combat_LockOn);
+DEFINE_STAT(STAT_Combat_InputBuffer);
+DEFINE_STAT(STAT_Combat_HitReact);
+DEFINE_STAT(STAT_Combat_StateWindows);
+DEFINE_STAT(STAT_Combat_StaminaRegeneration);
+
+DEFINE_STAT(STAT_Combat_Hits);
+DEFINE_STAT(STAT_Combat_Traces);
+DEFINE_STAT(STAT_Combat_Cues);
+DEFINE_STAT(STAT_Combat_Activations);
+DEFINE_STAT(STAT_Combat_CuesMerged);
+DEFINE_STAT(STAT_Combat_CuesSkipped);
+DEFINE_STAT(STAT_Combat_CuePoolMisses);
+DEFINE_STAT(STAT_Combat_SoundsMerged);
+DEFINE_STAT(STAT_Combat_SoundsVirtualized);
+DEFINE_STAT(STAT_Combat_SyncLoads);
+DEFINE_STAT(STAT_Combat_Spawns);
+
+CSV_DEFINE_CATEGORY_MODULE(BEADURINC_API, Combat, true);
+
+UE_TRACE_CHANNEL_DEFINE(CombatChannel);
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "Combat/Debug/CombatHitchMonitor.h"
+
+/**
+ * Profiling hooks of the combat code.
+ *
+ * - "stat Combat" shows cycle stats and per-frame counters.
+ * - Insights shows the same scopes on the Combat trace channel (-trace=cpu,Combat).
+ * - CSV captures get the per-frame counters in the Combat category.
+ * - The hitch monitor keeps the per-frame counters of recent frames and logs them with a hitch.
+ */
+
+DECLARE_STATS_GROUP(TEXT("Combat"), STATGROUP_Combat, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ability Activation"), STAT_Combat_AbilityActivation, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee Contacts"), STAT_Combat_MeleeContacts, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon Sweeps"), STAT_Combat_WeaponSweeps, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectiles"), STAT_Combat_Projectiles, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Area Attacks"), STAT_Combat_AreaAttacks, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Audio"), STAT_Combat_Audio, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Lock On"), STAT_Combat_LockOn, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Input Buffer"), STAT_Combat_InputBuffer, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hit React"), STAT_Combat_HitReact, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("State Windows"), STAT_Combat_StateWindows, STATGROUP_Combat, BEADURINC_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stamina Regeneration"), STAT_Combat_StaminaRegeneration, STATGROUP_Combat, BEADURINC_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hits"), STAT_Combat_Hits, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_Combat_Traces, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cues"), STAT_Combat_Cues, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Activations"), STAT_Combat_Activations, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cues Merged"), STAT_Combat_CuesMerged, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cues Skipped"), STAT_Combat_CuesSkipped, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cue Pool Misses"), STAT_Combat_CuePoolMisses, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sounds Merged"), STAT_Combat_SoundsMerged, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sounds Virtualized"), STAT_Combat_SoundsVirtualized, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sync Loads"), STAT_Combat_SyncLoads, STATGROUP_Combat, BEADURINC_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Spawns"), STAT_Combat_Spawns, STATGROUP_Combat, BEADURINC_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(BEADURINC_API, Combat);
+
+UE_TRACE_CHANNEL_EXTERN(CombatChannel, BEADURINC_API);
+
+/** Times the enclosing scope under a combat cycle stat and as a CPU event on the Combat trace channel */
+#define COMBAT_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, CombatChannel)
+
+/** Counts one occurrence of a per-frame combat counter, one of ECombatCounter. A single statement, safe under a brace-less if */
+#if WITH_COMBAT_HITCH_MONITOR
+#define COMBAT_COUNT(Counter) \
+	do \
+	{ \
+		INC_DWORD_STAT(STAT_Combat_##Counter); \
+		CSV_CUSTOM_STAT(Combat, Counter, 1, ECsvCustomStatOp::Accumulate); \
+		FCombatHitchMonitor::Count(ECombatCounter::Counter); \
+	} while (0)
+#else
+#define COMBAT_COUNT(Counter) \
+	do \
+	{ \
+		INC_DWORD_STAT(STAT_Combat_##Counter); \
+		CSV_CUSTOM_STAT(Combat, Counter, 1, ECsvCustomStatOp::Accumulate); \
+	} while (0)
+#endif
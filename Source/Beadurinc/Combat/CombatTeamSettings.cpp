@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/CombatTeamSettings.h"
+
+void UCombatTeamSettings::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	CompileHostileMasks();
+}
+
+#if WITH_EDITOR
+void UCombatTeamSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileHostileMasks();
+}
+#endif
+
+void UCombatTeamSettings::CompileHostileMasks()
+{
+	FMemory::Memzero(HostileMasks);
+
+	// Hostility is symmetric: if A can hurt B then B can hurt A
+	for (const FCombatTeamHostility& Pair : HostileTeams)
+	{
+		HostileMasks[static_cast<uint32>(Pair.TeamA) & 31u] |= ToBit(Pair.TeamB);
+		HostileMasks[static_cast<uint32>(Pair.TeamB) & 31u] |= ToBit(Pair.TeamA);
+	}
+}
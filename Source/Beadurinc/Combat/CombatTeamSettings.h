@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "CombatTeamSettings.generated.h"
+
+/**
+ * Teams (factions) a fighter can belong to. The value is used as a bit index,
+ * so at most 32 teams can be declared.
+ */
+UENUM(BlueprintType)
+enum class ECombatTeam : uint8
+{
+	Neutral = 0,
+	Player = 1,
+	Monster = 2,
+};
+
+/** One symmetric row of the hostility matrix */
+USTRUCT()
+struct FCombatTeamHostility
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Team")
+	ECombatTeam TeamA = ECombatTeam::Neutral;
+
+	UPROPERTY(EditAnywhere, Category = "Team")
+	ECombatTeam TeamB = ECombatTeam::Neutral;
+};
+
+/**
+ * Hostility matrix between teams, editable in Project Settings > Game > Combat Teams.
+ *
+ * Pairs are compiled into one bitmask per team, so "can A hurt B" is a single AND:
+ * (GetHostileMask(A) & ToBit(B)) != 0
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Combat Teams"))
+class BEADURINC_API UCombatTeamSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+	/** Pairs of teams that are allowed to damage each other. Listing a team with itself enables friendly fire */
+	UPROPERTY(Config, EditAnywhere, Category = "Team")
+	TArray<FCombatTeamHostility> HostileTeams;
+
+	/** Compiled hostility, indexed by team */
+	uint32 HostileMasks[32] = {};
+
+public:
+
+	/** Returns the bit of a team used in hostility masks */
+	static FORCEINLINE uint32 ToBit(ECombatTeam Team) { return 1u << (static_cast<uint32>(Team) & 31u); }
+
+	/** Returns the mask of the teams the given team is hostile to */
+	FORCEINLINE uint32 GetHostileMask(ECombatTeam Team) const { return HostileMasks[static_cast<uint32>(Team) & 31u]; }
+
+	virtual FName GetCategoryName() const override { return TEXT("Game"); }
+
+	virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	/** Rebuilds HostileMasks from HostileTeams */
+	void CompileHostileMasks();
+};
@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Debug/CombatHitchMonitor.h"
+#include "Beadurinc.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+
+static float GCombatHitchThresholdMs = 50.0F;
+static FAutoConsoleVariableRef CVarCombatHitchThresholdMs(
+	TEXT("Combat.HitchMonitor.ThresholdMs"),
+	GCombatHitchThresholdMs,
+	TEXT("Frames longer than this in milliseconds dump the recent combat counters to the log. 0 disables the dumps")
+);
+
+static int32 GCombatHitchContextFrames = 16;
+static FAutoConsoleVariableRef CVarCombatHitchContextFrames(
+	TEXT("Combat.HitchMonitor.ContextFrames"),
+	GCombatHitchContextFrames,
+	TEXT("Frames dumped with a hitch, the hitch included")
+);
+
+uint32 FCombatHitchMonitor::CurrentCounters[static_cast<int32>(ECombatCounter::MAX)] = {};
+FCombatHitchFrame FCombatHitchMonitor::Frames[Capacity];
+uint64 FCombatHitchMonitor::WriteCount = 0;
+double FCombatHitchMonitor::LastEndFrameTime = 0.0;
+uint64 FCombatHitchMonitor::LastDumpWriteCount = 0;
+FDelegateHandle FCombatHitchMonitor::EndFrameHandle;
+
+void FCombatHitchMonitor::Startup()
+{
+#if WITH_COMBAT_HITCH_MONITOR
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FCombatHitchMonitor::OnEndFrame);
+#endif
+}
+
+void FCombatHitchMonitor::Shutdown()
+{
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+}
+
+const TCHAR* FCombatHitchMonitor::GetCounterName(ECombatCounter Counter)
+{
+	switch (Counter)
+	{
+	case ECombatCounter::Hits: return TEXT("Hits");
+	case ECombatCounter::Traces: return TEXT("Traces");
+	case ECombatCounter::Cues: return TEXT("Cues");
+	case ECombatCounter::Activations: return TEXT("Activations");
+	case ECombatCounter::CuesMerged: return TEXT("CuesMerged");
+	case ECombatCounter::CuesSkipped: return TEXT("CuesSkipped");
+	case ECombatCounter::CuePoolMisses: return TEXT("CuePoolMisses");
+	case ECombatCounter::SoundsMerged: return TEXT("SoundsMerged");
+	case ECombatCounter::SoundsVirtualized: return TEXT("SoundsVirtualized");
+	case ECombatCounter::SyncLoads: return TEXT("SyncLoads");
+	case ECombatCounter::Spawns: return TEXT("Spawns");
+	default: return TEXT("Unknown");
+	}
+}
+
+void FCombatHitchMonitor::OnEndFrame()
+{
+	const double Now = FPlatformTime::Seconds();
+	
+	// The first frame has nothing to be measured from
+	if (LastEndFrameTime <= 0.0)
+	{
+		LastEndFrameTime = Now;
+		FMemory::Memzero(CurrentCounters);
+		return;
+	}
+	
+	FCombatHitchFrame& Frame = Frames[WriteCount % Capacity];
+	Frame.FrameNumber = GFrameCounter;
+	Frame.FrameMs = static_cast<float>((Now - LastEndFrameTime) * 1000.0);
+	
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatCounter::MAX); ++Index)
+	{
+		Frame.Counters[Index] = static_cast<uint16>(FMath::Min<uint32>(CurrentCounters[Index], MAX_uint16));
+	}
+	
+	++WriteCount;
+	LastEndFrameTime = Now;
+	FMemory::Memzero(CurrentCounters);
+	
+	if (GCombatHitchThresholdMs > 0.0F && Frame.FrameMs > GCombatHitchThresholdMs)
+	{
+		// Hitches in a row only dump the frames not dumped yet
+		const int32 ContextFrames = FMath::Clamp(GCombatHitchContextFrames, 1, Capacity);
+		DumpHitch(Frame, static_cast<int32>(FMath::Min<uint64>(ContextFrames, WriteCount - LastDumpWriteCount)));
+		LastDumpWriteCount = WriteCount;
+	}
+}
+
+void FCombatHitchMonitor::DumpHitch(const FCombatHitchFrame& Hitch, int32 ContextFrames)
+{
+	constexpr int32 CounterCount = static_cast<int32>(ECombatCounter::MAX);
+	const int32 FramesBefore = FMath::Min(GCombatHitchContextFrames, static_cast<int32>(FMath::Min<uint64>(WriteCount, Capacity))) - 1;
+	
+	// Average of each counter over the frames before the hitch
+	float Averages[CounterCount] = {};
+	
+	for (int32 Offset = 1; Offset <= FramesBefore; ++Offset)
+	{
+		const FCombatHitchFrame& Frame = Frames[(WriteCount - 1 - Offset) % Capacity];
+		
+		for (int32 Index = 0; Index < CounterCount; ++Index)
+		{
+			Averages[Index] += static_cast<float>(Frame.Counters[Index]) / FramesBefore;
+		}
+	}
+	
+	// Counters well above their recent average are the likely cause
+	FString Suspects;
+	
+	for (int32 Index = 0; Index < CounterCount; ++Index)
+	{
+		if (Hitch.Counters[Index] > Averages[Index] * 2.0F + 1.0F)
+		{
+			Suspects += FString::Printf(TEXT(" %s=%u(avg %.1f)"), GetCounterName(static_cast<ECombatCounter>(Index)), Hitch.Counters[Index], Averages[Index]);
+		}
+	}
+	
+	UE_LOG(
+		LogBeadurinc,
+		Warning,
+		TEXT("CombatHitch %s frame %llu took %.1fms (threshold %.1fms), above average:%s"),
+		IsRunningDedicatedServer() ? TEXT("server") : TEXT("client"),
+		Hitch.FrameNumber,
+		Hitch.FrameMs,
+		GCombatHitchThresholdMs,
+		Suspects.IsEmpty() ? TEXT(" none") : *Suspects
+	);
+	
+	// Oldest first, only the counters that were hit
+	for (int32 Offset = ContextFrames - 1; Offset >= 0; --Offset)
+	{
+		const FCombatHitchFrame& Frame = Frames[(WriteCount - 1 - Offset) % Capacity];
+		FString Line = FString::Printf(TEXT("CombatHitch   %llu %6.1fms"), Frame.FrameNumber, Frame.FrameMs);
+		
+		for (int32 Index = 0; Index < CounterCount; ++Index)
+		{
+			if (Frame.Counters[Index] > 0)
+			{
+				Line += FString::Printf(TEXT(" %s=%u"), GetCounterName(static_cast<ECombatCounter>(Index)), Frame.Counters[Index]);
+			}
+		}
+		
+		UE_LOG(LogBeadurinc, Warning, TEXT("%s"), *Line);
+	}
+}
@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The monitor is compiled out of shipping builds
+#define WITH_COMBAT_HITCH_MONITOR !UE_BUILD_SHIPPING
+
+/** Per-frame combat counters, one per COMBAT_COUNT counter */
+enum class ECombatCounter : uint8
+{
+	Hits,
+	Traces,
+	Cues,
+	Activations,
+	CuesMerged,
+	CuesSkipped,
+	CuePoolMisses,
+	SoundsMerged,
+	SoundsVirtualized,
+	SyncLoads,
+	Spawns,
+	MAX
+};
+
+/** The combat counters and duration of one frame */
+struct FCombatHitchFrame
+{
+	uint64 FrameNumber = 0;
+	float FrameMs = 0.0F;
+	uint16 Counters[static_cast<int32>(ECombatCounter::MAX)] = {};
+};
+
+/**
+ * Keeps the combat counters of the last frames next to their durations, and explains hitches.
+ *
+ * COMBAT_COUNT bumps a counter of the current frame, an array increment. At the end of every
+ * frame the counters and the frame's duration are written into a fixed ring buffer and reset.
+ * A frame longer than Combat.HitchMonitor.ThresholdMs dumps the frames before it to the log,
+ * one compact line per frame, headed by the counters that stood out from those frames, so a
+ * hitch on a server or a client can be traced to the combat system behind it without an
+ * Insights capture. Game thread only.
+ */
+class BEADURINC_API FCombatHitchMonitor
+{
+public:
+	
+	/** Number of frames kept. Older frames are overwritten */
+	static constexpr int32 Capacity = 64;
+	
+	/** Counts one occurrence of a counter in the current frame */
+	static FORCEINLINE void Count(ECombatCounter Counter)
+	{
+		++CurrentCounters[static_cast<int32>(Counter)];
+	}
+	
+	/** Starts closing frames at the end of every engine frame */
+	static void Startup();
+	
+	static void Shutdown();
+	
+	/** Returns the name of a counter, as used by COMBAT_COUNT */
+	static const TCHAR* GetCounterName(ECombatCounter Counter);
+	
+private:
+	
+	/** Records the frame that just ended and dumps it when it was a hitch */
+	static void OnEndFrame();
+	
+	/** Logs the frames leading to the newest one */
+	static void DumpHitch(const FCombatHitchFrame& Hitch, int32 ContextFrames);
+	
+private:
+	
+	static uint32 CurrentCounters[static_cast<int32>(ECombatCounter::MAX)];
+	
+	static FCombatHitchFrame Frames[Capacity];
+	
+	static uint64 WriteCount;
+	
+	/** Time the previous frame ended at */
+	static double LastEndFrameTime;
+	
+	/** Frames written when the last hitch was dumped, its context is not dumped twice */
+	static uint64 LastDumpWriteCount;
+	
+	static FDelegateHandle EndFrameHandle;
+};
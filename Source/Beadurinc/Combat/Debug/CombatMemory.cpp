@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Debug/CombatMemory.h"
+#include "AbilitySystemComponent.h"
+#include "Actor/Projectile/ProjectileDataAsset.h"
+#include "Actor/Projectile/ProjectileVisualActor.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Animation/AnimSequenceBase.h"
+#include "AttributeSet.h"
+#include "GameplayEffect.h"
+#include "GameplayCueNotify_Actor.h"
+#include "GameplayCueNotify_Static.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+LLM_DEFINE_TAG(Beadurinc, "Beadurinc");
+LLM_DEFINE_TAG(Beadurinc_Fighters, "Fighters", "Beadurinc");
+LLM_DEFINE_TAG(Beadurinc_Weapons, "Weapons", "Beadurinc");
+LLM_DEFINE_TAG(Beadurinc_AbilitySystem, "AbilitySystem", "Beadurinc");
+LLM_DEFINE_TAG(Beadurinc_CombatEvents, "CombatEvents", "Beadurinc");
+LLM_DEFINE_TAG(Beadurinc_Animation, "Animation", "Beadurinc");
+
+namespace CombatMemory
+{
+	/** Returns the category an object is charged to, or MAX if it is not combat related */
+	static ECombatMemoryCategory Classify(const UObject* Object)
+	{
+		if (Object->IsA<UAbilitySystemComponent>() || Object->IsA<UGameplayAbility>() || Object->IsA<UAttributeSet>() || Object->IsA<UGameplayEffect>())
+		{
+			return ECombatMemoryCategory::AbilitySystem;
+		}
+		
+		// Weapons are components of their fighter, but charged to weapons. Projectiles count as weapons
+		if (Object->IsA<UWeaponComponent>() || Object->IsA<UWeaponDataAsset>() || Object->IsA<UProjectileDataAsset>())
+		{
+			return ECombatMemoryCategory::Weapons;
+		}
+		
+		// Components are charged to the actor that owns them
+		const UActorComponent* Component = Cast<UActorComponent>(Object);
+		const UObject* Owner = Component ? Component->GetOwner() : Object;
+		
+		if (!Owner)
+		{
+			return ECombatMemoryCategory::MAX;
+		}
+		
+		if (Owner->IsA<AFighterCharacter>())
+		{
+			return ECombatMemoryCategory::Fighters;
+		}
+		
+		if (Owner->IsA<AProjectileVisualActor>())
+		{
+			return ECombatMemoryCategory::Weapons;
+		}
+		
+		if (Owner->IsA<UGameplayCueNotify_Static>() || Owner->IsA<AGameplayCueNotify_Actor>())
+		{
+			return ECombatMemoryCategory::Cues;
+		}
+		
+		if (Object->IsA<UAnimSequenceBase>())
+		{
+			return ECombatMemoryCategory::Animation;
+		}
+		
+		return ECombatMemoryCategory::MAX;
+	}
+}
+
+FCombatMemoryReport FCombatMemoryReport::Gather(const UWorld* World)
+{
+	FCombatMemoryReport Report;
+	
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		const UObject* Object = *It;
+		
+		// Class default objects and archetypes are shared by every instance, count instances only.
+		// Static cues are never instanced, their class default object is the cue
+		if (Object->IsTemplate() && !(Object->IsA<UGameplayCueNotify_Static>() && !Object->GetClass()->HasAnyClassFlags(CLASS_Abstract | CLASS_NewerVersionExists)))
+		{
+			continue;
+		}
+		
+		const ECombatMemoryCategory Category = CombatMemory::Classify(Object);
+		
+		if (Category == ECombatMemoryCategory::MAX)
+		{
+			continue;
+		}
+		
+		if (World && (Object->IsA<AActor>() || Object->IsA<UActorComponent>()) && Object->GetWorld() != World)
+		{
+			continue;
+		}
+		
+		// Exclusive sizes, as every object is visited on its own
+		Report.Bytes[static_cast<int32>(Category)] += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		Report.Counts[static_cast<int32>(Category)]++;
+	}
+	
+	return Report;
+}
+
+bool FCombatMemoryReport::PrintAndCheckBudgets(FOutputDevice& Ar) const
+{
+	const UCombatMemoryBudgetSettings* Settings = GetDefault<UCombatMemoryBudgetSettings>();
+	const UEnum* CategoryEnum = StaticEnum<ECombatMemoryCategory>();
+	bool bWithinBudget = true;
+	
+	Ar.Logf(TEXT("%-16s %8s %12s %12s"), TEXT("Category"), TEXT("Objects"), TEXT("MB"), TEXT("Budget MB"));
+	
+	for (int32 Index = 0; Index < static_cast<int32>(ECombatMemoryCategory::MAX); ++Index)
+	{
+		const double MB = static_cast<double>(Bytes[Index]) / (1024.0 * 1024.0);
+		
+		const FCombatMemoryBudget* Budget = Settings->Budgets.FindByPredicate([Index](const FCombatMemoryBudget& Entry)
+		{
+			return static_cast<int32>(Entry.Category) == Index;
+		});
+		
+		const bool bOverBudget = Budget && Budget->BudgetMB > 0.0F && MB > Budget->BudgetMB;
+		bWithinBudget &= !bOverBudget;
+		
+		Ar.Logf(
+			bOverBudget ? ELogVerbosity::Error : ELogVerbosity::Display,
+			TEXT("%-16s %8d %12.2f %12s%s"),
+			*CategoryEnum->GetNameStringByIndex(Index),
+			Counts[Index],
+			MB,
+			Budget && Budget->BudgetMB > 0.0F ? *FString::Printf(TEXT("%.2f"), Budget->BudgetMB) : TEXT("-"),
+			bOverBudget ? TEXT("  OVER BUDGET") : TEXT("")
+		);
+	}
+	
+	return bWithinBudget;
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdCombatMemReport(
+	TEXT("Combat.MemReport"),
+	TEXT("Prints the memory of fighters, weapons, ability system, animation and cue objects in this world against the configured budgets"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FCombatMemoryReport::Gather(World).PrintAndCheckBudgets(Ar);
+	})
+);
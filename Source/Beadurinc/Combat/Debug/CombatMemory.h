@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Engine/DeveloperSettings.h"
+#include "CombatMemory.generated.h"
+
+/**
+ * Low-Level Memory Tracker tags of the Beadurinc module, shown under "Beadurinc" by
+ * "stat LLMFULL" and in Insights memory captures (-llm). Allocations made inside an
+ * LLM_SCOPE_BYTAG(Beadurinc_...) scope are charged to that tag.
+ */
+LLM_DECLARE_TAG_API(Beadurinc, BEADURINC_API);
+LLM_DECLARE_TAG_API(Beadurinc_Fighters, BEADURINC_API);
+LLM_DECLARE_TAG_API(Beadurinc_Weapons, BEADURINC_API);
+LLM_DECLARE_TAG_API(Beadurinc_AbilitySystem, BEADURINC_API);
+LLM_DECLARE_TAG_API(Beadurinc_CombatEvents, BEADURINC_API);
+LLM_DECLARE_TAG_API(Beadurinc_Animation, BEADURINC_API);
+
+/** Categories of the combat memory report */
+UENUM()
+enum class ECombatMemoryCategory : uint8
+{
+	Fighters,
+	Weapons,
+	AbilitySystem,
+	Animation,
+	Cues,
+	
+	MAX UMETA(Hidden)
+};
+
+/** Budget of one report category */
+USTRUCT()
+struct FCombatMemoryBudget
+{
+	GENERATED_BODY()
+	
+	UPROPERTY(Config, EditAnywhere, Category = "Budget")
+	ECombatMemoryCategory Category = ECombatMemoryCategory::Fighters;
+	
+	UPROPERTY(Config, EditAnywhere, Category = "Budget", meta = (ClampMin = "0.0", Units = "Megabytes"))
+	float BudgetMB = 0.0F;
+};
+
+/**
+ * Memory budgets checked by Combat.MemReport and the CombatMemoryReport commandlet,
+ * editable in Project Settings > Game > Combat Memory Budgets.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Combat Memory Budgets"))
+class BEADURINC_API UCombatMemoryBudgetSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+	
+public:
+	
+	/** Categories without an entry are reported but never fail */
+	UPROPERTY(Config, EditAnywhere, Category = "Budget")
+	TArray<FCombatMemoryBudget> Budgets;
+	
+	virtual FName GetCategoryName() const override { return TEXT("Game"); }
+};
+
+/** Resource sizes of loaded objects grouped by combat category */
+struct BEADURINC_API FCombatMemoryReport
+{
+	/** Exclusive resource bytes per category */
+	uint64 Bytes[static_cast<int32>(ECombatMemoryCategory::MAX)] = {};
+	
+	/** Object count per category */
+	int32 Counts[static_cast<int32>(ECombatMemoryCategory::MAX)] = {};
+	
+	/** Measures every loaded object of a combat category. Actors and components are limited to World when given */
+	static FCombatMemoryReport Gather(const UWorld* World);
+	
+	/** Prints the report and checks it against the configured budgets. Returns false if a budget is exceeded */
+	bool PrintAndCheckBudgets(FOutputDevice& Ar) const;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Debug/CombatMemoryReportCommandlet.h"
+#include "Beadurinc.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "Engine/World.h"
+
+UCombatMemoryReportCommandlet::UCombatMemoryReportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UCombatMemoryReportCommandlet::Main(const FString& Params)
+{
+	FString MapName;
+	
+	if (!FParse::Value(*Params, TEXT("Map="), MapName))
+	{
+		UE_LOG(LogBeadurinc, Error, TEXT("Usage: -run=CombatMemoryReport -Map=/Game/Path/To/Level"));
+		return 1;
+	}
+	
+	// Loading the level pulls in everything it hard references: fighters, weapons, abilities, montages
+	UPackage* MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+	const UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+	
+	if (!World)
+	{
+		UE_LOG(LogBeadurinc, Error, TEXT("Could not load level %s"), *MapName);
+		return 1;
+	}
+	
+	UE_LOG(LogBeadurinc, Display, TEXT("Combat memory of %s"), *MapName);
+	
+	return FCombatMemoryReport::Gather(World).PrintAndCheckBudgets(*GLog) ? 0 : 1;
+}
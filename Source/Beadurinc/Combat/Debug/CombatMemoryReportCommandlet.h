@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatMemoryReportCommandlet.generated.h"
+
+/**
+ * Loads a level and prints the combat memory report for it, failing when a budget set in
+ * UCombatMemoryBudgetSettings is exceeded. Meant for build machines:
+ *
+ *   UnrealEditor-Cmd Beadurinc.uproject -run=CombatMemoryReport -Map=/Game/Maps/Lvl_Arena
+ */
+UCLASS()
+class BEADURINC_API UCombatMemoryReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+	
+public:
+	
+	UCombatMemoryReportCommandlet();
+	
+	virtual int32 Main(const FString& Params) override;
+};
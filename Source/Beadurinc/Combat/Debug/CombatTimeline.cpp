@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Debug/CombatTimeline.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Beadurinc.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+void FCombatTimeline::RecordFor(AActor* Actor, ECombatTimelineEvent Type, FName Label, float Value)
+{
+#if WITH_COMBAT_TIMELINE
+	if (AFighterCharacter* Fighter = Cast<AFighterCharacter>(Actor))
+	{
+		Fighter->GetCombatTimeline().Record(Fighter->GetWorld()->GetTimeSeconds(), Type, Label, Value);
+	}
+#endif
+}
+
+bool FCombatTimeline::DumpWorld(UWorld* World, const FString& FilePath)
+{
+#if WITH_COMBAT_TIMELINE
+	if (!World)
+	{
+		return false;
+	}
+	
+	FString Csv(TEXT("Fighter,Time,Event,Label,Value\n"));
+	
+	for (TActorIterator<AFighterCharacter> It(World); It; ++It)
+	{
+		const FString FighterName = It->GetName();
+		
+		It->GetCombatTimeline().ForEach([&Csv, &FighterName](const FCombatTimelineEntry& Entry)
+		{
+			Csv += FString::Printf(TEXT("%s,%.4f,%s,%s,%g\n"), *FighterName, Entry.Time, GetEventName(Entry.Type), *Entry.Label.ToString(), Entry.Value);
+		});
+	}
+	
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+#else
+	return false;
+#endif
+}
+
+const TCHAR* FCombatTimeline::GetEventName(ECombatTimelineEvent Type)
+{
+	switch (Type)
+	{
+	case ECombatTimelineEvent::WindowOpened: return TEXT("WindowOpened");
+	case ECombatTimelineEvent::WindowClosed: return TEXT("WindowClosed");
+	case ECombatTimelineEvent::TraceBegin: return TEXT("TraceBegin");
+	case ECombatTimelineEvent::TraceEnd: return TEXT("TraceEnd");
+	case ECombatTimelineEvent::InputBuffered: return TEXT("InputBuffered");
+	case ECombatTimelineEvent::InputFlushed: return TEXT("InputFlushed");
+	case ECombatTimelineEvent::AbilityActivated: return TEXT("AbilityActivated");
+	case ECombatTimelineEvent::HitDealt: return TEXT("HitDealt");
+	case ECombatTimelineEvent::HitReceived: return TEXT("HitReceived");
+	default: return TEXT("Unknown");
+	}
+}
+
+#if WITH_COMBAT_TIMELINE
+static FAutoConsoleCommandWithWorldAndArgs CmdDumpCombatTimeline(
+	TEXT("Combat.DumpTimeline"),
+	TEXT("Writes the combat timeline of every fighter to a CSV file. Usage: Combat.DumpTimeline [FileName]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const FString FileName = Args.Num() > 0 ? Args[0] : FString::Printf(TEXT("CombatTimeline-%s.csv"), *FDateTime::Now().ToString());
+		const FString FilePath = FPaths::Combine(FPaths::ProjectLogDir(), FileName);
+		
+		if (FCombatTimeline::DumpWorld(World, FilePath))
+		{
+			UE_LOG(LogBeadurinc, Log, TEXT("Combat timeline written to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogBeadurinc, Warning, TEXT("Failed to write combat timeline to %s"), *FilePath);
+		}
+	})
+);
+#endif
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+
+// The recorder is compiled out of shipping builds
+#define WITH_COMBAT_TIMELINE !UE_BUILD_SHIPPING
+
+class AActor;
+
+/** Kinds of events a fighter's combat timeline records */
+enum class ECombatTimelineEvent : uint8
+{
+	WindowOpened,
+	WindowClosed,
+	TraceBegin,
+	TraceEnd,
+	InputBuffered,
+	InputFlushed,
+	AbilityActivated,
+	HitDealt,
+	HitReceived
+};
+
+/** One recorded event. Label is the state tag, ability, opponent or outcome it concerns */
+struct FCombatTimelineEntry
+{
+	double Time = 0.0;
+	FName Label;
+	float Value = 0.0F;
+	ECombatTimelineEvent Type = ECombatTimelineEvent::WindowOpened;
+};
+
+/**
+ * Fixed-size ring buffer of a fighter's recent combat events.
+ *
+ * Always recording: an event is one struct write into preallocated storage, with no
+ * allocation, lookup or string work, so leaving it on costs next to nothing. The gameplay
+ * debugger's CombatTimeline category and the Combat.DumpTimeline command read it.
+ */
+class BEADURINC_API FCombatTimeline
+{
+public:
+	
+	/** Number of events kept per fighter. Older events are overwritten */
+	static constexpr int32 Capacity = 256;
+	
+	/** Appends an event */
+	FORCEINLINE void Record(double Time, ECombatTimelineEvent Type, FName Label, float Value)
+	{
+		FCombatTimelineEntry& Entry = Entries[WriteCount % Capacity];
+		Entry.Time = Time;
+		Entry.Label = Label;
+		Entry.Value = Value;
+		Entry.Type = Type;
+		++WriteCount;
+	}
+	
+	/** Returns the number of events held */
+	FORCEINLINE int32 Num() const { return static_cast<int32>(FMath::Min<uint32>(WriteCount, Capacity)); }
+	
+	/** Visits the held events from oldest to newest */
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		const uint32 First = WriteCount - static_cast<uint32>(Num());
+		
+		for (uint32 Index = First; Index != WriteCount; ++Index)
+		{
+			Func(Entries[Index % Capacity]);
+		}
+	}
+	
+	/** Records an event on the actor's timeline if it is a fighter, stamped with its world's time */
+	static void RecordFor(AActor* Actor, ECombatTimelineEvent Type, FName Label, float Value = 0.0F);
+	
+	/** Writes the timelines of every fighter in the world as CSV. Returns whether the file was written */
+	static bool DumpWorld(UWorld* World, const FString& FilePath);
+	
+	/** Returns the display name of an event kind */
+	static const TCHAR* GetEventName(ECombatTimelineEvent Type);
+	
+private:
+	
+	TStaticArray<FCombatTimelineEntry, Capacity> Entries;
+	
+	/** Events recorded so far. Wrapping is harmless as Capacity divides 2^32 */
+	uint32 WriteCount = 0;
+};
+
+#if WITH_COMBAT_TIMELINE
+#define RECORD_COMBAT_EVENT(Actor, Type, Label, ...) FCombatTimeline::RecordFor(Actor, ECombatTimelineEvent::Type, Label, ##__VA_ARGS__)
+#else
+#define RECORD_COMBAT_EVENT(Actor, Type, Label, ...)
+#endif
@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/Debug/GameplayDebuggerCategory_CombatTimeline.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "Actor/Character/FighterCharacter.h"
+#include "CanvasItem.h"
+#include "Engine/Canvas.h"
+
+namespace CombatTimelineDebug
+{
+	/** Lanes of the timeline, top to bottom */
+	enum ELane : int32
+	{
+		Lane_Windows,
+		Lane_Traces,
+		Lane_Inputs,
+		Lane_Abilities,
+		Lane_Hits,
+		Lane_Count
+	};
+	
+	static const TCHAR* LaneNames[Lane_Count] = { TEXT("Windows"), TEXT("Traces"), TEXT("Inputs"), TEXT("Abilities"), TEXT("Hits") };
+	
+	static ELane GetLane(ECombatTimelineEvent Type)
+	{
+		switch (Type)
+		{
+		case ECombatTimelineEvent::WindowOpened:
+		case ECombatTimelineEvent::WindowClosed: return Lane_Windows;
+		case ECombatTimelineEvent::TraceBegin:
+		case ECombatTimelineEvent::TraceEnd: return Lane_Traces;
+		case ECombatTimelineEvent::InputBuffered:
+		case ECombatTimelineEvent::InputFlushed: return Lane_Inputs;
+		case ECombatTimelineEvent::AbilityActivated: return Lane_Abilities;
+		default: return Lane_Hits;
+		}
+	}
+	
+	static FLinearColor GetColor(ECombatTimelineEvent Type)
+	{
+		switch (Type)
+		{
+		case ECombatTimelineEvent::InputBuffered: return FLinearColor::Yellow;
+		case ECombatTimelineEvent::InputFlushed: return FLinearColor::Green;
+		case ECombatTimelineEvent::AbilityActivated: return FLinearColor(0.3F, 0.6F, 1.0F);
+		case ECombatTimelineEvent::HitDealt: return FLinearColor(1.0F, 0.5F, 0.0F);
+		case ECombatTimelineEvent::HitReceived: return FLinearColor::Red;
+		default: return FLinearColor::White;
+		}
+	}
+}
+
+FGameplayDebuggerCategory_CombatTimeline::FGameplayDebuggerCategory_CombatTimeline()
+{
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_CombatTimeline::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_CombatTimeline());
+}
+
+void FGameplayDebuggerCategory_CombatTimeline::FRepData::Serialize(FArchive& Ar)
+{
+	Ar << FighterName;
+	Ar << Now;
+	
+	int32 NumEntries = Entries.Num();
+	Ar << NumEntries;
+	
+	if (Ar.IsLoading())
+	{
+		Entries.SetNum(NumEntries);
+	}
+	
+	for (FCombatTimelineEntry& Entry : Entries)
+	{
+		uint8 Type = static_cast<uint8>(Entry.Type);
+		
+		Ar << Entry.Time;
+		Ar << Entry.Label;
+		Ar << Entry.Value;
+		Ar << Type;
+		
+		Entry.Type = static_cast<ECombatTimelineEvent>(Type);
+	}
+}
+
+void FGameplayDebuggerCategory_CombatTimeline::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack.Entries.Reset();
+	
+	const AFighterCharacter* Fighter = Cast<AFighterCharacter>(DebugActor);
+	
+	if (!Fighter)
+	{
+		DataPack.FighterName.Reset();
+		return;
+	}
+	
+	DataPack.FighterName = Fighter->GetName();
+	DataPack.Now = Fighter->GetWorld()->GetTimeSeconds();
+	
+	// Only the visible span is replicated, bars opened before it are clamped to its left edge
+	const double OldestVisible = DataPack.Now - VisibleSeconds;
+	
+	Fighter->GetCombatTimeline().ForEach([this, OldestVisible](const FCombatTimelineEntry& Entry)
+	{
+		const bool bClosesBar = Entry.Type == ECombatTimelineEvent::WindowClosed || Entry.Type == ECombatTimelineEvent::TraceEnd;
+		
+		if (Entry.Time >= OldestVisible || bClosesBar)
+		{
+			DataPack.Entries.Add(Entry);
+		}
+	});
+}
+
+void FGameplayDebuggerCategory_CombatTimeline::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	using namespace CombatTimelineDebug;
+	
+	if (DataPack.FighterName.IsEmpty())
+	{
+		CanvasContext.Printf(TEXT("{red}Select a fighter to show its combat timeline"));
+		return;
+	}
+	
+	CanvasContext.Printf(TEXT("Combat timeline of {yellow}%s{white}, last %.0f s"), *DataPack.FighterName, VisibleSeconds);
+	
+	constexpr float LabelWidth = 80.0F;
+	constexpr float TrackWidth = 600.0F;
+	constexpr float LaneHeight = 16.0F;
+	
+	const float Left = CanvasContext.CursorX + LabelWidth;
+	const float Top = CanvasContext.CursorY;
+	const double OldestVisible = DataPack.Now - VisibleSeconds;
+	
+	auto TimeToX = [&](double Time)
+	{
+		return Left + static_cast<float>(FMath::Clamp((Time - OldestVisible) / VisibleSeconds, 0.0, 1.0)) * TrackWidth;
+	};
+	
+	auto DrawBox = [&](float X, float Y, float Width, float Height, const FLinearColor& Color)
+	{
+		FCanvasTileItem Tile(FVector2D(X, Y), FVector2D(FMath::Max(Width, 1.0F), Height), Color);
+		Tile.BlendMode = SE_BLEND_Translucent;
+		CanvasContext.DrawItem(Tile, X, Y);
+	};
+	
+	// Lane backgrounds and names
+	for (int32 Lane = 0; Lane < Lane_Count; ++Lane)
+	{
+		const float Y = Top + Lane * LaneHeight;
+		DrawBox(Left, Y, TrackWidth, LaneHeight - 2.0F, FLinearColor(0.0F, 0.0F, 0.0F, 0.4F));
+		CanvasContext.PrintAt(CanvasContext.CursorX, Y, FString(LaneNames[Lane]));
+	}
+	
+	// Bars for windows and traces, open ones extend to now
+	TMap<FName, TPair<double, ELane>> OpenBars;
+	
+	auto DrawBar = [&](ELane Lane, double Start, double End)
+	{
+		if (End < OldestVisible)
+		{
+			return;
+		}
+		
+		const float X = TimeToX(Start);
+		DrawBox(X, Top + Lane * LaneHeight + 2.0F, TimeToX(End) - X, LaneHeight - 6.0F, Lane == Lane_Windows ? FLinearColor(0.2F, 0.8F, 0.2F, 0.7F) : FLinearColor(1.0F, 0.5F, 0.0F, 0.7F));
+	};
+	
+	for (const FCombatTimelineEntry& Entry : DataPack.Entries)
+	{
+		const ELane Lane = GetLane(Entry.Type);
+		
+		switch (Entry.Type)
+		{
+		case ECombatTimelineEvent::WindowOpened:
+		case ECombatTimelineEvent::TraceBegin:
+			OpenBars.Add(Entry.Label, TPair<double, ELane>(Entry.Time, Lane));
+			break;
+			
+		case ECombatTimelineEvent::WindowClosed:
+		case ECombatTimelineEvent::TraceEnd:
+		{
+			TPair<double, ELane> OpenBar(OldestVisible, Lane);
+			OpenBars.RemoveAndCopyValue(Entry.Label, OpenBar);
+			DrawBar(Lane, OpenBar.Key, Entry.Time);
+			break;
+		}
+			
+		default:
+			DrawBox(TimeToX(Entry.Time) - 1.0F, Top + Lane * LaneHeight, 3.0F, LaneHeight - 2.0F, GetColor(Entry.Type));
+			break;
+		}
+	}
+	
+	for (const TPair<FName, TPair<double, ELane>>& OpenBar : OpenBars)
+	{
+		DrawBar(OpenBar.Value.Value, OpenBar.Value.Key, DataPack.Now);
+	}
+	
+	CanvasContext.CursorY = Top + Lane_Count * LaneHeight + 4.0F;
+	
+	// The most recent events as text, newest first
+	const int32 NumListed = FMath::Min(DataPack.Entries.Num(), 8);
+	
+	for (int32 Index = DataPack.Entries.Num() - 1; Index >= DataPack.Entries.Num() - NumListed; --Index)
+	{
+		const FCombatTimelineEntry& Entry = DataPack.Entries[Index];
+		CanvasContext.Printf(TEXT("{grey}%+.3f s {white}%s {yellow}%s {grey}%g"), Entry.Time - DataPack.Now, FCombatTimeline::GetEventName(Entry.Type), *Entry.Label.ToString(), Entry.Value);
+	}
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "GameplayDebuggerCategory.h"
+#include "Combat/Debug/CombatTimeline.h"
+
+/**
+ * Gameplay debugger category drawing the selected fighter's combat timeline as scrolling lanes:
+ * state windows and weapon traces as bars, buffered inputs, ability activations and hits as ticks.
+ *
+ * Data is collected on the server from the fighter's ring buffer and replicated to the viewer,
+ * so nothing is gathered while the category is closed.
+ */
+class FGameplayDebuggerCategory_CombatTimeline : public FGameplayDebuggerCategory
+{
+public:
+	
+	FGameplayDebuggerCategory_CombatTimeline();
+	
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+	
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+	
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+	
+protected:
+	
+	/** Events of the debug actor inside the visible span, replicated to the viewer */
+	struct FRepData
+	{
+		FString FighterName;
+		double Now = 0.0;
+		TArray<FCombatTimelineEntry> Entries;
+		
+		void Serialize(FArchive& Ar);
+	};
+	
+	FRepData DataPack;
+	
+	/** Seconds of history shown across the timeline */
+	static constexpr double VisibleSeconds = 4.0;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
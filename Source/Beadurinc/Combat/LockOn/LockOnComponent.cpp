@@ -0,0 +1,439 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Combat/LockOn/LockOnComponent.h"
+#include "Actor/Character/FighterCharacter.h"
+#include "Combat/CombatSpatialIndexSubsystem.h"
+#include "Combat/CombatStats.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+
+namespace LockOnComponent
+{
+	/** How much farther than MaxDistance a target reported by a client may be, for movement while the request travels */
+	static constexpr float ServerDistanceSlack = 1.5F;
+}
+
+ULockOnComponent::ULockOnComponent()
+{
+	// Ticks to spread refreshes over frames, but only does work for a locally controlled owner
+	PrimaryComponentTick.bCanEverTick = true;
+	
+	// Replicated only to carry the locked target to the server
+	SetIsReplicatedByDefault(true);
+	
+	RefreshInterval = 0.1F;
+	CandidatesPerFrame = 4;
+	MaxDistance = 2500.0F;
+	MaxCrosshairAngle = 60.0F;
+	VisibilityTracesPerFrame = 4;
+	OcclusionUnlockSeconds = 1.5F;
+	FlickThreshold = 0.8F;
+	FlickRearmThreshold = 0.3F;
+	MouseFlickDistance = 40.0F;
+	MouseStrokeGap = 0.15F;
+	
+	BuildCursor = 0;
+	NextRefreshTime = 0.0;
+	LockedIndex = INDEX_NONE;
+	VisibilityCursor = 0;
+	LastLookFrame = 0;
+	MouseStrokeDistance = 0.0F;
+	LastMouseLookTime = 0.0;
+	bBuilding = false;
+	bFlickArmed = true;
+	bMouseFlickArmed = true;
+}
+
+AFighterCharacter* ULockOnComponent::FindBestTarget() const
+{
+	AFighterCharacter* BestTarget = nullptr;
+	float BestAngle = TNumericLimits<float>::Max();
+	
+	for (const FLockOnCandidate& Candidate : Candidates)
+	{
+		AFighterCharacter* Fighter = Candidate.Fighter.Get();
+		
+		if (Fighter && Candidate.CrosshairAngle < BestAngle && IsVisible(Fighter))
+		{
+			BestTarget = Fighter;
+			BestAngle = Candidate.CrosshairAngle;
+		}
+	}
+	
+	return BestTarget;
+}
+
+void ULockOnComponent::SetLockedTarget(AFighterCharacter* Target)
+{
+	// Already locked, SwitchTarget keeps the index up to date itself
+	if (Target == LockedTarget.Get())
+	{
+		return;
+	}
+	
+	if (Target)
+	{
+		// A target locked out of sight gets the whole grace period before it is lost
+		FLockOnVisibility& Visibility = VisibilityCache.FindOrAdd(Target);
+		
+		if (!Visibility.bVisible)
+		{
+			Visibility.LastVisibleTime = GetWorld()->GetTimeSeconds();
+		}
+	}
+	
+	LockedTarget = Target;
+	LockedIndex = FindCandidateIndex(Target);
+	
+	ReportLockedTarget();
+}
+
+AFighterCharacter* ULockOnComponent::SwitchTarget(int32 Direction)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_LockOn);
+	
+	if (LockedIndex == INDEX_NONE || Direction == 0)
+	{
+		return nullptr;
+	}
+	
+	const int32 Step = FMath::Sign(Direction);
+	
+	// The neighbour is usually visible, occluded ones are stepped over
+	for (int32 NextIndex = LockedIndex + Step; Candidates.IsValidIndex(NextIndex); NextIndex += Step)
+	{
+		AFighterCharacter* Next = Candidates[NextIndex].Fighter.Get();
+		
+		if (Next && IsVisible(Next))
+		{
+			LockedTarget = Next;
+			LockedIndex = NextIndex;
+			ReportLockedTarget();
+			
+			return Next;
+		}
+	}
+	
+	return nullptr;
+}
+
+void ULockOnComponent::ServerSetLockedTarget_Implementation(AFighterCharacter* Target)
+{
+	const AFighterCharacter* Owner = GetOwner<AFighterCharacter>();
+	
+	// Only a hostile fighter in lock on range, so a client cannot have any fighter replicated to it at the engaged rate
+	if (Target && (!Owner || Target == Owner || !Owner->IsHostileTo(Target)
+		|| FVector::DistSquared(Owner->GetActorLocation(), Target->GetActorLocation()) > FMath::Square(MaxDistance * LockOnComponent::ServerDistanceSlack)))
+	{
+		Target = nullptr;
+	}
+	
+	LockedTarget = Target;
+}
+
+void ULockOnComponent::ReportLockedTarget()
+{
+	const APawn* Pawn = GetOwner<APawn>();
+	
+	// A listen server host already holds the target where the replication graph reads it
+	if (Pawn && Pawn->IsLocallyControlled() && !Pawn->HasAuthority())
+	{
+		ServerSetLockedTarget(LockedTarget.Get());
+	}
+}
+
+bool ULockOnComponent::IsLockedTargetLost() const
+{
+	const AFighterCharacter* Target = LockedTarget.Get();
+	const FLockOnVisibility* Visibility = Target ? VisibilityCache.Find(Target) : nullptr;
+	
+	if (!Visibility || Visibility->bVisible)
+	{
+		return false;
+	}
+	
+	return GetWorld()->GetTimeSeconds() - Visibility->LastVisibleTime > OcclusionUnlockSeconds;
+}
+
+bool ULockOnComponent::IsVisible(const AFighterCharacter* Fighter) const
+{
+	const FLockOnVisibility* Visibility = VisibilityCache.Find(Fighter);
+	return Visibility && Visibility->bVisible;
+}
+
+AFighterCharacter* ULockOnComponent::HandleLookInput(float Yaw)
+{
+	// Look input is only fed while the stick is tilted, a gap means it has been released
+	if (GFrameCounter > LastLookFrame + 1 || FMath::Abs(Yaw) < FlickRearmThreshold)
+	{
+		bFlickArmed = true;
+	}
+	
+	LastLookFrame = GFrameCounter;
+	
+	if (!bFlickArmed || FMath::Abs(Yaw) < FlickThreshold)
+	{
+		return nullptr;
+	}
+	
+	bFlickArmed = false;
+	
+	return SwitchTarget(Yaw > 0.0F ? 1 : -1);
+}
+
+AFighterCharacter* ULockOnComponent::HandleMouseLookInput(float Yaw)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+	
+	// Mouse input only arrives while the mouse moves, a pause or a turn back starts a new stroke
+	if (Now - LastMouseLookTime > MouseStrokeGap || Yaw * MouseStrokeDistance < 0.0F)
+	{
+		MouseStrokeDistance = 0.0F;
+		bMouseFlickArmed = true;
+	}
+	
+	LastMouseLookTime = Now;
+	MouseStrokeDistance += Yaw;
+	
+	if (!bMouseFlickArmed || FMath::Abs(MouseStrokeDistance) < MouseFlickDistance)
+	{
+		return nullptr;
+	}
+	
+	bMouseFlickArmed = false;
+	
+	return SwitchTarget(MouseStrokeDistance > 0.0F ? 1 : -1);
+}
+
+void ULockOnComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	COMBAT_SCOPE_CYCLE_COUNTER(STAT_Combat_LockOn);
+	
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	
+	const APawn* Pawn = GetOwner<APawn>();
+	
+	// Only the player looking through this pawn locks on
+	if (!Pawn || !Pawn->IsLocallyControlled())
+	{
+		return;
+	}
+	
+	ResolveVisibilityTraces();
+	
+	if (!bBuilding && GetWorld()->GetTimeSeconds() >= NextRefreshTime)
+	{
+		BeginRefresh();
+	}
+	
+	if (bBuilding)
+	{
+		ContinueRefresh();
+	}
+	
+	IssueVisibilityTraces();
+}
+
+void ULockOnComponent::BeginRefresh()
+{
+	const UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>();
+	
+	if (!SpatialIndex)
+	{
+		return;
+	}
+	
+	TArray<AFighterCharacter*> Fighters;
+	SpatialIndex->FindFightersInRadius(GetOwner()->GetActorLocation(), MaxDistance, Fighters);
+	
+	PendingFighters.Reset();
+	PendingFighters.Append(Fighters);
+	
+	// The locked target stays listed wherever it went, so switching always starts from it
+	if (AFighterCharacter* Target = LockedTarget.Get(); Target && !Fighters.Contains(Target))
+	{
+		PendingFighters.Add(Target);
+	}
+	
+	BuildingCandidates.Reset();
+	BuildCursor = 0;
+	bBuilding = true;
+	NextRefreshTime = GetWorld()->GetTimeSeconds() + RefreshInterval;
+}
+
+void ULockOnComponent::ContinueRefresh()
+{
+	const AFighterCharacter* Owner = GetOwner<AFighterCharacter>();
+	const AController* Controller = Owner ? Owner->GetController() : nullptr;
+	
+	if (!Controller)
+	{
+		bBuilding = false;
+		return;
+	}
+	
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	
+	const FRotationMatrix ViewAxes(ViewRotation);
+	const FVector Forward = ViewAxes.GetUnitAxis(EAxis::X);
+	const FVector Right = ViewAxes.GetUnitAxis(EAxis::Y);
+	const float MinCrosshairCos = FMath::Cos(FMath::DegreesToRadians(MaxCrosshairAngle));
+	
+	const int32 End = FMath::Min(BuildCursor + CandidatesPerFrame, PendingFighters.Num());
+	
+	for (; BuildCursor < End; ++BuildCursor)
+	{
+		AFighterCharacter* Fighter = PendingFighters[BuildCursor].Get();
+		
+		if (!Fighter || Fighter == Owner)
+		{
+			continue;
+		}
+		
+		const bool bLocked = Fighter == LockedTarget.Get();
+		
+		if (!bLocked && !Owner->IsHostileTo(Fighter))
+		{
+			continue;
+		}
+		
+		const FVector ToFighter = (Fighter->GetActorLocation() - ViewLocation).GetSafeNormal();
+		const float CrosshairCos = FVector::DotProduct(ToFighter, Forward);
+		
+		if (!bLocked && CrosshairCos < MinCrosshairCos)
+		{
+			continue;
+		}
+		
+		FLockOnCandidate& Candidate = BuildingCandidates.AddDefaulted_GetRef();
+		Candidate.Fighter = Fighter;
+		Candidate.ScreenAngle = FMath::RadiansToDegrees(FMath::Atan2(FVector::DotProduct(ToFighter, Right), CrosshairCos));
+		Candidate.CrosshairAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(CrosshairCos, -1.0F, 1.0F)));
+	}
+	
+	if (BuildCursor >= PendingFighters.Num())
+	{
+		PublishCandidates();
+	}
+}
+
+void ULockOnComponent::PublishCandidates()
+{
+	BuildingCandidates.Sort([](const FLockOnCandidate& A, const FLockOnCandidate& B) { return A.ScreenAngle < B.ScreenAngle; });
+	
+	Swap(Candidates, BuildingCandidates);
+	BuildingCandidates.Reset();
+	PendingFighters.Reset();
+	bBuilding = false;
+	
+	LockedIndex = FindCandidateIndex(LockedTarget.Get());
+	
+	// Forget the visibility of fighters no longer listed
+	const TObjectKey<AFighterCharacter> LockedKey(LockedTarget.Get());
+	
+	for (TMap<TObjectKey<AFighterCharacter>, FLockOnVisibility>::TIterator It = VisibilityCache.CreateIterator(); It; ++It)
+	{
+		const TObjectKey<AFighterCharacter> Key = It.Key();
+		
+		if (Key != LockedKey && !Candidates.ContainsByPredicate([&Key](const FLockOnCandidate& Candidate) { return Key == TObjectKey<AFighterCharacter>(Candidate.Fighter.Get()); }))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+int32 ULockOnComponent::FindCandidateIndex(const AFighterCharacter* Fighter) const
+{
+	return Fighter ? Candidates.IndexOfByPredicate([Fighter](const FLockOnCandidate& Candidate) { return Candidate.Fighter == Fighter; }) : INDEX_NONE;
+}
+
+void ULockOnComponent::ResolveVisibilityTraces()
+{
+	const UWorld* World = GetWorld();
+	const double Now = World->GetTimeSeconds();
+	
+	for (const TObjectKey<AFighterCharacter>& Key : TracedFighters)
+	{
+		FLockOnVisibility* Visibility = VisibilityCache.Find(Key);
+		
+		if (!Visibility)
+		{
+			continue;
+		}
+		
+		FTraceDatum Trace;
+		const bool bResolved = World->QueryTraceData(Visibility->PendingTrace, Trace);
+		Visibility->PendingTrace = FTraceHandle();
+		
+		if (!bResolved)
+		{
+			continue;
+		}
+		
+		Visibility->bVisible = Trace.OutHits.IsEmpty() || !Trace.OutHits[0].bBlockingHit;
+		
+		if (Visibility->bVisible)
+		{
+			Visibility->LastVisibleTime = Now;
+		}
+	}
+	
+	TracedFighters.Reset();
+}
+
+void ULockOnComponent::IssueVisibilityTraces()
+{
+	const APawn* Pawn = GetOwner<APawn>();
+	const AController* Controller = Pawn->GetController();
+	
+	if (!Controller)
+	{
+		return;
+	}
+	
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Controller->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	
+	// The locked target every frame, so losing sight of it is noticed without delay
+	if (AFighterCharacter* Target = LockedTarget.Get())
+	{
+		TraceVisibility(Target, ViewLocation);
+	}
+	
+	// The other candidates in turn
+	const int32 Count = FMath::Min(VisibilityTracesPerFrame, Candidates.Num());
+	
+	for (int32 Traced = 0; Traced < Count; ++Traced)
+	{
+		if (VisibilityCursor >= Candidates.Num())
+		{
+			VisibilityCursor = 0;
+		}
+		
+		if (AFighterCharacter* Fighter = Candidates[VisibilityCursor++].Fighter.Get())
+		{
+			TraceVisibility(Fighter, ViewLocation);
+		}
+	}
+}
+
+void ULockOnComponent::TraceVisibility(AFighterCharacter* Fighter, const FVector& ViewLocation)
+{
+	FLockOnVisibility& Visibility = VisibilityCache.FindOrAdd(Fighter);
+	
+	if (Visibility.PendingTrace.IsValid())
+	{
+		return;
+	}
+	
+	// Only the world between the view and the fighter's body can hide it
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LockOnVisibility), false, GetOwner());
+	QueryParams.AddIgnoredActor(Fighter);
+	
+	COMBAT_COUNT(Traces);
+	Visibility.PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, ViewLocation, Fighter->GetActorLocation(), ECC_Visibility, QueryParams);
+	TracedFighters.Add(Fighter);
+}
@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "LockOnComponent.generated.h"
+
+class AFighterCharacter;
+
+/** A fighter that can be locked on, as seen from the view when its list was refreshed */
+struct FLockOnCandidate
+{
+	TWeakObjectPtr<AFighterCharacter> Fighter;
+	
+	/** Horizontal angle from the view's forward in degrees, negative to the left */
+	float ScreenAngle = 0.0F;
+	
+	/** Angle from the view's forward in degrees, how far the fighter is from the crosshair */
+	float CrosshairAngle = 0.0F;
+};
+
+/** Whether a fighter could be seen, as of its latest visibility trace */
+struct FLockOnVisibility
+{
+	/** Trace in flight for this fighter, resolved the frame after it was issued */
+	FTraceHandle PendingTrace;
+	
+	/** World time the fighter was last seen */
+	double LastVisibleTime = 0.0;
+	
+	bool bVisible = false;
+};
+
+/**
+ * Keeps the lock-on candidates of a locally controlled fighter: the hostile fighters in front of
+ * its view, sorted from left to right.
+ *
+ * The list is rebuilt at a low fixed rate. A rebuild gathers the fighters around the owner from
+ * the combat spatial index and scores a few of them per frame, so its cost is spread over the
+ * frames between refreshes, and the new list replaces the old one only once it is complete. The
+ * locked target always stays in the list and remembers its position in it, so switching to its
+ * left or right neighbour is a single index step.
+ *
+ * Candidates behind walls are never picked. Their visibility is cached per fighter and kept up
+ * to date by asynchronous line traces from the view, a few candidates per frame, so no frame
+ * waits on a trace. The locked target is traced every frame, and is reported lost once it has
+ * stayed out of sight for OcclusionUnlockSeconds.
+ */
+UCLASS(ClassGroup = (Beadurinc), meta = (BlueprintSpawnableComponent))
+class BEADURINC_API ULockOnComponent : public UActorComponent
+{
+	GENERATED_BODY()
+	
+	/** Seconds between candidate list refreshes */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float RefreshInterval;
+	
+	/** Candidates scored per frame while a refresh is building */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "1"))
+	int32 CandidatesPerFrame;
+	
+	/** How far from the owner a fighter can be locked on */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float MaxDistance;
+	
+	/** How far from the crosshair in degrees a fighter can be locked on */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0", ClampMax = "180.0"))
+	float MaxCrosshairAngle;
+	
+	/** Candidates whose visibility is traced per frame, on top of the locked target */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0"))
+	int32 VisibilityTracesPerFrame;
+	
+	/** Seconds the locked target may stay out of sight before the lock is dropped */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float OcclusionUnlockSeconds;
+	
+	/** Horizontal look input past which a flick switches the target */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float FlickThreshold;
+	
+	/** Horizontal look input under which the next flick is accepted */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float FlickRearmThreshold;
+	
+	/** Horizontal mouse movement, in look input units, that switches the target when made in one stroke */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0"))
+	float MouseFlickDistance;
+	
+	/** Seconds without mouse movement that end a stroke */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float MouseStrokeGap;
+	
+public:
+	
+	ULockOnComponent();
+	
+	/** Returns the visible candidate nearest to the crosshair, null if there is none */
+	AFighterCharacter* FindBestTarget() const;
+	
+	/** Sets the locked target, which stays a candidate wherever it is, and tells the server. Null clears it */
+	void SetLockedTarget(AFighterCharacter* Target);
+	
+	/** Locks on the next visible candidate to the right (positive) or left (negative) of the locked target. Returns it, null if there is none */
+	AFighterCharacter* SwitchTarget(int32 Direction);
+	
+	/**
+	 * Feeds horizontal look input while locked on. A flick of the stick past FlickThreshold switches
+	 * to the neighbouring candidate on that side; the stick has to return under FlickRearmThreshold
+	 * before the next flick. Returns the new target, null if the target did not change.
+	 */
+	AFighterCharacter* HandleLookInput(float Yaw);
+	
+	/**
+	 * Feeds horizontal mouse movement while locked on. Mouse deltas arrive with every small movement,
+	 * so they are summed over a stroke instead: moving MouseFlickDistance one way switches to the
+	 * neighbouring candidate on that side, once per stroke. Returns the new target, null if the target did not change.
+	 */
+	AFighterCharacter* HandleMouseLookInput(float Yaw);
+	
+	FORCEINLINE AFighterCharacter* GetLockedTarget() const { return LockedTarget.Get(); }
+	
+	/** Returns whether the locked target has been out of sight for longer than OcclusionUnlockSeconds */
+	bool IsLockedTargetLost() const;
+	
+	/** Returns whether a fighter was visible at its latest resolved trace */
+	bool IsVisible(const AFighterCharacter* Fighter) const;
+	
+	/** Returns the candidates of the latest complete refresh, sorted from left to right */
+	FORCEINLINE const TArray<FLockOnCandidate>& GetCandidates() const { return Candidates; }
+	
+protected:
+	
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	
+private:
+	
+	/** Keeps the server's copy of the locked target, read by the replication graph to find who is fighting whom. Cleared instead when the target is not a hostile fighter in range */
+	UFUNCTION(Server, Reliable)
+	void ServerSetLockedTarget(AFighterCharacter* Target);
+	
+	/** Sends a locked target change of a remotely served owner to the server */
+	void ReportLockedTarget();
+	
+	/** Gathers the fighters around the owner to score over the next frames */
+	void BeginRefresh();
+	
+	/** Scores up to CandidatesPerFrame gathered fighters. Publishes the list once all are scored */
+	void ContinueRefresh();
+	
+	/** Sorts the built list and makes it the current one */
+	void PublishCandidates();
+	
+	/** Returns the position of a fighter in Candidates, INDEX_NONE if it is not listed */
+	int32 FindCandidateIndex(const AFighterCharacter* Fighter) const;
+	
+	/** Reads the visibility traces issued last frame into the cache */
+	void ResolveVisibilityTraces();
+	
+	/** Issues the visibility traces of the locked target and of the next few candidates */
+	void IssueVisibilityTraces();
+	
+	/** Issues a line trace from the view to a fighter, unless one is in flight already */
+	void TraceVisibility(AFighterCharacter* Fighter, const FVector& ViewLocation);
+	
+private:
+	
+	/** Candidates of the latest complete refresh, sorted by ScreenAngle */
+	TArray<FLockOnCandidate> Candidates;
+	
+	/** Candidates of the refresh being built */
+	TArray<FLockOnCandidate> BuildingCandidates;
+	
+	/** Fighters gathered by the refresh being built */
+	TArray<TWeakObjectPtr<AFighterCharacter>> PendingFighters;
+	
+	/** Next fighter of PendingFighters to score */
+	int32 BuildCursor;
+	
+	/** World time the next refresh begins at */
+	double NextRefreshTime;
+	
+	TWeakObjectPtr<AFighterCharacter> LockedTarget;
+	
+	/** Position of the locked target in Candidates, INDEX_NONE if it is not listed yet */
+	int32 LockedIndex;
+	
+	/** Visibility of the listed fighters and of the locked target */
+	TMap<TObjectKey<AFighterCharacter>, FLockOnVisibility> VisibilityCache;
+	
+	/** Fighters with a visibility trace in flight */
+	TArray<TObjectKey<AFighterCharacter>> TracedFighters;
+	
+	/** Next candidate whose visibility is traced */
+	int32 VisibilityCursor;
+	
+	/** Frame the last look input was fed, stick input stops arriving once it is released */
+	uint64 LastLookFrame;
+	
+	/** Horizontal mouse movement of the current stroke */
+	float MouseStrokeDistance;
+	
+	/** World time the last mouse movement was fed */
+	double LastMouseLookTime;
+	
+	bool bBuilding;
+	
+	bool bFlickArmed;
+	
+	bool bMouseFlickArmed;
+};
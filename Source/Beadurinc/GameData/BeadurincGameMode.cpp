@@ -1,8 +1,10 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "BeadurincGameMode.h"
+#include "GameData/BeadurincGameState.h"
 
 ABeadurincGameMode::ABeadurincGameMode()
 {
-	// stub
+	// Replicates the combat seed
+	GameStateClass = ABeadurincGameState::StaticClass();
 }
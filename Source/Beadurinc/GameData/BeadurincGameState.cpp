@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameData/BeadurincGameState.h"
+#include "Net/UnrealNetwork.h"
+
+ABeadurincGameState::ABeadurincGameState()
+{
+	MatchSeed = 0;
+	NextCombatId = 0;
+}
+
+FRandomStream ABeadurincGameState::MakeCombatStream(uint32 Salt) const
+{
+	return FRandomStream(static_cast<int32>(HashCombineFast(static_cast<uint32>(MatchSeed), Salt)));
+}
+
+void ABeadurincGameState::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+	
+	if (HasAuthority())
+	{
+		// A fixed seed reproduces a recorded match
+		if (!FParse::Value(FCommandLine::Get(), TEXT("CombatSeed="), MatchSeed))
+		{
+			MatchSeed = FMath::Rand();
+		}
+	}
+}
+
+void ABeadurincGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	
+	DOREPLIFETIME_CONDITION(ABeadurincGameState, MatchSeed, COND_InitialOnly);
+}
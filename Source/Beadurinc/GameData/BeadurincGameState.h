@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "BeadurincGameState.generated.h"
+
+/**
+ * GameState: Replicates match-wide data to every client.
+ *
+ * Holds the seed of the combat random stream. Every random combat decision derives its
+ * stream from this seed and a per-decision salt, so the server, predicting clients and
+ * replays all roll the same numbers for the same hit.
+ */
+UCLASS()
+class BEADURINC_API ABeadurincGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+	
+	/** Seed of every combat roll in this match. Chosen by the server, or by -CombatSeed= on its command line */
+	UPROPERTY(Replicated)
+	int32 MatchSeed;
+	
+	/** Combat id handed to the next fighter, on the server */
+	uint32 NextCombatId;
+	
+public:
+	
+	/** Constructor */
+	ABeadurincGameState();
+	
+	/** Returns a stream for one combat decision, identified by Salt */
+	FRandomStream MakeCombatStream(uint32 Salt) const;
+	
+	/** Returns a new fighter id to salt combat rolls with. Server only, ids reach clients with their fighter */
+	FORCEINLINE uint32 AllocateCombatId() { return ++NextCombatId; }
+	
+	/** Returns the seed shared by the server and clients */
+	FORCEINLINE int32 GetMatchSeed() const { return MatchSeed; }
+	
+protected:
+	
+	/** Picks the match seed on the server */
+	virtual void PostInitializeComponents() override;
+	
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+};
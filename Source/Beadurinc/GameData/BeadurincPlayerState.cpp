@@ -3,6 +3,10 @@
 #include "BeadurincPlayerState.h"
 #include "AbilitySystemComponent.h"
 #include "AbilitySystem/AbilityId.h"
+#include "AbilitySystem/AbilitySet/FighterAbilitySet.h"
+#include "AbilitySystem/Subsystem/StatProfileSubsystem.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "Engine/GameInstance.h"
 
 ABeadurincPlayerState::ABeadurincPlayerState()
 {
@@ -23,26 +27,7 @@ void ABeadurincPlayerState::BeginPlay()
 	// Initialize only in authorized side to let them replicated to clients by networking
 	if (HasAuthority())
 	{
-		// Give combo attack ability
-		if (IsValid(ComboAttackAbility))
-		{
-			FGameplayAbilitySpec ComboAttackAbilitySpec(ComboAttackAbility, 1, static_cast<int32>(EAbilityId::Combo_Attack), this);
-			AbilitySystemComponent->GiveAbility(ComboAttackAbilitySpec);
-		}
-		
-		// Give block ability
-		if (IsValid(BlockAbility))
-		{
-			FGameplayAbilitySpec BlockAbilitySpec(BlockAbility, 1, static_cast<int32>(EAbilityId::Block), this);
-			AbilitySystemComponent->GiveAbility(BlockAbilitySpec);
-		}
-		
-		// Give roll ability
-		if (IsValid(RollAbility))
-		{
-			FGameplayAbilitySpec RollAbilitySpec(RollAbility, 1, static_cast<int32>(EAbilityId::Roll), this);
-			AbilitySystemComponent->GiveAbility(RollAbilitySpec);
-		}
+		LLM_SCOPE_BYTAG(Beadurinc_AbilitySystem);
 		
 		if (AttributeSetClass)
 		{
@@ -54,6 +39,35 @@ void ABeadurincPlayerState::BeginPlay()
 			
 			ResetStats();
 		}
+		
+		// Granted after the attribute set exists, so starting effects have attributes to modify
+		if (AbilitySet)
+		{
+			AbilitySetLoadHandle = AbilitySet->LoadAndGiveToAbilitySystem(AbilitySystemComponent, this);
+		}
+		else
+		{
+			// Give combo attack ability
+			if (IsValid(ComboAttackAbility))
+			{
+				FGameplayAbilitySpec ComboAttackAbilitySpec(ComboAttackAbility, 1, static_cast<int32>(EAbilityId::Combo_Attack), this);
+				AbilitySystemComponent->GiveAbility(ComboAttackAbilitySpec);
+			}
+			
+			// Give block ability
+			if (IsValid(BlockAbility))
+			{
+				FGameplayAbilitySpec BlockAbilitySpec(BlockAbility, 1, static_cast<int32>(EAbilityId::Block), this);
+				AbilitySystemComponent->GiveAbility(BlockAbilitySpec);
+			}
+			
+			// Give roll ability
+			if (IsValid(RollAbility))
+			{
+				FGameplayAbilitySpec RollAbilitySpec(RollAbility, 1, static_cast<int32>(EAbilityId::Roll), this);
+				AbilitySystemComponent->GiveAbility(RollAbilitySpec);
+			}
+		}
 	}
 }
 
@@ -61,6 +75,10 @@ void ABeadurincPlayerState::ResetStats()
 {
 	if (InitialStatsTable)
 	{
-		AbilitySystemComponent->InitStats(AttributeSetClass, InitialStatsTable);
+		// Compiled once per game instance, so respawns skip the reflection walk and row lookups of InitStats
+		if (UStatProfileSubsystem* StatProfiles = UGameInstance::GetSubsystem<UStatProfileSubsystem>(GetGameInstance()))
+		{
+			StatProfiles->ApplyStatProfile(AbilitySystemComponent, AttributeSet, InitialStatsTable);
+		}
 	}
 }
@@ -8,6 +8,9 @@
 #include "GameFramework/PlayerState.h"
 #include "BeadurincPlayerState.generated.h"
 
+class UFighterAbilitySet;
+struct FStreamableHandle;
+
 /**
  * PlayerState: This object exists in both client and server side, including remote clients.
  *				It allows referencing other players to see the states of a specific player.
@@ -39,6 +42,10 @@ class BEADURINC_API ABeadurincPlayerState : public APlayerState, public IAbility
 	UPROPERTY(EditDefaultsOnly, Category="Attribute")
 	TSubclassOf<UAttributeSet> AttributeSetClass;
 	
+	/** Abilities and starting effects granted to the player. When unset, the ability classes below are granted */
+	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Abilities")
+	TObjectPtr<UFighterAbilitySet> AbilitySet;
+	
 	/** Gameplay Ability class for Combo Attacks */
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Abilities")
 	TSubclassOf<UGameplayAbility> ComboAttackAbility;
@@ -55,6 +62,9 @@ class BEADURINC_API ABeadurincPlayerState : public APlayerState, public IAbility
 	UPROPERTY(EditDefaultsOnly, Category = "Gameplay Abilities")
 	TObjectPtr<UDataTable> InitialStatsTable;
 	
+	/** Keeps the ability set's classes loading until they are granted */
+	TSharedPtr<FStreamableHandle> AbilitySetLoadHandle;
+	
 protected:
 	/** Gameplay Abilities Attribute Set */
 	UPROPERTY()
@@ -74,4 +84,7 @@ public:
 	FORCEINLINE virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override { return AbilitySystemComponent; };
 	
 	FORCEINLINE virtual TObjectPtr<UAttributeSet> GetAttributeSet() const { return AttributeSet; };
+	
+	/** Returns the abilities granted to the player, null when the ability classes are granted instead **/
+	FORCEINLINE const UFighterAbilitySet* GetAbilitySet() const { return AbilitySet; }
 };
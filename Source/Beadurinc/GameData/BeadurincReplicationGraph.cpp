@@ -0,0 +1,304 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameData/BeadurincReplicationGraph.h"
+#include "Actor/Character/PlayerCharacter.h"
+#include "Combat/CombatSpatialIndexSubsystem.h"
+#include "Combat/LockOn/LockOnComponent.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/IConsoleManager.h"
+#include "ReplicationGraphTypes.h"
+#include "UObject/UObjectIterator.h"
+
+static bool GBeadurincRepGraphEnabled = true;
+static FAutoConsoleVariableRef CVarBeadurincRepGraphEnabled(
+	TEXT("Beadurinc.RepGraph.Enabled"),
+	GBeadurincRepGraphEnabled,
+	TEXT("Replicates through UBeadurincReplicationGraph instead of per actor relevancy. Read when a game net driver is created, so set it before hosting")
+);
+
+void UBeadurincReplicationGraphNode_AlwaysRelevant_ForConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	Super::GatherActorListsForConnection(Params);
+
+	PlayerStates.Reset();
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const APlayerController* PlayerController = Cast<APlayerController>(Viewer.InViewer);
+
+		if (PlayerController && PlayerController->PlayerState)
+		{
+			PlayerStates.ConditionalAdd(PlayerController->PlayerState);
+		}
+	}
+
+	if (PlayerStates.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(PlayerStates);
+	}
+}
+
+void UBeadurincReplicationGraphNode_CombatEngaged::NotifyResetAllNetworkActors()
+{
+	EngagedActors.Reset();
+	BoostedActors.Reset();
+}
+
+void UBeadurincReplicationGraphNode_CombatEngaged::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	EngagedActors.Reset();
+
+	const UWorld* World = GetWorld();
+	const UCombatSpatialIndexSubsystem* SpatialIndex = World ? World->GetSubsystem<UCombatSpatialIndexSubsystem>() : nullptr;
+
+	TArray<AFighterCharacter*> Fighters;
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const APlayerController* PlayerController = Cast<APlayerController>(Viewer.InViewer);
+		const APlayerCharacter* Player = PlayerController ? Cast<APlayerCharacter>(PlayerController->GetPawn()) : nullptr;
+		AFighterCharacter* LockedTarget = Player ? Player->GetLockOnComponent()->GetLockedTarget() : nullptr;
+
+		if (!LockedTarget)
+		{
+			continue;
+		}
+
+		Fighters.Add(LockedTarget);
+
+		if (SpatialIndex)
+		{
+			SpatialIndex->FindFightersInRadius(LockedTarget->GetActorLocation(), EngagedRadius, Fighters);
+		}
+	}
+
+	FPerConnectionActorInfoMap& ConnectionActorInfoMap = Params.ConnectionManager.ActorInfoMap;
+
+	// Fighters that disengaged go back to the period of their class
+	for (const TWeakObjectPtr<AActor>& Boosted : BoostedActors)
+	{
+		AActor* Actor = Boosted.Get();
+
+		if (!Actor || Fighters.Contains(Actor))
+		{
+			continue;
+		}
+
+		if (FConnectionReplicationActorInfo* ConnectionInfo = ConnectionActorInfoMap.Find(Actor))
+		{
+			ConnectionInfo->ReplicationPeriodFrame = GraphGlobals->GlobalActorReplicationInfoMap->Get(Actor).Settings.ReplicationPeriodFrame;
+		}
+	}
+
+	BoostedActors.Reset();
+
+	for (AFighterCharacter* Fighter : Fighters)
+	{
+		if (EngagedActors.Contains(Fighter))
+		{
+			continue;
+		}
+
+		FConnectionReplicationActorInfo& ConnectionInfo = ConnectionActorInfoMap.FindOrAdd(Fighter);
+
+		if (ConnectionInfo.ReplicationPeriodFrame > EngagedPeriodFrame)
+		{
+			ConnectionInfo.ReplicationPeriodFrame = EngagedPeriodFrame;
+
+			// Do not wait out the slow period scheduled at the last replication
+			ConnectionInfo.NextReplicationFrameNum = FMath::Min(ConnectionInfo.NextReplicationFrameNum, ConnectionInfo.LastRepFrameNum + EngagedPeriodFrame);
+		}
+
+		EngagedActors.Add(Fighter);
+		BoostedActors.Add(Fighter);
+	}
+
+	// Engaged fighters are gathered again here, still culled by the grid's cull distance like any other fighter
+	if (EngagedActors.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(EngagedActors);
+	}
+}
+
+UBeadurincReplicationGraph::UBeadurincReplicationGraph()
+{
+	CellSize = 10000.0F;
+	SpatialBias = FVector2D(-200000.0, -200000.0);
+	FighterNetUpdateFrequency = 20.0F;
+	FighterCullDistance = 15000.0F;
+	CombatEngagedRadius = 1500.0F;
+	CombatEngagedNetUpdateFrequency = 60.0F;
+	PlayerStatesPerFrame = 8;
+}
+
+UReplicationDriver* UBeadurincReplicationGraph::CreateForNetDriver(UNetDriver* ForNetDriver, const FURL& URL, UWorld* World)
+{
+	// Demo and beacon drivers keep the default relevancy
+	if (!GBeadurincRepGraphEnabled || !ForNetDriver || ForNetDriver->NetDriverName != NAME_GameNetDriver || !World || !World->IsGameWorld())
+	{
+		return nullptr;
+	}
+
+	return NewObject<UBeadurincReplicationGraph>(GetTransientPackage());
+}
+
+void UBeadurincReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Every replicated class loaded so far. Blueprint classes loaded later use their closest native parent's settings
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		const AActor* Defaults = Class->IsChildOf<AActor>() ? Class->GetDefaultObject<AActor>() : nullptr;
+
+		if (!Defaults || !Defaults->GetIsReplicated() || Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		ClassRepNodePolicies.Set(Class, ComputeMappingPolicy(Class));
+
+		FClassReplicationInfo ClassInfo;
+
+		if (Class->IsChildOf<AFighterCharacter>())
+		{
+			ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FighterNetUpdateFrequency);
+			ClassInfo.SetCullDistanceSquared(FMath::Square(FighterCullDistance));
+		}
+		else
+		{
+			ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Defaults->GetNetUpdateFrequency());
+			ClassInfo.SetCullDistanceSquared(Defaults->GetNetCullDistanceSquared());
+		}
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UBeadurincReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = CellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	PlayerStateNode = CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode->TargetActorsPerFrame = PlayerStatesPerFrame;
+	AddGlobalGraphNode(PlayerStateNode);
+}
+
+void UBeadurincReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	// The connection's controller, pawn, view target and player state
+	UBeadurincReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantForConnection = CreateNewNode<UBeadurincReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantForConnection, RepGraphConnection);
+
+	UBeadurincReplicationGraphNode_CombatEngaged* CombatEngagedNode = CreateNewNode<UBeadurincReplicationGraphNode_CombatEngaged>();
+	CombatEngagedNode->EngagedRadius = CombatEngagedRadius;
+	CombatEngagedNode->EngagedPeriodFrame = GetReplicationPeriodFrameForFrequency(CombatEngagedNetUpdateFrequency);
+	AddConnectionGraphNode(CombatEngagedNode, RepGraphConnection);
+}
+
+void UBeadurincReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EBeadurincClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::PlayerState:
+		PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void UBeadurincReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EBeadurincClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	case EBeadurincClassRepNodeMapping::PlayerState:
+		PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+EBeadurincClassRepNodeMapping UBeadurincReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	if (const EBeadurincClassRepNodeMapping* Mapping = ClassRepNodePolicies.Get(Class))
+	{
+		return *Mapping;
+	}
+
+	const EBeadurincClassRepNodeMapping Mapping = ComputeMappingPolicy(Class);
+	ClassRepNodePolicies.Set(Class, Mapping);
+	return Mapping;
+}
+
+EBeadurincClassRepNodeMapping UBeadurincReplicationGraph::ComputeMappingPolicy(const UClass* Class)
+{
+	// Fighters move every frame, and are the actors worth culling by distance
+	if (Class->IsChildOf<AFighterCharacter>())
+	{
+		return EBeadurincClassRepNodeMapping::Spatialize_Dynamic;
+	}
+
+	if (Class->IsChildOf<APlayerState>())
+	{
+		return EBeadurincClassRepNodeMapping::PlayerState;
+	}
+
+	const AActor* Defaults = Class->GetDefaultObject<AActor>();
+
+	if (Defaults->bOnlyRelevantToOwner)
+	{
+		return EBeadurincClassRepNodeMapping::NotRouted;
+	}
+
+	if (Defaults->bAlwaysRelevant)
+	{
+		return EBeadurincClassRepNodeMapping::RelevantAllConnections;
+	}
+
+	const USceneComponent* Root = Defaults->GetRootComponent();
+
+	if (!Root || Defaults->IsReplicatingMovement() || Root->Mobility == EComponentMobility::Movable)
+	{
+		return Defaults->NetDormancy > DORM_Awake ? EBeadurincClassRepNodeMapping::Spatialize_Dormancy : EBeadurincClassRepNodeMapping::Spatialize_Dynamic;
+	}
+
+	return EBeadurincClassRepNodeMapping::Spatialize_Static;
+}
@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "BeadurincReplicationGraph.generated.h"
+
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_PlayerStateFrequencyLimiter;
+
+/** Which node of the graph an actor class is replicated through */
+enum class EBeadurincClassRepNodeMapping : uint8
+{
+	/** Not routed to a global node. Owner only actors reach their owner through the per connection node */
+	NotRouted,
+
+	/** Replicated to every connection */
+	RelevantAllConnections,
+
+	/** Spatialized once, for actors that never move */
+	Spatialize_Static,
+
+	/** Spatialized again every frame */
+	Spatialize_Dynamic,
+
+	/** Spatialized while awake, for dormant actors */
+	Spatialize_Dormancy,
+
+	/** Replicated to every connection a few at a time */
+	PlayerState
+};
+
+/**
+ * The connection's controller, pawn and view target, as the stock node gathers them, and the
+ * controller's player state. Player states otherwise only reach their own player a few at a time
+ * through the frequency limited list, and the player's ability system component lives on it.
+ */
+UCLASS()
+class BEADURINC_API UBeadurincReplicationGraphNode_AlwaysRelevant_ForConnection : public UReplicationGraphNode_AlwaysRelevant_ForConnection
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+
+	/** Player states of the connection's viewers, gathered every frame */
+	FActorRepListRefView PlayerStates;
+};
+
+/**
+ * Raises the replication frequency, for one connection, of the fighters fighting near the target
+ * its player is locked on to, and of the target itself.
+ */
+UCLASS()
+class BEADURINC_API UBeadurincReplicationGraphNode_CombatEngaged : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Fighters within this distance of the locked target are engaged */
+	float EngagedRadius = 1500.0F;
+
+	/** Replication period of engaged fighters, in server frames */
+	uint32 EngagedPeriodFrame = 1;
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override { }
+
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+
+	virtual void NotifyResetAllNetworkActors() override;
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+
+	/** Engaged fighters of the last gather */
+	FActorRepListRefView EngagedActors;
+
+	/** Fighters boosted by the last gather, restored to their class period once they disengage */
+	TArray<TWeakObjectPtr<AActor>> BoostedActors;
+};
+
+/**
+ * Replication graph of the game, used instead of per connection relevancy checks of every actor
+ * when Beadurinc.RepGraph.Enabled is set as the game net driver is created.
+ *
+ * Fighters are found through a 2D spatial grid and replicate at FighterNetUpdateFrequency, raised
+ * to CombatEngagedNetUpdateFrequency for connections whose player is locked on nearby. Player
+ * states, which hold the players' ability system components, replicate to their own player every
+ * frame, and to everyone else through a frequency limited list.
+ * Weapons are components of their fighter and replicate with it.
+ */
+UCLASS(Transient, Config = Game)
+class BEADURINC_API UBeadurincReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+	/** Size of a cell of the spatial grid */
+	UPROPERTY(Config, EditAnywhere, Category = "Grid", meta = (ClampMin = "100.0", Units = "Centimeters"))
+	float CellSize;
+
+	/** Smallest X and Y of the playable area, so the grid does not have to grow towards it */
+	UPROPERTY(Config, EditAnywhere, Category = "Grid")
+	FVector2D SpatialBias;
+
+	/** Replication frequency of fighters nobody is fighting near */
+	UPROPERTY(Config, EditAnywhere, Category = "Fighters", meta = (ClampMin = "1.0"))
+	float FighterNetUpdateFrequency;
+
+	/** Distance past which fighters are not replicated to a connection */
+	UPROPERTY(Config, EditAnywhere, Category = "Fighters", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float FighterCullDistance;
+
+	/** Fighters within this distance of a connection's locked target are engaged for that connection */
+	UPROPERTY(Config, EditAnywhere, Category = "Fighters", meta = (ClampMin = "0.0", Units = "Centimeters"))
+	float CombatEngagedRadius;
+
+	/** Replication frequency of engaged fighters */
+	UPROPERTY(Config, EditAnywhere, Category = "Fighters", meta = (ClampMin = "1.0"))
+	float CombatEngagedNetUpdateFrequency;
+
+	/** Player states of other players replicated to a connection per frame */
+	UPROPERTY(Config, EditAnywhere, Category = "Player States", meta = (ClampMin = "1"))
+	int32 PlayerStatesPerFrame;
+
+public:
+
+	UBeadurincReplicationGraph();
+
+	/** Creates the graph for the game net driver while Beadurinc.RepGraph.Enabled is set, bound to UReplicationDriver::CreateReplicationDriverDelegate */
+	static UReplicationDriver* CreateForNetDriver(UNetDriver* ForNetDriver, const FURL& URL, UWorld* World);
+
+	virtual void InitGlobalActorClassSettings() override;
+
+	virtual void InitGlobalGraphNodes() override;
+
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+private:
+
+	/** Returns the node mapping of a class, deciding it from the class defaults the first time */
+	EBeadurincClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	/** Decides the node mapping of a class from its defaults */
+	static EBeadurincClassRepNodeMapping ComputeMappingPolicy(const UClass* Class);
+
+private:
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+	UPROPERTY()
+	TObjectPtr<UReplicationGraphNode_PlayerStateFrequencyLimiter> PlayerStateNode;
+
+	/** Node mapping by class */
+	TClassMap<EBeadurincClassRepNodeMapping> ClassRepNodePolicies;
+};
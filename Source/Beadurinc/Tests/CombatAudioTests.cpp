@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Algo/Count.h"
+#include "Combat/Audio/CombatAudio.h"
+#include "Combat/Audio/CombatAudioSubsystem.h"
+#include "Engine/World.h"
+#include "Sound/SoundWave.h"
+#include "Tests/CombatTestWorld.h"
+
+namespace CombatAudioTests
+{
+	/** Audio tests never need an audio device, the decisions are made before any voice is asked for */
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+	
+	constexpr int32 CategoryCount = static_cast<int32>(ECombatSoundCategory::MAX);
+	
+	/** A silent sound lasting the given seconds */
+	USoundWave* MakeSound(float Duration)
+	{
+		USoundWave* Sound = NewObject<USoundWave>(GetTransientPackage());
+		Sound->Duration = Duration;
+		return Sound;
+	}
+	
+	/** Decides a batch with the same budget for every category and no voice playing */
+	TArray<ECombatSoundDecision> Decide(const TArray<FCombatSoundRequest>& Requests, const TArray<FVector>& Listeners, const FCombatSoundBudget& Budget)
+	{
+		FCombatSoundBudget Budgets[CategoryCount];
+		int32 ActiveVoices[CategoryCount] = {};
+		
+		for (FCombatSoundBudget& CategoryBudget : Budgets)
+		{
+			CategoryBudget = Budget;
+		}
+		
+		TArray<ECombatSoundDecision> Decisions;
+		Decisions.SetNumUninitialized(Requests.Num());
+		CombatAudio::DecideCombatSounds(Requests, Listeners, MakeArrayView(Budgets), MakeArrayView(ActiveVoices), Decisions);
+		
+		return Decisions;
+	}
+}
+
+using namespace CombatAudioTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAudioVoiceBudgetTest, "Beadurinc.Combat.Audio.VoiceBudget", TestFlags)
+
+bool FCombatAudioVoiceBudgetTest::RunTest(const FString& Parameters)
+{
+	const USoundWave* Hit = MakeSound(0.5F);
+	
+	FCombatSoundBudget Budget;
+	Budget.MaxVoices = 4;
+	Budget.MergeRadius = 10.0F;
+	
+	// Six hits spread away from the listener, requested farthest first
+	TArray<FCombatSoundRequest> Requests;
+	
+	for (int32 Index = 0; Index < 6; ++Index)
+	{
+		Requests.Add({ Hit, FVector(600.0 - Index * 100.0, 0.0, 0.0), ECombatSoundCategory::Hit });
+	}
+	
+	const TArray<ECombatSoundDecision> Decisions = Decide(Requests, { FVector::ZeroVector }, Budget);
+	
+	// The four nearest take the voices, the two farthest are virtualized
+	TestEqual(TEXT("Farthest hit is virtualized"), Decisions[0], ECombatSoundDecision::Virtualized);
+	TestEqual(TEXT("Second farthest hit is virtualized"), Decisions[1], ECombatSoundDecision::Virtualized);
+	
+	for (int32 Index = 2; Index < 6; ++Index)
+	{
+		TestEqual(FString::Printf(TEXT("Hit %d plays"), Index), Decisions[Index], ECombatSoundDecision::Play);
+	}
+	
+	// Another category has a budget of its own
+	Requests.Add({ Hit, FVector(700.0, 0.0, 0.0), ECombatSoundCategory::Block });
+	TestEqual(TEXT("Block plays past the hit budget"), Decide(Requests, { FVector::ZeroVector }, Budget).Last(), ECombatSoundDecision::Play);
+	
+	// Voices still playing from earlier frames count against the budget
+	FCombatSoundBudget Budgets[CategoryCount];
+	int32 ActiveVoices[CategoryCount] = {};
+	ActiveVoices[static_cast<int32>(ECombatSoundCategory::Hit)] = 3;
+	
+	for (FCombatSoundBudget& CategoryBudget : Budgets)
+	{
+		CategoryBudget = Budget;
+	}
+	
+	TArray<ECombatSoundDecision> Busy;
+	Busy.SetNumUninitialized(Requests.Num());
+	CombatAudio::DecideCombatSounds(Requests, { FVector::ZeroVector }, MakeArrayView(Budgets), MakeArrayView(ActiveVoices), Busy);
+	
+	TestEqual(TEXT("Only the nearest hit plays with three voices busy"), static_cast<int32>(Algo::CountIf(Busy, [](ECombatSoundDecision Decision) { return Decision == ECombatSoundDecision::Play; })), 2);
+	TestEqual(TEXT("Nearest hit takes the last voice"), Busy[5], ECombatSoundDecision::Play);
+	
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAudioMergeTest, "Beadurinc.Combat.Audio.MergeIdentical", TestFlags)
+
+bool FCombatAudioMergeTest::RunTest(const FString& Parameters)
+{
+	const USoundWave* Hit = MakeSound(0.5F);
+	const USoundWave* OtherHit = MakeSound(0.5F);
+	
+	FCombatSoundBudget Budget;
+	Budget.MaxVoices = 8;
+	Budget.MergeRadius = 100.0F;
+	
+	// A cleave landing three identical hits around the same spot, one different hit there and one identical hit far away
+	const TArray<FCombatSoundRequest> Requests = {
+		{ Hit, FVector(500.0, 0.0, 0.0), ECombatSoundCategory::Hit },
+		{ Hit, FVector(520.0, 30.0, 0.0), ECombatSoundCategory::Hit },
+		{ Hit, FVector(480.0, -40.0, 0.0), ECombatSoundCategory::Hit },
+		{ OtherHit, FVector(500.0, 0.0, 0.0), ECombatSoundCategory::Hit },
+		{ Hit, FVector(-500.0, 0.0, 0.0), ECombatSoundCategory::Hit },
+	};
+	
+	const TArray<ECombatSoundDecision> Decisions = Decide(Requests, { FVector::ZeroVector }, Budget);
+	
+	TestEqual(TEXT("First hit plays"), Decisions[0], ECombatSoundDecision::Play);
+	TestEqual(TEXT("Identical hit nearby is merged"), Decisions[1], ECombatSoundDecision::Merged);
+	TestEqual(TEXT("Another identical hit nearby is merged"), Decisions[2], ECombatSoundDecision::Merged);
+	TestEqual(TEXT("Different sound at the same spot plays"), Decisions[3], ECombatSoundDecision::Play);
+	TestEqual(TEXT("Identical hit far away plays"), Decisions[4], ECombatSoundDecision::Play);
+	
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAudioRangeTest, "Beadurinc.Combat.Audio.Range", TestFlags)
+
+bool FCombatAudioRangeTest::RunTest(const FString& Parameters)
+{
+	const USoundWave* Swing = MakeSound(0.5F);
+	
+	FCombatSoundBudget Budget;
+	Budget.MaxDistance = 1000.0F;
+	
+	const TArray<FCombatSoundRequest> Requests = {
+		{ Swing, FVector(900.0, 0.0, 0.0), ECombatSoundCategory::Swing },
+		{ Swing, FVector(3000.0, 0.0, 0.0), ECombatSoundCategory::Swing },
+	};
+	
+	const TArray<ECombatSoundDecision> OneListener = Decide(Requests, { FVector::ZeroVector }, Budget);
+	TestEqual(TEXT("Swing in range plays"), OneListener[0], ECombatSoundDecision::Play);
+	TestEqual(TEXT("Swing out of range is virtualized"), OneListener[1], ECombatSoundDecision::Virtualized);
+	
+	// Split screen: the far swing is next to the second listener
+	const TArray<ECombatSoundDecision> TwoListeners = Decide(Requests, { FVector::ZeroVector, FVector(3100.0, 0.0, 0.0) }, Budget);
+	TestEqual(TEXT("Swing near the second listener plays"), TwoListeners[1], ECombatSoundDecision::Play);
+	
+	// Without a listener nothing is out of range
+	const TArray<ECombatSoundDecision> NoListener = Decide(Requests, {}, Budget);
+	TestEqual(TEXT("Swing plays without a listener"), NoListener[1], ECombatSoundDecision::Play);
+	
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatAudioSubsystemTest, "Beadurinc.Combat.Audio.Subsystem", TestFlags)
+
+bool FCombatAudioSubsystemTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	UCombatAudioSubsystem* CombatAudio = TestWorld.GetWorld() ? TestWorld.GetWorld()->GetSubsystem<UCombatAudioSubsystem>() : nullptr;
+	
+	if (!TestNotNull(TEXT("Game worlds have combat audio"), CombatAudio))
+	{
+		return false;
+	}
+	
+	constexpr float Duration = 0.5F;
+	USoundWave* Hit = MakeSound(Duration);
+	const int32 MaxVoices = CombatAudio->GetBudget(ECombatSoundCategory::Hit).MaxVoices;
+	const float MergeRadius = CombatAudio->GetBudget(ECombatSoundCategory::Hit).MergeRadius;
+	
+	// Twice the budget of hits, far enough apart not to merge. Played on the null audio device, if any
+	for (int32 Index = 0; Index < MaxVoices * 2; ++Index)
+	{
+		CombatAudio->RequestSound(Hit, ECombatSoundCategory::Hit, FVector(Index * (MergeRadius + 100.0), 0.0, 0.0));
+	}
+	
+	TestWorld.Tick();
+	TestEqual(TEXT("Hits take the whole budget and no more"), CombatAudio->GetActiveVoices(ECombatSoundCategory::Hit), MaxVoices);
+	
+	// The budget stays full while the sounds play
+	CombatAudio->RequestSound(Hit, ECombatSoundCategory::Hit, FVector::ZeroVector);
+	TestWorld.Tick();
+	TestEqual(TEXT("A hit while the budget is full is virtualized"), CombatAudio->GetActiveVoices(ECombatSoundCategory::Hit), MaxVoices);
+	
+	// And frees up once they have ended
+	TestWorld.Tick(FMath::CeilToInt32(Duration / FCombatTestWorld::DefaultDeltaSeconds) + 1);
+	TestEqual(TEXT("Voices are released when their sounds end"), CombatAudio->GetActiveVoices(ECombatSoundCategory::Hit), 0);
+	
+	return true;
+}
+
+#endif
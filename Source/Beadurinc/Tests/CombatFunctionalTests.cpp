@@ -0,0 +1,565 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystem/AbilityId.h"
+#include "AbilitySystem/GameplayAbility/BlockParryGameplayAbility.h"
+#include "AbilitySystem/GameplayAbility/ComboAttackGameplayAbility.h"
+#include "AbilitySystem/GameplayAbility/HitReactGameplayAbility.h"
+#include "AbilitySystem/GameplayTag/GameplayEventTags.h"
+#include "AbilitySystem/GameplayTag/StateGameplayTags.h"
+#include "AbilitySystem/TargetData/CombatTargetData.h"
+#include "Actor/Character/AncientKingCharacter.h"
+#include "Actor/Character/PlayerCharacter.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Animation/Timeline/StateWindowComponent.h"
+#include "Combat/CombatResolutionTable.h"
+#include "Tests/CombatTestWorld.h"
+
+namespace CombatFunctionalTests
+{
+	/** Combat tests run a game world, so they run wherever one can be created */
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/** Counts the hit events a fighter receives, whether or not it reacts to them */
+	struct FHitEventCounter
+	{
+		explicit FHitEventCounter(UAbilitySystemComponent* InAbilitySystemComponent)
+			: AbilitySystemComponent(InAbilitySystemComponent)
+		{
+			Handle = AbilitySystemComponent->GenericGameplayEventCallbacks.FindOrAdd(GameplayEventTags::Event_Combat_Hit)
+				.AddLambda([this](const FGameplayEventData*) { ++Count; });
+		}
+
+		~FHitEventCounter()
+		{
+			if (AbilitySystemComponent.IsValid())
+			{
+				AbilitySystemComponent->GenericGameplayEventCallbacks.FindOrAdd(GameplayEventTags::Event_Combat_Hit).Remove(Handle);
+			}
+		}
+
+		int32 Count = 0;
+
+	private:
+
+		TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+		FDelegateHandle Handle;
+	};
+
+	/** Returns the outcome of the latest hit the fighter resolved, read from its combat timeline */
+	FName GetLatestHitOutcome(const AFighterCharacter* Fighter)
+	{
+		FName Outcome;
+
+		Fighter->GetCombatTimeline().ForEach([&Outcome](const FCombatTimelineEntry& Entry)
+		{
+			if (Entry.Type == ECombatTimelineEvent::HitReceived)
+			{
+				Outcome = Entry.Label;
+			}
+		});
+
+		return Outcome;
+	}
+
+	FName GetOutcomeName(ECombatHitOutcome Outcome)
+	{
+		return StaticEnum<ECombatHitOutcome>()->GetNameByValue(static_cast<int64>(Outcome));
+	}
+
+	bool IsAbilityActive(UAbilitySystemComponent* AbilitySystemComponent, EAbilityId AbilityId)
+	{
+		const FGameplayAbilitySpec* Spec = AbilitySystemComponent->FindAbilitySpecFromInputID(static_cast<int32>(AbilityId));
+		return Spec && Spec->IsActive();
+	}
+}
+
+using namespace CombatFunctionalTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatResolutionDefaultRulesTest, "Beadurinc.Combat.Resolution.DefaultRules", TestFlags)
+
+bool FCombatResolutionDefaultRulesTest::RunTest(const FString& Parameters)
+{
+	const uint8 Facing = static_cast<uint8>(ECombatDefenderState::FacingAttacker);
+	const uint8 Blocking = static_cast<uint8>(ECombatDefenderState::Blocking);
+	const uint8 Parrying = static_cast<uint8>(ECombatDefenderState::Parrying);
+	const uint8 Invincible = static_cast<uint8>(ECombatDefenderState::Invincible);
+
+	TestEqual(TEXT("An open defender is hurt"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Light, Facing), ECombatHitOutcome::Hurt);
+	TestEqual(TEXT("A guard facing the attacker blocks"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Light, Facing | Blocking), ECombatHitOutcome::Blocked);
+	TestEqual(TEXT("A guard inside its parry window parries"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Heavy, Facing | Blocking | Parrying), ECombatHitOutcome::Parried);
+	TestEqual(TEXT("A guard facing away is hurt"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Light, Blocking | Parrying), ECombatHitOutcome::Hurt);
+	TestEqual(TEXT("Unblockable attacks go through a guard"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Unblockable, Facing | Blocking | Parrying), ECombatHitOutcome::Hurt);
+	TestEqual(TEXT("Invincible defenders ignore every hit"), UCombatResolutionTable::ResolveDefault(ECombatAttackType::Unblockable, Invincible), ECombatHitOutcome::Ignored);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatResolutionDeterminismTest, "Beadurinc.Combat.Resolution.Deterministic", TestFlags)
+
+bool FCombatResolutionDeterminismTest::RunTest(const FString& Parameters)
+{
+	FCombatResolutionRule ChanceParry;
+	ChanceParry.AttackType = ECombatAttackType::Light;
+	ChanceParry.RequiredStates = static_cast<uint8>(ECombatDefenderState::Blocking);
+	ChanceParry.Outcome = ECombatHitOutcome::Parried;
+	ChanceParry.Chance = 0.5F;
+	ChanceParry.FallbackOutcome = ECombatHitOutcome::Blocked;
+
+	UCombatResolutionTable* Table = NewObject<UCombatResolutionTable>();
+	Table->SetRules({ ChanceParry });
+
+	const uint8 Blocking = static_cast<uint8>(ECombatDefenderState::Blocking);
+	constexpr int32 HitCount = 1000;
+	int32 ParryCount = 0;
+
+	// Two machines seeding from the same match seed and hit sequence must agree on every roll
+	for (int32 HitSequence = 0; HitSequence < HitCount; ++HitSequence)
+	{
+		FRandomStream ServerStream(static_cast<int32>(HashCombine(12345u, static_cast<uint32>(HitSequence))));
+		FRandomStream ClientStream(static_cast<int32>(HashCombine(12345u, static_cast<uint32>(HitSequence))));
+
+		const ECombatHitOutcome ServerOutcome = Table->Resolve(ECombatAttackType::Light, Blocking, ServerStream);
+		const ECombatHitOutcome ClientOutcome = Table->Resolve(ECombatAttackType::Light, Blocking, ClientStream);
+
+		if (ServerOutcome != ClientOutcome)
+		{
+			AddError(FString::Printf(TEXT("Hit %d resolved differently on two machines"), HitSequence));
+			return false;
+		}
+
+		ParryCount += ServerOutcome == ECombatHitOutcome::Parried;
+	}
+
+	// Loose bounds, only catching a roll that is never or always taken
+	TestTrue(TEXT("Chance rolls take both outcomes"), ParryCount > HitCount / 4 && ParryCount < HitCount * 3 / 4);
+
+	FRandomStream UnusedStream(0);
+	const int32 SeedBefore = UnusedStream.GetCurrentSeed();
+	Table->Resolve(ECombatAttackType::Heavy, Blocking, UnusedStream);
+	TestEqual(TEXT("Certain outcomes do not advance the stream"), UnusedStream.GetCurrentSeed(), SeedBefore);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatResolutionAcrossMachinesTest, "Beadurinc.Combat.Resolution.SameOnEveryMachine", TestFlags)
+
+bool FCombatResolutionAcrossMachinesTest::RunTest(const FString& Parameters)
+{
+	// Two worlds standing in for the server and a client, each dealing and resolving the hits on its own
+	FCombatTestWorld ServerWorld;
+	FCombatTestWorld ClientWorld;
+
+	APlayerCharacter* ServerPlayer = ServerWorld.SpawnPlayer(FVector::ZeroVector);
+	AAncientKingCharacter* ServerKing = ServerWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), FRotator(0.0, 180.0, 0.0));
+	APlayerCharacter* ClientPlayer = ClientWorld.SpawnPlayer(FVector::ZeroVector);
+	AAncientKingCharacter* ClientKing = ClientWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), FRotator(0.0, 180.0, 0.0));
+
+	if (!ServerPlayer || !ServerKing || !ClientPlayer || !ClientKing)
+	{
+		AddWarning(TEXT("Fighter blueprints are missing, skipped"));
+		return true;
+	}
+
+	// Ids replicate from the server, the stand in client allocates them in the same order instead
+	TestEqual(TEXT("Attackers share their combat id"), ClientPlayer->GetCombatId(), ServerPlayer->GetCombatId());
+	TestEqual(TEXT("Defenders share their combat id"), ClientKing->GetCombatId(), ServerKing->GetCombatId());
+
+	// The client's clock runs apart from the server's, and it sees hits the server does not
+	ClientWorld.Tick(7);
+	AAncientKingCharacter* ClientOnlyKing = ClientWorld.SpawnAncientKing(FVector(0.0, 150.0, 0.0), FRotator(0.0, -90.0, 0.0));
+
+	FCombatResolutionRule ChanceParry;
+	ChanceParry.AttackType = ECombatAttackType::Light;
+	ChanceParry.RequiredStates = static_cast<uint8>(ECombatDefenderState::Blocking);
+	ChanceParry.Outcome = ECombatHitOutcome::Parried;
+	ChanceParry.Chance = 0.5F;
+	ChanceParry.FallbackOutcome = ECombatHitOutcome::Blocked;
+
+	UCombatResolutionTable* Table = NewObject<UCombatResolutionTable>();
+	Table->SetRules({ ChanceParry });
+
+	const uint8 Blocking = static_cast<uint8>(ECombatDefenderState::Blocking);
+	constexpr int32 SwingCount = 100;
+	constexpr uint32 MatchSeed = 12345u;
+	TSet<uint32> Salts;
+
+	// A swing where the client hits a fighter the server does not know about before the shared defender
+	ServerPlayer->BeginMeleeSwing();
+	ClientPlayer->BeginMeleeSwing();
+
+	if (ClientOnlyKing)
+	{
+		FCombatTestWorld::ContactWeapon(ClientPlayer, ClientOnlyKing);
+	}
+
+	if (!TestTrue(TEXT("Players hold a weapon"), FCombatTestWorld::ContactWeapon(ServerPlayer, ServerKing) && FCombatTestWorld::ContactWeapon(ClientPlayer, ClientKing)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The same hit reacts the same on both machines"), GetLatestHitOutcome(ClientKing), GetLatestHitOutcome(ServerKing));
+
+	for (int32 Swing = 0; Swing < SwingCount; ++Swing)
+	{
+		const uint32 ServerSalt = UHitReactGameplayAbility::MakeHitSalt(ServerPlayer, ServerKing);
+		const uint32 ClientSalt = UHitReactGameplayAbility::MakeHitSalt(ClientPlayer, ClientKing);
+
+		FRandomStream ServerStream(static_cast<int32>(HashCombineFast(MatchSeed, ServerSalt)));
+		FRandomStream ClientStream(static_cast<int32>(HashCombineFast(MatchSeed, ClientSalt)));
+
+		if (ServerSalt != ClientSalt || Table->Resolve(ECombatAttackType::Light, Blocking, ServerStream) != Table->Resolve(ECombatAttackType::Light, Blocking, ClientStream))
+		{
+			AddError(FString::Printf(TEXT("Swing %d resolved differently on the server and the client"), Swing));
+			return false;
+		}
+
+		Salts.Add(ServerSalt);
+
+		ServerPlayer->BeginMeleeSwing();
+		ClientPlayer->BeginMeleeSwing();
+	}
+
+	TestEqual(TEXT("Every swing rolls a stream of its own"), Salts.Num(), SwingCount);
+
+	if (ClientOnlyKing)
+	{
+		TestNotEqual(TEXT("Every defender rolls a stream of its own"), UHitReactGameplayAbility::MakeHitSalt(ClientPlayer, ClientOnlyKing), UHitReactGameplayAbility::MakeHitSalt(ClientPlayer, ClientKing));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStateWindowRefCountTest, "Beadurinc.Combat.StateWindow.RefCount", TestFlags)
+
+bool FCombatStateWindowRefCountTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	AAncientKingCharacter* King = TestWorld.SpawnAncientKing(FVector::ZeroVector);
+
+	if (!King)
+	{
+		AddWarning(TEXT("Ancient King blueprint is missing, skipped"));
+		return true;
+	}
+
+	UStateWindowComponent* StateWindows = King->GetStateWindowComponent();
+	const UAbilitySystemComponent* ASC = King->GetAbilitySystemComponent();
+	const FGameplayTag& Tag = StateGameplayTags::State_ComboLocked;
+
+	StateWindows->OpenWindow(Tag);
+	StateWindows->OpenWindow(Tag);
+	StateWindows->CloseWindow(Tag);
+	TestTrue(TEXT("Tag stays while a window of it is open"), ASC->HasMatchingGameplayTag(Tag));
+	TestEqual(TEXT("Loose tag is added once"), ASC->GetTagCount(Tag), 1);
+
+	StateWindows->CloseWindow(Tag);
+	TestFalse(TEXT("Tag is removed with the last window"), ASC->HasMatchingGameplayTag(Tag));
+
+	StateWindows->CloseWindow(Tag);
+	StateWindows->OpenWindow(Tag);
+	TestTrue(TEXT("Closing more windows than were opened does not underflow"), ASC->HasMatchingGameplayTag(Tag));
+
+	StateWindows->CloseWindow(Tag);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatComboAdvanceTest, "Beadurinc.Combat.Combo.Advances", TestFlags)
+
+bool FCombatComboAdvanceTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+
+	if (!Player)
+	{
+		AddWarning(TEXT("Player character blueprint is missing, skipped"));
+		return true;
+	}
+
+	UAbilitySystemComponent* ASC = Player->GetAbilitySystemComponent();
+	const FGameplayAbilitySpec* Spec = TestWorld.WaitForAbility(ASC, static_cast<int32>(EAbilityId::Combo_Attack));
+
+	if (!TestNotNull(TEXT("Combo attack ability is granted"), Spec)
+		|| !TestTrue(TEXT("Player holds a weapon"), Player->IsHoldingWeapon())
+		|| !TestTrue(TEXT("Weapon has a combo"), Player->GetWeapon()->GetComboSequenceLength() > 0))
+	{
+		return false;
+	}
+
+	const FGameplayAbilitySpecHandle Handle = Spec->Handle;
+	const int32 ComboLength = Player->GetWeapon()->GetComboSequenceLength();
+
+	const auto GetComboCounter = [ASC, Handle]
+	{
+		const FGameplayAbilitySpec* ComboSpec = ASC->FindAbilitySpecFromHandle(Handle);
+		const UComboAttackGameplayAbility* Combo = ComboSpec ? Cast<UComboAttackGameplayAbility>(ComboSpec->GetPrimaryInstance()) : nullptr;
+		return Combo ? Combo->GetComboCounter() : INDEX_NONE;
+	};
+
+	Player->PressAbility(static_cast<int32>(EAbilityId::Combo_Attack));
+	TestTrue(TEXT("First press starts the combo"), IsAbilityActive(ASC, EAbilityId::Combo_Attack));
+	TestEqual(TEXT("First press plays the first attack"), GetComboCounter(), 1 % ComboLength);
+	TestTrue(TEXT("Combo is locked right after an attack starts"), ASC->HasMatchingGameplayTag(StateGameplayTags::State_ComboLocked));
+
+	// Pressed during the lock, so the press is buffered and fires by itself once the lock lifts
+	TestWorld.Tick(2);
+	Player->PressAbility(static_cast<int32>(EAbilityId::Combo_Attack));
+
+	const bool bAdvanced = TestWorld.TickUntil([&GetComboCounter, ComboLength]
+	{
+		return GetComboCounter() == 2 % ComboLength;
+	}, 3.0F);
+
+	TestTrue(TEXT("Buffered press advances the combo"), bAdvanced);
+	TestTrue(TEXT("Combo is still running after advancing"), IsAbilityActive(ASC, EAbilityId::Combo_Attack));
+	TestFalse(TEXT("Buffer is consumed by the advance"), Player->HasBufferedInput());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBufferedInputWindowTest, "Beadurinc.Combat.BufferedInput.FiresWithinWindow", TestFlags)
+
+bool FCombatBufferedInputWindowTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+
+	if (!Player)
+	{
+		AddWarning(TEXT("Player character blueprint is missing, skipped"));
+		return true;
+	}
+
+	UAbilitySystemComponent* ASC = Player->GetAbilitySystemComponent();
+
+	if (!TestNotNull(TEXT("Roll ability is granted"), TestWorld.WaitForAbility(ASC, static_cast<int32>(EAbilityId::Roll))))
+	{
+		return false;
+	}
+
+	UStateWindowComponent* StateWindows = Player->GetStateWindowComponent();
+
+	// Two locks refusing the roll: the input survives the first lifting and fires with the second
+	StateWindows->OpenWindow(StateGameplayTags::State_BlockingLocked);
+	StateWindows->OpenWindow(StateGameplayTags::State_BlockingLocked);
+
+	Player->PressAbility(static_cast<int32>(EAbilityId::Roll));
+	TestFalse(TEXT("Roll is refused while locked"), IsAbilityActive(ASC, EAbilityId::Roll));
+	TestTrue(TEXT("Refused press is buffered"), Player->HasBufferedInput());
+
+	TestWorld.Tick(FMath::FloorToInt32(BUFFER_WINDOW_SECONDS * 0.5 / FCombatTestWorld::DefaultDeltaSeconds));
+
+	StateWindows->CloseWindow(StateGameplayTags::State_BlockingLocked);
+	TestFalse(TEXT("Roll waits for every lock of its tag"), IsAbilityActive(ASC, EAbilityId::Roll));
+
+	StateWindows->CloseWindow(StateGameplayTags::State_BlockingLocked);
+	TestTrue(TEXT("Buffered roll fires in the frame the lock lifts"), IsAbilityActive(ASC, EAbilityId::Roll));
+	TestFalse(TEXT("Buffer is consumed"), Player->HasBufferedInput());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatBufferedInputExpiryTest, "Beadurinc.Combat.BufferedInput.ExpiresAfterWindow", TestFlags)
+
+bool FCombatBufferedInputExpiryTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+
+	if (!Player)
+	{
+		AddWarning(TEXT("Player character blueprint is missing, skipped"));
+		return true;
+	}
+
+	UAbilitySystemComponent* ASC = Player->GetAbilitySystemComponent();
+
+	if (!TestNotNull(TEXT("Roll ability is granted"), TestWorld.WaitForAbility(ASC, static_cast<int32>(EAbilityId::Roll))))
+	{
+		return false;
+	}
+
+	UStateWindowComponent* StateWindows = Player->GetStateWindowComponent();
+	StateWindows->OpenWindow(StateGameplayTags::State_BlockingLocked);
+
+	Player->PressAbility(static_cast<int32>(EAbilityId::Roll));
+	TestWorld.Tick(FMath::CeilToInt32(BUFFER_WINDOW_SECONDS * 1.5 / FCombatTestWorld::DefaultDeltaSeconds));
+
+	StateWindows->CloseWindow(StateGameplayTags::State_BlockingLocked);
+	TestFalse(TEXT("An input older than the buffer window does not fire"), IsAbilityActive(ASC, EAbilityId::Roll));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatParryWindowTest, "Beadurinc.Combat.BlockParry.ParryWindow", TestFlags)
+
+bool FCombatParryWindowTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+	AAncientKingCharacter* King = TestWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), FRotator(0.0, 180.0, 0.0));
+
+	if (!Player || !King)
+	{
+		AddWarning(TEXT("Fighter blueprints are missing, skipped"));
+		return true;
+	}
+
+	UAbilitySystemComponent* ASC = Player->GetAbilitySystemComponent();
+	const FGameplayAbilitySpec* BlockSpec = TestWorld.WaitForAbility(ASC, static_cast<int32>(EAbilityId::Block));
+
+	if (!TestNotNull(TEXT("Block ability is granted"), BlockSpec)
+		|| !TestNotNull(TEXT("Hit react ability is granted"), TestWorld.WaitForAbility(ASC, static_cast<int32>(EAbilityId::Hit_React))))
+	{
+		return false;
+	}
+
+	const float ParryWindowSeconds = CastChecked<UBlockParryGameplayAbility>(BlockSpec->Ability)->GetParryWindowSeconds();
+	const UWorld* World = TestWorld.GetWorld();
+
+	// The window is an interval in server time: every frame rate must parry up to its end and block past it
+	for (const float DeltaSeconds : { 1.0F / 30.0F, 1.0F / 60.0F, 1.0F / 144.0F })
+	{
+		const double RaisedAt = FCombatTargetData_Timestamp::GetServerTime(World);
+		Player->PressAbility(static_cast<int32>(EAbilityId::Block));
+
+		if (!TestTrue(TEXT("Guard is raised"), Player->IsGuardingAt(RaisedAt)))
+		{
+			return false;
+		}
+
+		// Last frame that still starts inside the window
+		TestWorld.TickUntil([World, RaisedAt, ParryWindowSeconds, DeltaSeconds]
+		{
+			return FCombatTargetData_Timestamp::GetServerTime(World) + DeltaSeconds >= RaisedAt + ParryWindowSeconds;
+		}, ParryWindowSeconds * 2.0F, DeltaSeconds);
+
+		King->ResetMeleeSwing();
+		TestTrue(TEXT("King holds a weapon"), FCombatTestWorld::ContactWeapon(King, Player));
+		TestEqual(FString::Printf(TEXT("Hit in the last parry frame at %.0f fps is parried"), 1.0F / DeltaSeconds), GetLatestHitOutcome(Player), GetOutcomeName(ECombatHitOutcome::Parried));
+
+		TestWorld.Tick(1, DeltaSeconds);
+
+		King->ResetMeleeSwing();
+		FCombatTestWorld::ContactWeapon(King, Player);
+		TestEqual(FString::Printf(TEXT("Hit in the first frame past the window at %.0f fps is blocked"), 1.0F / DeltaSeconds), GetLatestHitOutcome(Player), GetOutcomeName(ECombatHitOutcome::Blocked));
+
+		Player->ReleaseAbility(static_cast<int32>(EAbilityId::Block));
+
+		const double LoweredAt = FCombatTargetData_Timestamp::GetServerTime(World);
+		TestFalse(TEXT("Guard is lowered on release"), Player->IsGuardingAt(LoweredAt + DeltaSeconds));
+
+		TestWorld.TickUntil([ASC]
+		{
+			return !IsAbilityActive(ASC, EAbilityId::Block) && !ASC->HasMatchingGameplayTag(StateGameplayTags::State_BlockingLocked);
+		}, 2.0F, DeltaSeconds);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatSingleHitPerSwingTest, "Beadurinc.Combat.HitReact.SingleHitPerSwing", TestFlags)
+
+bool FCombatSingleHitPerSwingTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+	AAncientKingCharacter* King = TestWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), FRotator(0.0, 180.0, 0.0));
+
+	if (!Player || !King)
+	{
+		AddWarning(TEXT("Fighter blueprints are missing, skipped"));
+		return true;
+	}
+
+	if (!TestNotNull(TEXT("King reacts to hits"), TestWorld.WaitForAbility(King->GetAbilitySystemComponent(), static_cast<int32>(EAbilityId::Hit_React))))
+	{
+		return false;
+	}
+
+	FHitEventCounter KingHits(King->GetAbilitySystemComponent());
+
+	// A weapon keeps overlapping its target for several frames of a swing
+	Player->ResetMeleeSwing();
+
+	for (int32 Contact = 0; Contact < 5; ++Contact)
+	{
+		if (!TestTrue(TEXT("Player holds a weapon"), FCombatTestWorld::ContactWeapon(Player, King)))
+		{
+			return false;
+		}
+	}
+
+	TestEqual(TEXT("One swing hits a target once"), KingHits.Count, 1);
+
+	Player->ResetMeleeSwing();
+	FCombatTestWorld::ContactWeapon(Player, King);
+	TestEqual(TEXT("The next swing hits again"), KingHits.Count, 2);
+
+	// Fighters of the same team never hit each other
+	APlayerCharacter* Ally = TestWorld.SpawnPlayer(FVector(-150.0, 0.0, 0.0));
+	FHitEventCounter AllyHits(Ally->GetAbilitySystemComponent());
+
+	Player->ResetMeleeSwing();
+	FCombatTestWorld::ContactWeapon(Player, Ally);
+	TestEqual(TEXT("Allies are not hit"), AllyHits.Count, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatIgnoredHitTest, "Beadurinc.Combat.HitReact.IgnoredHitHasNoEffect", TestFlags)
+
+bool FCombatIgnoredHitTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+
+	// Facing away, so a defender turning toward its attacker shows
+	const FRotator KingRotation(0.0, 0.0, 0.0);
+	AAncientKingCharacter* King = TestWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), KingRotation);
+
+	if (!Player || !King)
+	{
+		AddWarning(TEXT("Fighter blueprints are missing, skipped"));
+		return true;
+	}
+
+	UAbilitySystemComponent* KingASC = King->GetAbilitySystemComponent();
+
+	if (!TestNotNull(TEXT("King reacts to hits"), TestWorld.WaitForAbility(KingASC, static_cast<int32>(EAbilityId::Hit_React))))
+	{
+		return false;
+	}
+
+	FHitEventCounter KingHits(KingASC);
+	KingASC->AddLooseGameplayTag(StateGameplayTags::State_Invincible);
+
+	Player->BeginMeleeSwing();
+
+	if (!TestTrue(TEXT("Player holds a weapon"), FCombatTestWorld::ContactWeapon(Player, King)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("A hit on an invincible defender is ignored"), GetLatestHitOutcome(King), GetOutcomeName(ECombatHitOutcome::Ignored));
+	TestEqual(TEXT("An ignored hit does not stop the attacker"), Player->CustomTimeDilation, 1.0F);
+	TestTrue(TEXT("An ignored hit does not turn the defender"), King->GetActorRotation().Equals(KingRotation));
+
+	// The defender is not counted as hit by the swing, so a contact once invincibility wears off still lands
+	KingASC->RemoveLooseGameplayTag(StateGameplayTags::State_Invincible);
+	FCombatTestWorld::ContactWeapon(Player, King);
+
+	TestEqual(TEXT("The swing hits again once the defender is vulnerable"), KingHits.Count, 2);
+	TestNotEqual(TEXT("The later hit lands"), GetLatestHitOutcome(King), GetOutcomeName(ECombatHitOutcome::Ignored));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,336 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystem/AbilityId.h"
+#include "Actor/Character/AncientKingCharacter.h"
+#include "Actor/Character/PlayerCharacter.h"
+#include "Combat/CombatResolutionTable.h"
+#include "Combat/Debug/CombatMemory.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Tests/CombatTestWorld.h"
+
+namespace CombatPerformanceTests
+{
+	/** Run with the other combat tests, so allocation budgets are held on every run. Time ceilings are opt-in */
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/** Ceiling of the average time of one melee hit, from weapon contact to the defender's reaction */
+	constexpr double MaxMillisecondsPerHit = 1.0;
+
+	/** Ceiling of the average game thread allocations of one melee hit. Generous, to catch a hot path that starts allocating per hit */
+	constexpr double MaxAllocationsPerHit = 256.0;
+
+	/** Ceiling of the average bytes one melee hit leaves charged to the combat events LLM tag */
+	constexpr double MaxRetainedBytesPerHit = 64.0;
+
+	/** Ceiling of the average time of resolving one hit against the resolution table */
+	constexpr double MaxMicrosecondsPerResolution = 1.0;
+
+	/** Hits measured, after warm-up hits that fill caches, pools and first-use allocations */
+	constexpr int32 WarmUpHits = 20;
+	constexpr int32 MeasuredHits = 200;
+
+	/**
+	 * Counts the heap allocations made on the game thread while armed, standing in front of the
+	 * allocator GMalloc held when it was installed and forwarding every call to it.
+	 *
+	 * Installed once and never removed nor destroyed, so a thread that read GMalloc before or
+	 * during the install keeps calling into a live allocator, and memory allocated through either
+	 * is freed through the same inner allocator.
+	 */
+	class FAllocationCounter final : public FMalloc
+	{
+	public:
+
+		/** Returns the counter, installing it in front of GMalloc on first use */
+		static FAllocationCounter& Get()
+		{
+			static FAllocationCounter* Counter = new FAllocationCounter(GMalloc);
+			return *Counter;
+		}
+
+		/** Starts counting game thread allocations from zero. Game thread only */
+		void Arm()
+		{
+			check(IsInGameThread());
+			Count = 0;
+			bArmed = true;
+		}
+
+		/** Stops counting and returns the allocations counted since Arm. Game thread only */
+		uint64 Disarm()
+		{
+			check(IsInGameThread());
+			bArmed = false;
+			return Count;
+		}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Size, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Size, Alignment);
+		}
+
+		virtual void* MallocZeroed(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->MallocZeroed(Size, Alignment);
+		}
+
+		virtual void* TryMallocZeroed(SIZE_T Size, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMallocZeroed(Size, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size > 0)
+			{
+				CountAllocation();
+			}
+
+			return Inner->Realloc(Original, Size, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+		{
+			if (Size > 0)
+			{
+				CountAllocation();
+			}
+
+			return Inner->TryRealloc(Original, Size, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+
+		virtual void MarkTLSCachesAsUsedOnCurrentThread() override { Inner->MarkTLSCachesAsUsedOnCurrentThread(); }
+
+		virtual void MarkTLSCachesAsUnusedOnCurrentThread() override { Inner->MarkTLSCachesAsUnusedOnCurrentThread(); }
+
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+
+		explicit FAllocationCounter(FMalloc* InInner)
+			: Inner(InInner)
+		{
+			GMalloc = this;
+		}
+
+		FORCEINLINE void CountAllocation()
+		{
+			// Other threads keep allocating for their own work, only the game thread runs the hit
+			if (bArmed && IsInGameThread())
+			{
+				++Count;
+			}
+		}
+
+		FMalloc* Inner;
+
+		/** Only read and written on the game thread once armed */
+		uint64 Count = 0;
+		bool bArmed = false;
+	};
+
+	/** Times are always reported, and only held to their ceilings on the reference machine, which passes -CombatTimeBudgets */
+	static bool ShouldEnforceTimeBudgets()
+	{
+		return FParse::Param(FCommandLine::Get(), TEXT("CombatTimeBudgets"));
+	}
+
+	/**
+	 * Returns the bytes charged to the combat events LLM tag across every thread, or INDEX_NONE
+	 * when the tracker is not running (-llm). Merges what threads tracked since the last frame.
+	 */
+	static int64 GetCombatEventsBytes()
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+
+		if (Tracker.IsEnabled())
+		{
+			Tracker.UpdateStatsPerFrame();
+			return Tracker.GetTagAmountForTracker(ELLMTracker::Default, LLM_TAG_NAME(Beadurinc_CombatEvents), ELLMTagSet::None);
+		}
+#endif
+
+		return INDEX_NONE;
+	}
+}
+
+using namespace CombatPerformanceTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatHitBudgetTest, "Beadurinc.Combat.Performance.HitBudget", TestFlags)
+
+bool FCombatHitBudgetTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+	AAncientKingCharacter* King = TestWorld.SpawnAncientKing(FVector(150.0, 0.0, 0.0), FRotator(0.0, 180.0, 0.0));
+
+	if (!Player || !King)
+	{
+		AddWarning(TEXT("Fighter blueprints are missing, skipped"));
+		return true;
+	}
+
+	if (!TestNotNull(TEXT("King reacts to hits"), TestWorld.WaitForAbility(King->GetAbilitySystemComponent(), static_cast<int32>(EAbilityId::Hit_React))))
+	{
+		return false;
+	}
+
+	FAllocationCounter& AllocationCounter = FAllocationCounter::Get();
+	uint64 Cycles = 0;
+	uint64 Allocations = 0;
+	int64 StartBytes = INDEX_NONE;
+
+	for (int32 Hit = 0; Hit < WarmUpHits + MeasuredHits; ++Hit)
+	{
+		// One swing per hit. The frame in between lets hit stop, cues and montages settle as they would in play
+		TestWorld.Tick();
+		Player->ResetMeleeSwing();
+
+		if (Hit == WarmUpHits)
+		{
+			StartBytes = GetCombatEventsBytes();
+		}
+
+		AllocationCounter.Arm();
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		const bool bContacted = FCombatTestWorld::ContactWeapon(Player, King);
+		const uint64 EndCycles = FPlatformTime::Cycles64();
+		const uint64 HitAllocations = AllocationCounter.Disarm();
+
+		if (!bContacted)
+		{
+			AddError(TEXT("Player holds no weapon"));
+			return false;
+		}
+
+		if (Hit >= WarmUpHits)
+		{
+			Cycles += EndCycles - StartCycles;
+			Allocations += HitAllocations;
+		}
+	}
+
+	// Whatever the hits left behind once their frame is over
+	TestWorld.Tick();
+
+	const double MillisecondsPerHit = FPlatformTime::ToMilliseconds64(Cycles) / MeasuredHits;
+	const double AllocationsPerHit = static_cast<double>(Allocations) / MeasuredHits;
+
+	AddInfo(FString::Printf(TEXT("Melee hit: %.4f ms, %.1f allocations on average over %d hits"), MillisecondsPerHit, AllocationsPerHit, MeasuredHits));
+	TestTrue(FString::Printf(TEXT("Melee hit allocates at most %.0f times"), MaxAllocationsPerHit), AllocationsPerHit <= MaxAllocationsPerHit);
+
+	if (ShouldEnforceTimeBudgets())
+	{
+		TestTrue(FString::Printf(TEXT("Melee hit takes at most %.2f ms"), MaxMillisecondsPerHit), MillisecondsPerHit <= MaxMillisecondsPerHit);
+	}
+
+	const int64 EndBytes = GetCombatEventsBytes();
+
+	if (StartBytes == INDEX_NONE || EndBytes == INDEX_NONE)
+	{
+		AddInfo(TEXT("Low level memory tracker is off, run with -llm to measure retained memory"));
+		return true;
+	}
+
+	const double RetainedBytesPerHit = static_cast<double>(EndBytes - StartBytes) / MeasuredHits;
+
+	AddInfo(FString::Printf(TEXT("Melee hit: %.1f bytes retained on average"), RetainedBytesPerHit));
+	TestTrue(FString::Printf(TEXT("Melee hit retains at most %.0f bytes"), MaxRetainedBytesPerHit), RetainedBytesPerHit <= MaxRetainedBytesPerHit);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatResolutionBudgetTest, "Beadurinc.Combat.Performance.ResolutionBudget", TestFlags)
+
+bool FCombatResolutionBudgetTest::RunTest(const FString& Parameters)
+{
+	FCombatResolutionRule ChanceParry;
+	ChanceParry.AttackType = ECombatAttackType::Light;
+	ChanceParry.RequiredStates = static_cast<uint8>(ECombatDefenderState::Parrying);
+	ChanceParry.Outcome = ECombatHitOutcome::Parried;
+	ChanceParry.Chance = 0.5F;
+	ChanceParry.FallbackOutcome = ECombatHitOutcome::Blocked;
+
+	UCombatResolutionTable* Table = NewObject<UCombatResolutionTable>();
+	Table->SetRules({ ChanceParry });
+
+	constexpr int32 Resolutions = 100000;
+	FRandomStream Stream(0);
+	int32 Parries = 0;
+
+	FAllocationCounter& AllocationCounter = FAllocationCounter::Get();
+	const int64 StartBytes = GetCombatEventsBytes();
+
+	AllocationCounter.Arm();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	{
+		// Resolution runs inside hit reactions, charge it the same way
+		LLM_SCOPE_BYTAG(Beadurinc_CombatEvents);
+
+		for (int32 Index = 0; Index < Resolutions; ++Index)
+		{
+			const uint8 States = static_cast<uint8>(Index % CombatDefenderStateCount);
+			Parries += Table->Resolve(static_cast<ECombatAttackType>(Index % static_cast<int32>(ECombatAttackType::MAX)), States, Stream) == ECombatHitOutcome::Parried;
+		}
+	}
+
+	const double MicrosecondsPerResolution = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / Resolutions;
+	const uint64 Allocations = AllocationCounter.Disarm();
+	const int64 EndBytes = GetCombatEventsBytes();
+
+	AddInfo(FString::Printf(TEXT("Hit resolution: %.4f us on average, %d parries"), MicrosecondsPerResolution, Parries));
+	TestTrue(FString::Printf(TEXT("Hit resolution never allocates, allocated %llu times"), Allocations), Allocations == 0);
+
+	if (ShouldEnforceTimeBudgets())
+	{
+		TestTrue(FString::Printf(TEXT("Hit resolution takes at most %.2f us"), MaxMicrosecondsPerResolution), MicrosecondsPerResolution <= MaxMicrosecondsPerResolution);
+	}
+
+	if (StartBytes != INDEX_NONE && EndBytes != INDEX_NONE)
+	{
+		TestTrue(FString::Printf(TEXT("Hit resolution retains no memory, retained %lld bytes"), EndBytes - StartBytes), EndBytes == StartBytes);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Tests/CombatTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AbilitySystemComponent.h"
+#include "Actor/Character/AncientKingCharacter.h"
+#include "Actor/Character/PlayerCharacter.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Tickable.h"
+#include "UObject/UObjectGlobals.h"
+
+FCombatTestWorld::FCombatTestWorld()
+{
+	// A game instance of its own, so game instance subsystems exist exactly as in a real session
+	GameInstance.Reset(NewObject<UGameInstance>(GEngine));
+	GameInstance->InitializeStandalone(TEXT("CombatTestWorld"));
+
+	World = GameInstance->GetWorld();
+
+	if (!World)
+	{
+		return;
+	}
+
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+}
+
+FCombatTestWorld::~FCombatTestWorld()
+{
+	if (World)
+	{
+		World->BeginTearingDown();
+
+		// Fighters unregister from world subsystems on EndPlay, route it before the subsystems go away
+		for (FActorIterator It(World); It; ++It)
+		{
+			It->RouteEndPlay(EEndPlayReason::Quit);
+		}
+
+		GameInstance->Shutdown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	GameInstance.Reset();
+}
+
+void FCombatTestWorld::Tick(int32 Frames, float DeltaSeconds)
+{
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		// Ability sets are granted from streamable callbacks, deliver them before the frame runs
+		FlushAsyncLoading();
+		FTickableGameObject::TickObjects(nullptr, LEVELTICK_All, false, DeltaSeconds);
+
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+}
+
+bool FCombatTestWorld::TickUntil(TFunctionRef<bool()> Predicate, float MaxSeconds, float DeltaSeconds)
+{
+	for (float Elapsed = 0.0F; Elapsed <= MaxSeconds; Elapsed += DeltaSeconds)
+	{
+		if (Predicate())
+		{
+			return true;
+		}
+
+		Tick(1, DeltaSeconds);
+	}
+
+	return Predicate();
+}
+
+APlayerCharacter* FCombatTestWorld::SpawnPlayer(const FVector& Location, const FRotator& Rotation)
+{
+	UClass* PlayerClass = LoadClass<APlayerCharacter>(nullptr, PlayerCharacterPath);
+
+	if (!World || !PlayerClass)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	APlayerCharacter* Player = World->SpawnActor<APlayerCharacter>(PlayerClass, Location, Rotation, SpawnParameters);
+
+	// Standalone controllers are local, and pick up the game mode's player state carrying the ASC
+	APlayerController* Controller = World->SpawnActor<APlayerController>(SpawnParameters);
+	Controller->Possess(Player);
+
+	// There is no floor in the test world
+	Player->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+
+	return Player;
+}
+
+AAncientKingCharacter* FCombatTestWorld::SpawnAncientKing(const FVector& Location, const FRotator& Rotation)
+{
+	UClass* KingClass = LoadClass<AAncientKingCharacter>(nullptr, AncientKingPath);
+
+	if (!World || !KingClass)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AAncientKingCharacter* King = World->SpawnActor<AAncientKingCharacter>(KingClass, Location, Rotation, SpawnParameters);
+	King->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+
+	return King;
+}
+
+FGameplayAbilitySpec* FCombatTestWorld::WaitForAbility(UAbilitySystemComponent* AbilitySystemComponent, int32 InputId)
+{
+	if (!AbilitySystemComponent)
+	{
+		return nullptr;
+	}
+
+	TickUntil([AbilitySystemComponent, InputId]
+	{
+		return AbilitySystemComponent->FindAbilitySpecFromInputID(InputId) != nullptr;
+	}, 5.0F);
+
+	return AbilitySystemComponent->FindAbilitySpecFromInputID(InputId);
+}
+
+bool FCombatTestWorld::ContactWeapon(AFighterCharacter* Attacker, AFighterCharacter* Defender)
+{
+	if (!Attacker->IsHoldingWeapon())
+	{
+		return false;
+	}
+
+	Attacker->GetWeapon()->ReportContact(Defender, Defender->GetCapsuleComponent());
+	return true;
+}
+
+#endif
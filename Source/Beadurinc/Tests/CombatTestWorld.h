@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "UObject/StrongObjectPtr.h"
+
+class AAncientKingCharacter;
+class AFighterCharacter;
+class APlayerCharacter;
+class UAbilitySystemComponent;
+class UGameInstance;
+class UWorld;
+struct FGameplayAbilitySpec;
+
+/**
+ * A standalone game world for combat automation tests.
+ *
+ * Runs the project's default game mode without a viewport, a map or a local player. Nothing
+ * ticks on its own: tests advance the world explicitly with fixed frame times, so every run
+ * of a test sees the same sequence of frames whatever machine it runs on.
+ */
+class FCombatTestWorld
+{
+public:
+
+	/** Blueprint fighters the tests spawn. Tests needing them are skipped when they cannot be loaded */
+	static constexpr const TCHAR* PlayerCharacterPath = TEXT("/Game/Blueprints/Actor/Character/BP_PlayerCharacter.BP_PlayerCharacter_C");
+	static constexpr const TCHAR* AncientKingPath = TEXT("/Game/Blueprints/Actor/Character/BP_AncientKingCharacter.BP_AncientKingCharacter_C");
+
+	/** Frame time used by tests that do not care about the frame rate */
+	static constexpr float DefaultDeltaSeconds = 1.0F / 60.0F;
+
+	FCombatTestWorld();
+	~FCombatTestWorld();
+
+	FCombatTestWorld(const FCombatTestWorld&) = delete;
+	FCombatTestWorld& operator=(const FCombatTestWorld&) = delete;
+
+	/** Returns the world, null if it could not be created */
+	FORCEINLINE UWorld* GetWorld() const { return World; }
+
+	/** Advances the world by the given number of frames */
+	void Tick(int32 Frames = 1, float DeltaSeconds = DefaultDeltaSeconds);
+
+	/** Advances the world until the predicate holds or MaxSeconds of world time pass. Returns whether it held */
+	bool TickUntil(TFunctionRef<bool()> Predicate, float MaxSeconds, float DeltaSeconds = DefaultDeltaSeconds);
+
+	/** Spawns the player character blueprint possessed by a new local player controller. Null if the blueprint is missing */
+	APlayerCharacter* SpawnPlayer(const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	/** Spawns the Ancient King blueprint. Null if the blueprint is missing */
+	AAncientKingCharacter* SpawnAncientKing(const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	/** Ticks until the ability bound to the input id has been granted, since ability sets load asynchronously. Null on timeout */
+	FGameplayAbilitySpec* WaitForAbility(UAbilitySystemComponent* AbilitySystemComponent, int32 InputId);
+
+	/** Reports the attacker's weapon overlapping the defender, as its melee trace would. Returns false if it holds no weapon */
+	static bool ContactWeapon(AFighterCharacter* Attacker, AFighterCharacter* Defender);
+
+private:
+
+	TStrongObjectPtr<UGameInstance> GameInstance;
+
+	UWorld* World = nullptr;
+};
+
+#endif
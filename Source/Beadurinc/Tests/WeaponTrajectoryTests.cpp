@@ -0,0 +1,176 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Actor/Character/PlayerCharacter.h"
+#include "Actor/Weapon/WeaponComponent.h"
+#include "Actor/Weapon/WeaponTrajectory.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "Tests/CombatTestWorld.h"
+
+namespace WeaponTrajectoryTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/** Farthest a trace shape end rebuilt from a trajectory may be from where full evaluation puts it */
+	constexpr double MaxShapeErrorCentimeters = 2.0;
+
+	/** Farthest a socket position may drift through quantization alone */
+	constexpr double MaxQuantizationErrorCentimeters = 0.05;
+
+	/** Largest angle a socket rotation may drift through quantization alone */
+	constexpr double MaxQuantizationErrorDegrees = 0.05;
+}
+
+using namespace WeaponTrajectoryTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponTrajectoryQuantizationTest, "Beadurinc.Combat.WeaponTrajectory.Quantization", TestFlags)
+
+bool FWeaponTrajectoryQuantizationTest::RunTest(const FString& Parameters)
+{
+	constexpr float SampleRate = 30.0F;
+
+	// A sword tip swinging a half circle in front of the hips, rolling as it goes
+	TArray<FTransform> Samples;
+
+	for (int32 Index = 0; Index <= 30; ++Index)
+	{
+		const double Angle = PI * Index / 30.0;
+		const FQuat Rotation = FQuat(FVector::UpVector, Angle) * FQuat(FVector::ForwardVector, Angle * 0.5);
+		Samples.Add(FTransform(Rotation, FVector(FMath::Cos(Angle) * 80.0, FMath::Sin(Angle) * 80.0, 100.0 + Index)));
+	}
+
+	const FWeaponTrajectory Trajectory = FWeaponTrajectory::Compress(nullptr, SampleRate, Samples);
+
+	TestEqual(TEXT("Every sample is kept"), Trajectory.GetNumSamples(), Samples.Num());
+
+	double MaxPositionError = 0.0;
+	double MaxRotationError = 0.0;
+
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		const FTransform Decoded = Trajectory.Evaluate(Index / SampleRate);
+
+		MaxPositionError = FMath::Max(MaxPositionError, FVector::Dist(Decoded.GetLocation(), Samples[Index].GetLocation()));
+		MaxRotationError = FMath::Max(MaxRotationError, FMath::RadiansToDegrees(Decoded.GetRotation().AngularDistance(Samples[Index].GetRotation())));
+	}
+
+	TestTrue(FString::Printf(TEXT("Positions survive quantization (%.4f cm off)"), MaxPositionError), MaxPositionError <= MaxQuantizationErrorCentimeters);
+	TestTrue(FString::Printf(TEXT("Rotations survive quantization (%.4f degrees off)"), MaxRotationError), MaxRotationError <= MaxQuantizationErrorDegrees);
+
+	// Between samples the path is interpolated, past the ends it holds
+	const FVector Halfway = Trajectory.Evaluate(0.5F / SampleRate).GetLocation();
+	const FVector Expected = FMath::Lerp(Samples[0].GetLocation(), Samples[1].GetLocation(), 0.5);
+
+	TestTrue(TEXT("Positions between samples are interpolated"), FVector::Dist(Halfway, Expected) <= MaxQuantizationErrorCentimeters);
+	TestTrue(TEXT("Positions past the end hold the last sample"), Trajectory.Evaluate(10.0F).GetLocation().Equals(Trajectory.Evaluate(1.0F).GetLocation()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponTrajectoryAccuracyTest, "Beadurinc.Combat.WeaponTrajectory.MatchesEvaluatedPose", TestFlags)
+
+bool FWeaponTrajectoryAccuracyTest::RunTest(const FString& Parameters)
+{
+	FCombatTestWorld TestWorld;
+	APlayerCharacter* Player = TestWorld.SpawnPlayer(FVector::ZeroVector);
+
+	if (!Player)
+	{
+		AddWarning(TEXT("Player character blueprint is missing, skipped"));
+		return true;
+	}
+
+	const UWeaponComponent* Weapon = Player->GetWeapon();
+	const UWeaponDataAsset* WeaponData = Weapon->GetWeaponData();
+
+	if (!TestNotNull(TEXT("Player holds a weapon"), WeaponData)
+		|| !TestTrue(TEXT("Weapon has a combo"), WeaponData->GetComboSequenceLength() > 0))
+	{
+		return false;
+	}
+
+	USkeletalMeshComponent* PlayerMesh = Player->GetMesh();
+	UAnimInstance* AnimInstance = PlayerMesh->GetAnimInstance();
+
+	// Full evaluation every frame, whether or not anything renders the test world
+	PlayerMesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	for (uint32 ComboIndex = 0; ComboIndex < WeaponData->GetComboSequenceLength(); ++ComboIndex)
+	{
+		UAnimMontage* Montage = WeaponData->GetComboAttackAt(ComboIndex);
+
+		if (!Montage)
+		{
+			continue;
+		}
+
+		// The asset's bake when there is one, so a stale bake fails here. Otherwise bake on a mesh of the test world
+		FWeaponTrajectory Trajectory;
+
+		if (const FWeaponTrajectory* Baked = WeaponData->FindComboTrajectory(Montage))
+		{
+			Trajectory = *Baked;
+		}
+		else
+		{
+			USkeletalMeshComponent* BakeMesh = NewObject<USkeletalMeshComponent>(TestWorld.GetWorld());
+			BakeMesh->SetSkeletalMeshAsset(PlayerMesh->GetSkeletalMeshAsset());
+			BakeMesh->RegisterComponentWithWorld(TestWorld.GetWorld());
+
+			Trajectory = FWeaponTrajectory::Bake(BakeMesh, Montage, WeaponData->GetAttachSocket(), 60.0F);
+
+			BakeMesh->DestroyComponent();
+		}
+
+		if (!TestTrue(FString::Printf(TEXT("Combo attack %u has a trajectory"), ComboIndex), Trajectory.IsValid()))
+		{
+			continue;
+		}
+
+		AnimInstance->Montage_Play(Montage);
+
+		double MaxError = 0.0;
+		int32 ComparedFrames = 0;
+
+		// Bounded in case the montage loops a section
+		const int32 MaxFrames = FMath::CeilToInt32(Montage->GetPlayLength() / FCombatTestWorld::DefaultDeltaSeconds) + 60;
+
+		for (int32 Frame = 0; Frame < MaxFrames && AnimInstance->Montage_IsPlaying(Montage); ++Frame)
+		{
+			TestWorld.Tick();
+
+			// Sweeps only matter while tracing, and only the montage's own pose is baked, not what it blends with
+			const FAnimMontageInstance* MontageInstance = AnimInstance->GetActiveInstanceForMontage(Montage);
+
+			if (!Weapon->IsTracing() || !MontageInstance || MontageInstance->GetWeight() < 1.0F - UE_KINDA_SMALL_NUMBER)
+			{
+				continue;
+			}
+
+			const FTransform Evaluated = Weapon->GetComponentTransform();
+			const FTransform Rebuilt = WeaponData->GetAttachOffset() * Trajectory.Evaluate(AnimInstance->Montage_GetPosition(Montage)) * PlayerMesh->GetComponentTransform();
+
+			for (const FWeaponTraceShape& Shape : WeaponData->GetTraceShapes())
+			{
+				MaxError = FMath::Max(MaxError, FVector::Dist(Evaluated.TransformPosition(Shape.Start), Rebuilt.TransformPosition(Shape.Start)));
+				MaxError = FMath::Max(MaxError, FVector::Dist(Evaluated.TransformPosition(Shape.End), Rebuilt.TransformPosition(Shape.End)));
+			}
+
+			++ComparedFrames;
+		}
+
+		TestTrue(FString::Printf(TEXT("Combo attack %u traces at full weight"), ComboIndex), ComparedFrames > 0);
+		TestTrue(FString::Printf(TEXT("Combo attack %u sweeps where the posed weapon is (%.2f cm off)"), ComboIndex, MaxError), MaxError <= MaxShapeErrorCentimeters);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/Streaming/ArenaStreamingComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "WorldPartition/WorldPartitionSubsystem.h"
+#include "WorldPartition/DataLayer/DataLayerAsset.h"
+#include "WorldPartition/DataLayer/DataLayerInstance.h"
+#include "WorldPartition/DataLayer/DataLayerManager.h"
+#include "World/Streaming/ArenaStreamingSubsystem.h"
+
+UArenaStreamingComponent::UArenaStreamingComponent()
+{
+	// Ticks every CheckInterval: players are far more often away from an arena than in it
+	PrimaryComponentTick.bCanEverTick = true;
+	
+	ArenaRadius = 2000.0F;
+	PreloadRadius = 8000.0F;
+	ReleaseMargin = 1000.0F;
+	CheckInterval = 0.25F;
+	
+	StallStartTime = -1.0;
+	bStallOnCells = false;
+	bStallOnAssets = false;
+	StreamingState = EArenaStreamingState::Unloaded;
+	bSourceRegistered = false;
+}
+
+bool UArenaStreamingComponent::AreCellsLoaded() const
+{
+	const UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	return !bSourceRegistered || !WorldPartitionSubsystem || WorldPartitionSubsystem->IsStreamingCompleted(this);
+}
+
+bool UArenaStreamingComponent::AreAssetsLoaded() const
+{
+	return !PreloadHandle.IsValid() || PreloadHandle->HasLoadCompleted();
+}
+
+bool UArenaStreamingComponent::GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const
+{
+	if (StreamingState == EArenaStreamingState::Unloaded)
+	{
+		return false;
+	}
+	
+	FWorldPartitionStreamingSource& Source = OutStreamingSources.AddDefaulted_GetRef();
+	Source.Name = GetFName();
+	Source.Location = GetComponentLocation();
+	Source.Rotation = GetComponentRotation();
+	Source.TargetState = StreamingState == EArenaStreamingState::Active ? EStreamingSourceTargetState::Activated : EStreamingSourceTargetState::Loaded;
+	Source.Priority = EStreamingSourcePriority::High;
+	
+	// Covers the arena itself rather than the grids' loading range
+	FStreamingSourceShape& Shape = Source.Shapes.AddDefaulted_GetRef();
+	Shape.bUseGridLoadingRange = false;
+	Shape.Radius = ArenaRadius;
+	
+	return true;
+}
+
+void UArenaStreamingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	
+	SetComponentTickInterval(CheckInterval);
+}
+
+void UArenaStreamingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SetStreamingState(EArenaStreamingState::Unloaded);
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+void UArenaStreamingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	
+	const float Distance = FindNearestPlayerDistance();
+	EArenaStreamingState NewState;
+	
+	if (Distance <= ArenaRadius)
+	{
+		NewState = EArenaStreamingState::Active;
+	}
+	else if (Distance <= PreloadRadius)
+	{
+		NewState = EArenaStreamingState::Preloading;
+	}
+	else if (Distance > PreloadRadius + ReleaseMargin)
+	{
+		NewState = EArenaStreamingState::Unloaded;
+	}
+	else
+	{
+		// Between the radii a preloaded arena stays preloaded, so walking along the edge does not reload it
+		NewState = StreamingState == EArenaStreamingState::Unloaded ? EArenaStreamingState::Unloaded : EArenaStreamingState::Preloading;
+	}
+	
+	SetStreamingState(NewState);
+	UpdateStall();
+}
+
+void UArenaStreamingComponent::SetStreamingState(EArenaStreamingState NewState)
+{
+	if (NewState == StreamingState)
+	{
+		return;
+	}
+	
+	UWorldPartitionSubsystem* WorldPartitionSubsystem = GetWorld()->GetSubsystem<UWorldPartitionSubsystem>();
+	
+	if (NewState == EArenaStreamingState::Unloaded)
+	{
+		if (bSourceRegistered && WorldPartitionSubsystem)
+		{
+			WorldPartitionSubsystem->UnregisterStreamingSourceProvider(this);
+		}
+		
+		bSourceRegistered = false;
+		
+		if (PreloadHandle.IsValid())
+		{
+			PreloadHandle->CancelHandle();
+			PreloadHandle.Reset();
+		}
+	}
+	else
+	{
+		if (!bSourceRegistered && WorldPartitionSubsystem)
+		{
+			WorldPartitionSubsystem->RegisterStreamingSourceProvider(this);
+			bSourceRegistered = true;
+		}
+		
+		if (!PreloadHandle.IsValid())
+		{
+			TArray<FSoftObjectPath> AssetPaths;
+			
+			for (const TSoftObjectPtr<UObject>& Asset : PreloadAssets)
+			{
+				if (!Asset.IsNull())
+				{
+					AssetPaths.Add(Asset.ToSoftObjectPath());
+				}
+			}
+			
+			if (!AssetPaths.IsEmpty())
+			{
+				PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetPaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+			}
+		}
+	}
+	
+	StreamingState = NewState;
+	SetDataLayerState(NewState);
+}
+
+void UArenaStreamingComponent::SetDataLayerState(EArenaStreamingState State) const
+{
+	if (!ArenaDataLayer || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+	
+	UDataLayerManager* DataLayerManager = UDataLayerManager::GetDataLayerManager(this);
+	const UDataLayerInstance* DataLayerInstance = DataLayerManager ? DataLayerManager->GetDataLayerInstanceFromAsset(ArenaDataLayer) : nullptr;
+	
+	if (!DataLayerInstance)
+	{
+		return;
+	}
+	
+	EDataLayerRuntimeState RuntimeState = EDataLayerRuntimeState::Unloaded;
+	
+	switch (State)
+	{
+	case EArenaStreamingState::Preloading:
+		RuntimeState = EDataLayerRuntimeState::Loaded;
+		break;
+	case EArenaStreamingState::Active:
+		RuntimeState = EDataLayerRuntimeState::Activated;
+		break;
+	default:
+		break;
+	}
+	
+	DataLayerManager->SetDataLayerInstanceRuntimeState(DataLayerInstance, RuntimeState);
+}
+
+float UArenaStreamingComponent::FindNearestPlayerDistance() const
+{
+	const FVector ArenaCenter = GetComponentLocation();
+	double NearestDistanceSquared = TNumericLimits<double>::Max();
+	
+	// Servers see every player, clients only their own
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		
+		if (Pawn)
+		{
+			NearestDistanceSquared = FMath::Min(NearestDistanceSquared, FVector::DistSquared(Pawn->GetActorLocation(), ArenaCenter));
+		}
+	}
+	
+	return NearestDistanceSquared < TNumericLimits<double>::Max() ? static_cast<float>(FMath::Sqrt(NearestDistanceSquared)) : TNumericLimits<float>::Max();
+}
+
+void UArenaStreamingComponent::UpdateStall()
+{
+	const bool bCellsLoaded = AreCellsLoaded();
+	const bool bAssetsLoaded = AreAssetsLoaded();
+	const double Now = GetWorld()->GetTimeSeconds();
+	
+	if (StreamingState == EArenaStreamingState::Active && !(bCellsLoaded && bAssetsLoaded))
+	{
+		if (StallStartTime < 0.0)
+		{
+			StallStartTime = Now;
+			
+			// Follow the stall frame by frame to time it precisely
+			SetComponentTickInterval(0.0F);
+		}
+		
+		bStallOnCells |= !bCellsLoaded;
+		bStallOnAssets |= !bAssetsLoaded;
+		return;
+	}
+	
+	if (StallStartTime < 0.0)
+	{
+		return;
+	}
+	
+	if (UArenaStreamingSubsystem* ArenaStreaming = GetWorld()->GetSubsystem<UArenaStreamingSubsystem>())
+	{
+		FArenaStreamingStall Stall;
+		Stall.Arena = GetOwner()->GetActorNameOrLabel();
+		Stall.StartTime = StallStartTime;
+		Stall.Duration = static_cast<float>(Now - StallStartTime);
+		Stall.bCellsPending = bStallOnCells;
+		Stall.bAssetsPending = bStallOnAssets;
+		
+		ArenaStreaming->RecordStall(MoveTemp(Stall));
+	}
+	
+	StallStartTime = -1.0;
+	bStallOnCells = false;
+	bStallOnAssets = false;
+	SetComponentTickInterval(CheckInterval);
+}
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+#include "WorldPartition/WorldPartitionStreamingSourceProvider.h"
+#include "ArenaStreamingComponent.generated.h"
+
+class UDataLayerAsset;
+struct FStreamableHandle;
+
+/** How far an arena has been brought in for the players around it */
+UENUM()
+enum class EArenaStreamingState : uint8
+{
+	/** No player is near, nothing of the arena is requested */
+	Unloaded,
+	
+	/** A player is approaching: cells, data layer and assets are loading but nothing is shown yet */
+	Preloading,
+	
+	/** A player is in the arena: its data layer is activated */
+	Active
+};
+
+/**
+ * Brings a combat arena in ahead of the players.
+ *
+ * Place it at the center of an arena, on an actor that is not spatially loaded so it exists
+ * before the arena does. Once a player comes within PreloadRadius it becomes a world partition
+ * streaming source covering the arena's cells, loads the arena's data layer and starts loading
+ * the fighter, weapon and cue assets the arena needs asynchronously. When a player steps inside
+ * ArenaRadius the data layer is activated, which with everything preloaded only makes it visible.
+ * Everything is released again once every player is past PreloadRadius by a margin.
+ *
+ * A player standing in the arena before its cells or assets are in is a stall. Stalls are
+ * logged when they end and kept for the Streaming.StallReport command.
+ */
+UCLASS(ClassGroup = (Beadurinc), meta = (BlueprintSpawnableComponent))
+class BEADURINC_API UArenaStreamingComponent : public USceneComponent, public IWorldPartitionStreamingSourceProvider
+{
+	GENERATED_BODY()
+	
+	/** Data layer holding the arena's actors */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming")
+	TObjectPtr<const UDataLayerAsset> ArenaDataLayer;
+	
+	/** Fighter blueprints, weapons, projectiles and cue effects used in the arena */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming")
+	TArray<TSoftObjectPtr<UObject>> PreloadAssets;
+	
+	/** Radius of the arena around this component. A player inside it is in the arena */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming", meta = (ClampMin = "0.0"))
+	float ArenaRadius;
+	
+	/** How close a player has to come for the arena to start preloading */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming", meta = (ClampMin = "0.0"))
+	float PreloadRadius;
+	
+	/** Extra distance past PreloadRadius all players have to be before the arena is released */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming", meta = (ClampMin = "0.0"))
+	float ReleaseMargin;
+	
+	/** Seconds between checks of the players' distance. Checked every frame during a stall */
+	UPROPERTY(EditAnywhere, Category = "Arena Streaming", meta = (ClampMin = "0.0"))
+	float CheckInterval;
+	
+public:
+	
+	UArenaStreamingComponent();
+	
+	/** Returns whether the arena's cells and assets are all in */
+	FORCEINLINE bool IsArenaReady() const { return AreCellsLoaded() && AreAssetsLoaded(); }
+	
+	/** Returns whether world partition has streamed in the arena's cells */
+	bool AreCellsLoaded() const;
+	
+	/** Returns whether the preloaded assets have finished loading */
+	bool AreAssetsLoaded() const;
+	
+	FORCEINLINE EArenaStreamingState GetStreamingState() const { return StreamingState; }
+	
+	//~ Begin IWorldPartitionStreamingSourceProvider
+	virtual bool GetStreamingSources(TArray<FWorldPartitionStreamingSource>& OutStreamingSources) const override;
+	virtual const UObject* GetStreamingSourceOwner() const override { return this; }
+	//~ End IWorldPartitionStreamingSourceProvider
+	
+protected:
+	
+	virtual void BeginPlay() override;
+	
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	
+private:
+	
+	/** Moves the arena to a new state, requesting or releasing what that state needs */
+	void SetStreamingState(EArenaStreamingState NewState);
+	
+	/** Requests the data layer's runtime state. Only the server decides it, clients follow */
+	void SetDataLayerState(EArenaStreamingState State) const;
+	
+	/** Returns the distance from this arena to the nearest player */
+	float FindNearestPlayerDistance() const;
+	
+	/** Starts or ends a stall as players stand in the arena before it is ready */
+	void UpdateStall();
+	
+private:
+	
+	/** Load of PreloadAssets while the arena is preloading or active */
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+	
+	/** World time the current stall began at, negative when not stalling */
+	double StallStartTime;
+	
+	/** What the current stall has waited on */
+	bool bStallOnCells;
+	bool bStallOnAssets;
+	
+	EArenaStreamingState StreamingState;
+	
+	/** Whether the component is registered as a streaming source provider */
+	bool bSourceRegistered;
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "World/Streaming/ArenaStreamingSubsystem.h"
+#include "Beadurinc.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+bool UArenaStreamingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+	
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UArenaStreamingSubsystem::RecordStall(FArenaStreamingStall&& Stall)
+{
+	const TCHAR* Pending = Stall.bCellsPending && Stall.bAssetsPending ? TEXT("cells and assets") : Stall.bCellsPending ? TEXT("cells") : TEXT("assets");
+	
+	UE_LOG(LogBeadurinc, Warning, TEXT("Arena %s stalled for %.2fs waiting for %s to stream in"), *Stall.Arena, Stall.Duration, Pending);
+	CSV_EVENT_GLOBAL(TEXT("ArenaStall %s %.2fs"), *Stall.Arena, Stall.Duration);
+	
+	Stalls.Add(MoveTemp(Stall));
+}
+
+void UArenaStreamingSubsystem::PrintReport(FOutputDevice& Ar) const
+{
+	float TotalDuration = 0.0F;
+	
+	Ar.Logf(TEXT("%-32s %10s %10s %8s %8s"), TEXT("Arena"), TEXT("Start"), TEXT("Duration"), TEXT("Cells"), TEXT("Assets"));
+	
+	for (const FArenaStreamingStall& Stall : Stalls)
+	{
+		Ar.Logf(
+			TEXT("%-32s %10.2f %10.2f %8s %8s"),
+			*Stall.Arena,
+			Stall.StartTime,
+			Stall.Duration,
+			Stall.bCellsPending ? TEXT("pending") : TEXT("-"),
+			Stall.bAssetsPending ? TEXT("pending") : TEXT("-")
+		);
+		
+		TotalDuration += Stall.Duration;
+	}
+	
+	Ar.Logf(TEXT("%d stalls, %.2fs in total"), Stalls.Num(), TotalDuration);
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdStreamingStallReport(
+	TEXT("Streaming.StallReport"),
+	TEXT("Prints every time a player stood in an arena before its cells or assets had streamed in"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UArenaStreamingSubsystem* ArenaStreaming = World ? World->GetSubsystem<UArenaStreamingSubsystem>() : nullptr)
+		{
+			ArenaStreaming->PrintReport(Ar);
+		}
+	})
+);
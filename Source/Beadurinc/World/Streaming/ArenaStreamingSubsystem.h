@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ArenaStreamingSubsystem.generated.h"
+
+/** A player standing in an arena before the arena was ready */
+struct FArenaStreamingStall
+{
+	/** Actor the arena's streaming component belongs to */
+	FString Arena;
+	
+	/** World time the stall began at */
+	double StartTime = 0.0;
+	
+	/** Seconds the player waited */
+	float Duration = 0.0F;
+	
+	/** Whether world partition cells were still streaming in */
+	bool bCellsPending = false;
+	
+	/** Whether preloaded assets were still loading */
+	bool bAssetsPending = false;
+};
+
+/**
+ * Collects the stream-in stalls of the world's arenas, so a play session tells which arenas
+ * start preloading too late and on what they wait. Print them with Streaming.StallReport.
+ */
+UCLASS()
+class BEADURINC_API UArenaStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+	
+public:
+	
+	/** Logs a stall and keeps it for the report */
+	void RecordStall(FArenaStreamingStall&& Stall);
+	
+	/** Prints every stall so far and their total */
+	void PrintReport(FOutputDevice& Ar) const;
+	
+	FORCEINLINE const TArray<FArenaStreamingStall>& GetStalls() const { return Stalls; }
+	
+protected:
+	
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	
+private:
+	
+	TArray<FArenaStreamingStall> Stalls;
+};